@@ -12,8 +12,8 @@
 
 #include "best_first_search.h"
 
-template<class state_t, class action_t>
-class AStar: public BestFirstSearch<state_t, action_t>
+template<class state_t, class action_t, class tie_breaker_t = ConfigurableTieBreaking>
+class AStar: public BestFirstSearch<state_t, action_t, tie_breaker_t>
 {
 public:
     AStar();
@@ -23,18 +23,18 @@ protected:
     virtual double nodeEval(const state_t &state, double g_cost, double h_cost);
 };
 
-template<class state_t, class action_t>
-inline AStar<state_t, action_t>::AStar()
+template<class state_t, class action_t, class tie_breaker_t>
+inline AStar<state_t, action_t, tie_breaker_t>::AStar()
 {
 }
 
-template<class state_t, class action_t>
-inline AStar<state_t, action_t>::~AStar()
+template<class state_t, class action_t, class tie_breaker_t>
+inline AStar<state_t, action_t, tie_breaker_t>::~AStar()
 {
 }
 
-template<class state_t, class action_t>
-inline double AStar<state_t, action_t>::nodeEval(const state_t& state, double g_cost, double h_cost)
+template<class state_t, class action_t, class tie_breaker_t>
+inline double AStar<state_t, action_t, tie_breaker_t>::nodeEval(const state_t& state, double g_cost, double h_cost)
 {
     return g_cost + h_cost;
 }
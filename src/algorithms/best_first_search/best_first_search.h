@@ -13,7 +13,7 @@
 #include "../../utils/combinatorics.h"
 #include "../../generic_defs/search_engine.h"
 #include "open_closed_list.h"
-#include "../../generic_defs/heuristic.h"
+#include "../../generic_defs/incremental_heuristic.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <iostream>
@@ -35,10 +35,26 @@ enum class BfsExpansionResult
     goal_found, no_solution, res_limit, empty_open
 };
 
+/**
+ * What an expansion records about a child when it is generated, so that the heuristic values of all new children can
+ * be computed together before the children are added to the search.
+ *
+ * @class BfsChildInfo
+ */
+struct BfsChildInfo
+{
+    StateHash hash_value; ///< The hash value of the child.
+    StateLocation location; ///< Where the child was when it was generated.
+    NodeID id; ///< The id of the child's node if it was in the open or closed list.
+    int new_child_index; ///< The index of the child among the new children, or -1 if it is not new to the search.
+};
+
 /**
  *
  * An abstract template for best-first search.
  *
+ * Nodes with equal evaluations are ordered by the tie-breaking policy given by tie_breaker_t (see tie_breaking.h).
+ *
  * @todo Add branch and bound option
  * @todo Add pathmax
  * @todo Make it a bit more general
@@ -46,7 +62,7 @@ enum class BfsExpansionResult
  *
  * @class BestFirstSearch
  */
-template<class state_t, class action_t>
+template<class state_t, class action_t, class tie_breaker_t = ConfigurableTieBreaking>
 class BestFirstSearch: public SearchEngine<state_t, action_t>
 {
     using SearchEngine<state_t, action_t>::op_system;
@@ -81,13 +97,78 @@ public:
      *
      * @param heur A pointer to the heuristic function to use.
      */
-    void setHeuristic(Heuristic<state_t> *heur);
+    void setHeuristic(const Heuristic<state_t> *heur);
+
+    /**
+     * Sets the heuristic function used by the search. The heuristic value of each child will be computed from that of
+     * its parent.
+     *
+     * @param heur A pointer to the heuristic function to use.
+     */
+    void setHeuristic(const IncrementalHeuristic<state_t, action_t> *heur);
 
     void setReopen(int is_reopen);
 
-    void setTieBreaker(int tiebreaker);
+    /**
+     * Sets the rule used to break ties between nodes with equal evaluations. Only available when using the default
+     * ConfigurableTieBreaking policy.
+     *
+     * @param type The tie-breaking rule to use.
+     */
+    void setTieBreaker(TieBreakType type);
+
+    /**
+     * Sets the structure used for duplicate detection. Resets the engine.
+     *
+     * @param backend The structure to map state hash values to nodes with.
+     */
+    void setNodeTableBackend(NodeTableBackend backend);
+
+    /**
+     * Sets the structure used to order the open list. Resets the engine.
+     *
+     * Buckets give constant time open list operations, but are only exact if all node evaluations and g-costs are
+     * multiples of the bucket width (such as in unit-cost domains with integer heuristics).
+     *
+     * @param type The structure to use.
+     * @param bucket_width The range of values that share a bucket. Ignored unless buckets are used.
+     */
+    void setOpenListType(OpenListType type, double bucket_width = 1.0);
+
+    /**
+     * Sets if the large search arrays (node attributes, the open list heap, and the open addressing hash table) should
+     * be backed by huge pages, which reduces TLB misses on large searches. Frees the memory currently held by these
+     * arrays and resets the engine.
+     *
+     * @param use_huge_pages If huge pages should be requested.
+     */
+    void setUseHugePages(bool use_huge_pages);
+
+    /**
+     * Reserves enough memory to store the given number of nodes before any search structure has to grow.
+     *
+     * The reserved memory is kept between calls to getPlan.
+     *
+     * @param num_nodes The number of nodes to reserve space for.
+     */
+    void reserveNodeStorage(std::size_t num_nodes);
+
+    /**
+     * When using the direct index backend, allocates the memory for all hash values below the given value up front
+     * instead of as the search reaches them.
+     *
+     * @param hash_range One more than the largest hash value that will be generated.
+     */
+    void reserveHashRange(StateHash hash_range);
 
-    // void setTieBreaker(NodeID<state_t, action_t, StateHash, double, double, double, NodeID> *tiebreaker);
+    /**
+     * Returns the probe statistics of the hash map used for duplicate detection.
+     *
+     * Statistics are accumulated over all searches, and are only collected for the open addressing backend.
+     *
+     * @return The probe statistics.
+     */
+    const HashTableStats &getNodeTableStats() const;
 
     /**
      * Returns the number of unique goal tests.
@@ -127,59 +208,110 @@ protected:
      */
     void extractSolutionPath(NodeID path_end_id);
 
-    Heuristic<state_t> *heur_func; ///< The heuristic function.
+    const Heuristic<state_t> *heur_func; ///< The heuristic function.
+    const IncrementalHeuristic<state_t, action_t> *incremental_heur; ///< The heuristic if it is incremental, else 0.
     const StateHashFunction<state_t> *hash_func; ///< The hash function.
-    int tiebreaker;
 
-    OpenClosedList<state_t, action_t> open_closed_list; ///< The open and closed list.
+    OpenClosedList<state_t, action_t, tie_breaker_t> open_closed_list; ///< The open and closed list.
 
     uint64_t unique_goal_tests; ///< The number of unique goal tests performed.
 
-    std::vector<action_t> app_actions; ///< A vector to store the set of applicable actions.
+    SuccessorBuffer<state_t, action_t> successors; ///< A buffer to store the successors of the node being expanded.
+
+    std::vector<BfsChildInfo> child_info; ///< What is known about each successor of the node being expanded.
+    std::vector<const state_t *> new_child_states; ///< The successors that are new to the search.
+    std::vector<double> new_child_h; ///< The heuristic values of the new successors.
 };
 
-template<class state_t, class action_t>
-BestFirstSearch<state_t, action_t>::BestFirstSearch()
-        : heur_func(0), hash_func(0), unique_goal_tests(0)
+template<class state_t, class action_t, class tie_breaker_t>
+BestFirstSearch<state_t, action_t, tie_breaker_t>::BestFirstSearch()
+        : heur_func(0), incremental_heur(0), hash_func(0), unique_goal_tests(0)
 {
 }
 
-template<class state_t, class action_t>
-BestFirstSearch<state_t, action_t>::~BestFirstSearch()
+template<class state_t, class action_t, class tie_breaker_t>
+BestFirstSearch<state_t, action_t, tie_breaker_t>::~BestFirstSearch()
 {
 }
 
-template<class state_t, class action_t>
-inline void BestFirstSearch<state_t, action_t>::setHashFunction(const StateHashFunction<state_t>* hash)
+template<class state_t, class action_t, class tie_breaker_t>
+inline void BestFirstSearch<state_t, action_t, tie_breaker_t>::setHashFunction(const StateHashFunction<state_t>* hash)
 {
     hash_func = hash;
 }
 
-template<class state_t, class action_t>
-inline void BestFirstSearch<state_t, action_t>::setHeuristic(Heuristic<state_t>* heur)
+template<class state_t, class action_t, class tie_breaker_t>
+inline void BestFirstSearch<state_t, action_t, tie_breaker_t>::setHeuristic(const Heuristic<state_t>* heur)
+{
+    heur_func = heur;
+    incremental_heur = 0;
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+inline void BestFirstSearch<state_t, action_t, tie_breaker_t>::setHeuristic(
+        const IncrementalHeuristic<state_t, action_t>* heur)
 {
     heur_func = heur;
+    incremental_heur = heur;
 }
 
-template<class state_t, class action_t>
-inline void BestFirstSearch<state_t, action_t>::setReopen(int is_reopen)
+template<class state_t, class action_t, class tie_breaker_t>
+inline void BestFirstSearch<state_t, action_t, tie_breaker_t>::setReopen(int is_reopen)
 {
     reopen = is_reopen;
 }
 
-template<class state_t, class action_t>
-inline void BestFirstSearch<state_t, action_t>::setTieBreaker(int tiebreaker_type)
+template<class state_t, class action_t, class tie_breaker_t>
+inline void BestFirstSearch<state_t, action_t, tie_breaker_t>::setTieBreaker(TieBreakType type)
+{
+    open_closed_list.getTieBreaker().setType(type);
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+void BestFirstSearch<state_t, action_t, tie_breaker_t>::setNodeTableBackend(NodeTableBackend backend)
+{
+    open_closed_list.setNodeTableBackend(backend);
+    resetEngine();
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+void BestFirstSearch<state_t, action_t, tie_breaker_t>::setOpenListType(OpenListType type, double bucket_width)
+{
+    open_closed_list.setOpenListType(type, bucket_width);
+    resetEngine();
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+void BestFirstSearch<state_t, action_t, tie_breaker_t>::setUseHugePages(bool use_huge_pages)
+{
+    open_closed_list.setUseHugePages(use_huge_pages);
+    resetEngine();
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+inline void BestFirstSearch<state_t, action_t, tie_breaker_t>::reserveNodeStorage(std::size_t num_nodes)
+{
+    open_closed_list.reserve(num_nodes);
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+inline void BestFirstSearch<state_t, action_t, tie_breaker_t>::reserveHashRange(StateHash hash_range)
 {
-    tiebreaker = tiebreaker_type;
+    open_closed_list.reserveHashRange(hash_range);
 }
 
-template<class state_t, class action_t>
-SearchTermType BestFirstSearch<state_t, action_t>::searchForPlan(const state_t& init_state)
+template<class state_t, class action_t, class tie_breaker_t>
+inline const HashTableStats& BestFirstSearch<state_t, action_t, tie_breaker_t>::getNodeTableStats() const
+{
+    return open_closed_list.getNodeTableStats();
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+SearchTermType BestFirstSearch<state_t, action_t, tie_breaker_t>::searchForPlan(const state_t& init_state)
 {
     BfsExpansionResult exp_result = BfsExpansionResult::no_solution;
 
-    heur_func->prepareToCompute();
-    double init_h = heur_func->getHValue(init_state);
+    double init_h = heur_func->computeHValue(init_state);
 
     incrementHCompCount();
 
@@ -196,82 +328,107 @@ SearchTermType BestFirstSearch<state_t, action_t>::searchForPlan(const state_t&
     return SearchTermType::completed;
 }
 
-template<class state_t, class action_t>
-void BestFirstSearch<state_t, action_t>::resetStatistics()
+template<class state_t, class action_t, class tie_breaker_t>
+void BestFirstSearch<state_t, action_t, tie_breaker_t>::resetStatistics()
 {
     SearchEngine<state_t, action_t>::resetStatistics();
     unique_goal_tests = 0;
 }
 
-template<class state_t, class action_t>
-BfsExpansionResult BestFirstSearch<state_t, action_t>::nodeExpansion()
+template<class state_t, class action_t, class tie_breaker_t>
+BfsExpansionResult BestFirstSearch<state_t, action_t, tie_breaker_t>::nodeExpansion()
 {
     if(open_closed_list.isOpenEmpty())
         return BfsExpansionResult::empty_open;
 
-    NodeID to_expand_id;
-    if (tiebreaker == 0) {
-        to_expand_id = open_closed_list.getBestNodeAndClose();
-    } else if (tiebreaker == 1) {
-        to_expand_id = open_closed_list.getLowGAndClose();
-    } else if (tiebreaker == 2) {
-        to_expand_id = open_closed_list.getHighGAndClose();
-    }
-
-    // NodeID to_expand_id = open_closed_list.getHighGAndClose();
+    NodeID to_expand_id = open_closed_list.getBestNodeAndClose();
 
-    BFSNode<state_t, action_t> to_expand_node = open_closed_list.getNode(to_expand_id);
-    //std::cout << "Expanding " << to_expand_id << " - " << to_expand_node.state << "," << to_expand_node.gen_action << std::endl;
+    const state_t &to_expand_state = open_closed_list.getState(to_expand_id);
 
     if(hitGoalTestLimit())
         return BfsExpansionResult::res_limit;
 
     incrementGoalTestCount();
-    if(!to_expand_node.reopened)
+    if(!open_closed_list.isReopened(to_expand_id))
         unique_goal_tests++; // change this to a function
 
-    if(goal_test->isGoal(to_expand_node.state)) { // checks for goal
+    if(goal_test->isGoal(to_expand_state)) { // checks for goal
         extractSolutionPath(to_expand_id);
         return BfsExpansionResult::goal_found;
     }
 
-    double parent_g = to_expand_node.g_cost;
+    double parent_g = open_closed_list.getGCost(to_expand_id);
+    StateHash parent_hash = open_closed_list.getHashValue(to_expand_id);
 
     if(hitSuccFuncLimit())
         return BfsExpansionResult::res_limit;
 
     incrementSuccFuccCalls();
 
-    app_actions.clear();
-    op_system->getActions(to_expand_node.state, app_actions);
-    increaseActionGenCount(app_actions.size());
-
-    for(unsigned i = 0; i < app_actions.size(); i++) {
+    op_system->generateSuccessors(to_expand_state, successors);
+    increaseActionGenCount(successors.size());
 
-        double edge_cost = op_system->getActionCost(to_expand_node.state, app_actions[i]);
-        double child_g = parent_g + edge_cost;
+    child_info.resize(successors.size());
+    new_child_states.clear();
 
-        state_t child_state = to_expand_node.state;
-        op_system->applyAction(child_state, app_actions[i]);
+    // Look up all children first, so that the heuristic values of the new ones can be computed together
+    for(unsigned i = 0; i < successors.size(); i++) {
+        const state_t &child_state = successors[i].state;
         incrementStateGenCount();
 
-        StateHash child_hash = hash_func->getStateHash(child_state);
-        NodeID child_id;
-        StateLocation child_loc = open_closed_list.getStateLocation(child_state, child_hash, child_id);
+        BfsChildInfo &info = child_info[i];
+        info.hash_value = hash_func->getChildStateHash(to_expand_state, parent_hash, child_state);
+        info.location = open_closed_list.getStateLocation(child_state, info.hash_value, info.id);
+        info.new_child_index = -1;
+
+        if(info.location != StateLocation::none)
+            continue;
+
+        // a state generated earlier in this expansion will be in open by the time this child is processed
+        bool generated_earlier = false;
+        for(unsigned j = 0; j < i && !generated_earlier; j++) {
+            generated_earlier = child_info[j].new_child_index >= 0 && child_info[j].hash_value == info.hash_value
+                    && successors[j].state == child_state;
+        }
+        if(!generated_earlier) {
+            info.new_child_index = new_child_states.size();
+            new_child_states.push_back(&child_state);
+        }
+    }
+
+    new_child_h.resize(new_child_states.size());
+    if(incremental_heur) {
+        double parent_h = open_closed_list.getHValue(to_expand_id);
+        for(unsigned i = 0; i < successors.size(); i++) {
+            if(child_info[i].new_child_index >= 0) {
+                new_child_h[child_info[i].new_child_index] = incremental_heur->computeChildHValue(to_expand_state,
+                        parent_h, successors[i].action, successors[i].state);
+            }
+        }
+    } else if(!new_child_states.empty()) {
+        heur_func->computeHValues(&new_child_states[0], new_child_states.size(), &new_child_h[0]);
+    }
+
+    for(unsigned i = 0; i < successors.size(); i++) {
+
+        double child_g = parent_g + successors[i].cost;
+
+        const state_t &child_state = successors[i].state;
+        BfsChildInfo &info = child_info[i];
+
+        if(info.location == StateLocation::none && info.new_child_index < 0)
+            info.location = open_closed_list.getStateLocation(child_state, info.hash_value, info.id);
 
-        if(child_loc == StateLocation::open || child_loc == StateLocation::closed) {
-            if(fp_less(child_g, open_closed_list.getNode(child_id).g_cost)) {
-                open_closed_list.getNode(child_id).g_cost = child_g;
-                open_closed_list.getNode(child_id).eval = nodeEval(child_state, child_g,
-                        open_closed_list.getNode(child_id).h_value);
-                open_closed_list.getNode(child_id).parent_id = to_expand_id;
-                open_closed_list.getNode(child_id).gen_action = app_actions[i];
+        if(info.location == StateLocation::open || info.location == StateLocation::closed) {
+            if(fp_less(child_g, open_closed_list.getGCost(info.id))) {
+                open_closed_list.setNodePath(info.id, to_expand_id, successors[i].action, child_g,
+                        nodeEval(child_state, child_g, open_closed_list.getHValue(info.id)));
 
-                if(child_loc == StateLocation::open)
-                    open_closed_list.openNodeEvalChanged(child_id);
+                if(info.location == StateLocation::open)
+                    open_closed_list.openNodeEvalChanged(info.id);
                 else
                     if (reopen == 1) {
-                        open_closed_list.reopenNode(child_id);
+                        open_closed_list.reopenNode(info.id);
 
                     }
                     
@@ -283,54 +440,53 @@ BfsExpansionResult BestFirstSearch<state_t, action_t>::nodeExpansion()
                 return BfsExpansionResult::res_limit;
 
             incrementHCompCount();
-            heur_func->prepareToCompute();
-            double child_h = heur_func->getHValue(child_state);
+            double child_h = new_child_h[info.new_child_index];
             double child_eval = nodeEval(child_state, child_g, child_h);
 
             //std::cout << "New Child " << child_state << " eval " << child_eval << std::endl;
-            open_closed_list.addNewNodeToOpen(child_state, app_actions[i], child_hash, child_g, child_h, child_eval,
-                    to_expand_id);
+            open_closed_list.addNewNodeToOpen(child_state, successors[i].action, info.hash_value, child_g, child_h,
+                    child_eval, to_expand_id);
         }
     }
 
     return BfsExpansionResult::no_solution;
 }
 
-template<class state_t, class action_t>
-bool BestFirstSearch<state_t, action_t>::isConfigured() const
+template<class state_t, class action_t, class tie_breaker_t>
+bool BestFirstSearch<state_t, action_t, tie_breaker_t>::isConfigured() const
 {
     if(!heur_func || !hash_func)
         return false;
     return SearchEngine<state_t, action_t>::isConfigured();
 }
 
-template<class state_t, class action_t>
-inline uint64_t BestFirstSearch<state_t, action_t>::getUniqueGoalTests() const
+template<class state_t, class action_t, class tie_breaker_t>
+inline uint64_t BestFirstSearch<state_t, action_t, tie_breaker_t>::getUniqueGoalTests() const
 {
     return unique_goal_tests;
 }
 
-template<class state_t, class action_t>
-void BestFirstSearch<state_t, action_t>::resetEngine()
+template<class state_t, class action_t, class tie_breaker_t>
+void BestFirstSearch<state_t, action_t, tie_breaker_t>::resetEngine()
 {
     open_closed_list.clear();
     SearchEngine<state_t, action_t>::resetEngine();
 }
 
-template<class state_t, class action_t>
-void BestFirstSearch<state_t, action_t>::extractSolutionPath(NodeID path_end_id)
+template<class state_t, class action_t, class tie_breaker_t>
+void BestFirstSearch<state_t, action_t, tie_breaker_t>::extractSolutionPath(NodeID path_end_id)
 {
     incumbent_cost = 0.0;
     incumbent_plan.clear();
 
     NodeID id = path_end_id;
-    while(open_closed_list.getNode(id).gen_action != op_system->getDummyAction()) {
-        incumbent_plan.push_back(open_closed_list.getNode(id).gen_action);
-        id = open_closed_list.getNode(id).parent_id;
-        incumbent_cost += op_system->getActionCost(open_closed_list.getNode(id).state, incumbent_plan.back());
+    while(open_closed_list.getGenAction(id) != op_system->getDummyAction()) {
+        incumbent_plan.push_back(open_closed_list.getGenAction(id));
+        id = open_closed_list.getParent(id);
+        incumbent_cost += op_system->getActionCost(open_closed_list.getState(id), incumbent_plan.back());
     }
 
-    assert(!fp_greater(incumbent_cost, open_closed_list.getNode(path_end_id).g_cost));
+    assert(!fp_greater(incumbent_cost, open_closed_list.getGCost(path_end_id)));
 }
 
 #endif /* BEST_FIRST_SEARCH_H_ */
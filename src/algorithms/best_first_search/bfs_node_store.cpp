@@ -0,0 +1,10 @@
+/*
+ * bfs_node_store.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "bfs_node_store.h"
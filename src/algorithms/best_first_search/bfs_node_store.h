@@ -0,0 +1,474 @@
+/*
+ * bfs_node_store.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef BFS_NODE_STORE_H_
+#define BFS_NODE_STORE_H_
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "open_addressing_table.h"
+#include "../../utils/huge_page_allocator.h"
+
+typedef unsigned BFSOpenLocation; ///< The location of a node in the open list heap.
+
+/**
+ * The log base 2 of the number of states stored in each chunk of a BFSNodeStore.
+ */
+static const unsigned STATE_CHUNK_BITS = 12;
+
+/**
+ * The flag bit set if a node is in the open list.
+ */
+static const uint8_t BFS_OPEN_FLAG = 1;
+
+/**
+ * The flag bit set if a node has been reopened.
+ */
+static const uint8_t BFS_REOPENED_FLAG = 2;
+
+/**
+ * Storage for the nodes of a best-first search, indexed by node id.
+ *
+ * The attributes of the nodes are kept in parallel arrays rather than one record per node. Those read while
+ * deciding which node to expand and whether a child is a duplicate with a better path (the g-cost, evaluation, open
+ * list location and flags) are kept in small dense arrays of their own, so that these checks do not pull the rest of
+ * the node into the cache. The remaining attributes are only needed when a node is expanded or a path is extracted.
+ *
+ * States are stored in fixed size chunks that are never moved once allocated. This means a reference to a stored
+ * state stays valid while other nodes are added, so the state of the node being expanded can be read in place while
+ * its children are stored.
+ *
+ * Memory is kept between searches. Clearing the store only resets the node count, and later nodes are written over
+ * the old ones, so once the store has grown to the size needed by the largest search, no more memory is allocated.
+ * Since stored states are assigned to rather than constructed, states that hold their own memory (like a vector) can
+ * also reuse it. The large arrays can optionally be backed by huge pages (see setUseHugePages).
+ *
+ * Node ids are assumed to be assigned consecutively from 0, as done by NodeTable.
+ *
+ * @class BFSNodeStore
+ */
+template<class state_t, class action_t>
+class BFSNodeStore
+{
+public:
+    /**
+     * Constructor for an empty store.
+     */
+    BFSNodeStore();
+
+    /**
+     * Destructor for the store. Does nothing.
+     */
+    virtual ~BFSNodeStore();
+
+    /**
+     * Adds a new node with the given attributes. The node is marked as open and not reopened.
+     *
+     * @param state The state corresponding to the node.
+     * @param parent The id of the parent of this node. Should be set to 0 if it has no parent.
+     * @param action The action that generated this node from the corresponding parent.
+     * @param g The g-cost of this node.
+     * @param h The heuristic value of this node.
+     * @param node_eval The evaluation of this node.
+     * @param hash_value The hash value of the state.
+     * @return The id of the new node.
+     */
+    NodeID addNode(const state_t &state, NodeID parent, const action_t &action, double g, double h,
+            double node_eval, StateHash hash_value);
+
+    /**
+     * Removes all nodes. Takes constant time, and all memory is kept for later use.
+     */
+    void clear();
+
+    /**
+     * Reserves enough memory to store the given number of nodes without any of the arrays growing.
+     *
+     * @param new_nodes The number of nodes to reserve space for.
+     */
+    void reserve(std::size_t new_nodes);
+
+    /**
+     * Sets if the node attribute arrays should be backed by huge pages. Frees all memory held and removes all nodes.
+     *
+     * @param use_huge_pages If huge pages should be requested.
+     */
+    void setUseHugePages(bool use_huge_pages);
+
+    /**
+     * Returns the number of nodes stored.
+     *
+     * @return The number of nodes stored.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the state of the node with the given id. The reference remains valid until the store is cleared.
+     *
+     * @param id The id of the node.
+     * @return The state of the node.
+     */
+    const state_t &getState(NodeID id) const;
+
+    /**
+     * Returns the id of the parent of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The id of the parent.
+     */
+    NodeID getParent(NodeID id) const;
+
+    /**
+     * Returns the action used to generate the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The generating action.
+     */
+    const action_t &getGenAction(NodeID id) const;
+
+    /**
+     * Returns the g-cost of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The g-cost.
+     */
+    double getGCost(NodeID id) const;
+
+    /**
+     * Returns the heuristic value of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The heuristic value.
+     */
+    double getHValue(NodeID id) const;
+
+    /**
+     * Returns the hash value of the state of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The hash value.
+     */
+    StateHash getHashValue(NodeID id) const;
+
+    /**
+     * Returns the evaluation of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The evaluation.
+     */
+    double getEval(NodeID id) const;
+
+    /**
+     * Replaces the path to the node with the given id with a new one.
+     *
+     * @param id The id of the node.
+     * @param parent The id of the new parent.
+     * @param action The action that generates the node from the new parent.
+     * @param g The new g-cost.
+     * @param node_eval The new evaluation.
+     */
+    void setPath(NodeID id, NodeID parent, const action_t &action, double g, double node_eval);
+
+    /**
+     * Returns the location of the node with the given id in the open list. Means nothing if the node is not open.
+     *
+     * @param id The id of the node.
+     * @return The open list location.
+     */
+    BFSOpenLocation getLocation(NodeID id) const;
+
+    /**
+     * Sets the location of the node with the given id in the open list.
+     *
+     * @param id The id of the node.
+     * @param loc The open list location.
+     */
+    void setLocation(NodeID id, BFSOpenLocation loc);
+
+    /**
+     * Returns if the node with the given id is in the open list.
+     *
+     * @param id The id of the node.
+     * @return If the node is open.
+     */
+    bool isOpen(NodeID id) const;
+
+    /**
+     * Sets if the node with the given id is in the open list.
+     *
+     * @param id The id of the node.
+     * @param in_open If the node is open.
+     */
+    void setOpen(NodeID id, bool in_open);
+
+    /**
+     * Returns if the node with the given id has been reopened.
+     *
+     * @param id The id of the node.
+     * @return If the node has been reopened.
+     */
+    bool isReopened(NodeID id) const;
+
+    /**
+     * Marks the node with the given id as having been reopened.
+     *
+     * @param id The id of the node.
+     */
+    void setReopened(NodeID id);
+
+    /**
+     * Returns when the node with the given id was last added to open or updated. Used for LIFO tie-breaking.
+     *
+     * @param id The id of the node.
+     * @return The open order of the node.
+     */
+    uint64_t getOpenOrder(NodeID id) const;
+
+    /**
+     * Sets when the node with the given id was last added to open or updated.
+     *
+     * @param id The id of the node.
+     * @param order The open order of the node.
+     */
+    void setOpenOrder(NodeID id, uint64_t order);
+
+protected:
+    std::size_t num_nodes; ///< The number of nodes stored. The arrays can hold more entries left by earlier searches.
+
+    // Attributes used when checking children and ordering the open list
+    std::vector<double, HugePageAllocator<double> > g_costs; ///< The g-cost of each node.
+    std::vector<double, HugePageAllocator<double> > evals; ///< The evaluation of each node.
+    std::vector<BFSOpenLocation, HugePageAllocator<BFSOpenLocation> > locations; ///< The location of each node.
+    std::vector<uint8_t, HugePageAllocator<uint8_t> > flags; ///< The flag bits of each node.
+
+    // Attributes used when expanding a node or extracting a path
+    std::vector<NodeID, HugePageAllocator<NodeID> > parent_ids; ///< The id of the parent of each node.
+    std::vector<action_t, HugePageAllocator<action_t> > gen_actions; ///< The action used to generate each node.
+    std::vector<double, HugePageAllocator<double> > h_values; ///< The heuristic value of each node.
+    std::vector<uint64_t, HugePageAllocator<uint64_t> > open_orders; ///< When each node was last put on open.
+    std::vector<StateHash, HugePageAllocator<StateHash> > hash_values; ///< The hash value of the state of each node.
+
+    std::vector<std::vector<state_t> > state_chunks; ///< The states of the nodes, stored in chunks that never move.
+};
+
+template<class state_t, class action_t>
+inline BFSNodeStore<state_t, action_t>::BFSNodeStore()
+        : num_nodes(0)
+{
+}
+
+template<class state_t, class action_t>
+inline BFSNodeStore<state_t, action_t>::~BFSNodeStore()
+{
+}
+
+template<class state_t, class action_t>
+NodeID BFSNodeStore<state_t, action_t>::addNode(const state_t& state, NodeID parent, const action_t& action,
+        double g, double h, double node_eval, StateHash hash_value)
+{
+    NodeID id = num_nodes;
+
+    std::size_t chunk = id >> STATE_CHUNK_BITS;
+    if(chunk == state_chunks.size()) {
+        state_chunks.push_back(std::vector<state_t>());
+        state_chunks.back().reserve((std::size_t) 1 << STATE_CHUNK_BITS);
+    }
+
+    std::size_t chunk_loc = id & (((NodeID) 1 << STATE_CHUNK_BITS) - 1);
+    if(chunk_loc < state_chunks[chunk].size())
+        state_chunks[chunk][chunk_loc] = state;
+    else
+        state_chunks[chunk].push_back(state);
+
+    if(id < g_costs.size()) { // overwrites a node from an earlier search
+        g_costs[id] = g;
+        evals[id] = node_eval;
+        locations[id] = 0;
+        flags[id] = BFS_OPEN_FLAG;
+
+        parent_ids[id] = parent;
+        gen_actions[id] = action;
+        h_values[id] = h;
+        open_orders[id] = 0;
+        hash_values[id] = hash_value;
+    } else {
+        g_costs.push_back(g);
+        evals.push_back(node_eval);
+        locations.push_back(0);
+        flags.push_back(BFS_OPEN_FLAG);
+
+        parent_ids.push_back(parent);
+        gen_actions.push_back(action);
+        h_values.push_back(h);
+        open_orders.push_back(0);
+        hash_values.push_back(hash_value);
+    }
+
+    num_nodes++;
+    return id;
+}
+
+template<class state_t, class action_t>
+inline void BFSNodeStore<state_t, action_t>::clear()
+{
+    num_nodes = 0;
+}
+
+template<class state_t, class action_t>
+void BFSNodeStore<state_t, action_t>::reserve(std::size_t new_nodes)
+{
+    g_costs.reserve(new_nodes);
+    evals.reserve(new_nodes);
+    locations.reserve(new_nodes);
+    flags.reserve(new_nodes);
+
+    parent_ids.reserve(new_nodes);
+    gen_actions.reserve(new_nodes);
+    h_values.reserve(new_nodes);
+    open_orders.reserve(new_nodes);
+    hash_values.reserve(new_nodes);
+
+    while((state_chunks.size() << STATE_CHUNK_BITS) < new_nodes) {
+        state_chunks.push_back(std::vector<state_t>());
+        state_chunks.back().reserve((std::size_t) 1 << STATE_CHUNK_BITS);
+    }
+}
+
+template<class state_t, class action_t>
+void BFSNodeStore<state_t, action_t>::setUseHugePages(bool use_huge_pages)
+{
+    g_costs = std::vector<double, HugePageAllocator<double> >(HugePageAllocator<double>(use_huge_pages));
+    evals = std::vector<double, HugePageAllocator<double> >(HugePageAllocator<double>(use_huge_pages));
+    locations = std::vector<BFSOpenLocation, HugePageAllocator<BFSOpenLocation> >(
+            HugePageAllocator<BFSOpenLocation>(use_huge_pages));
+    flags = std::vector<uint8_t, HugePageAllocator<uint8_t> >(HugePageAllocator<uint8_t>(use_huge_pages));
+
+    parent_ids = std::vector<NodeID, HugePageAllocator<NodeID> >(HugePageAllocator<NodeID>(use_huge_pages));
+    gen_actions = std::vector<action_t, HugePageAllocator<action_t> >(HugePageAllocator<action_t>(use_huge_pages));
+    h_values = std::vector<double, HugePageAllocator<double> >(HugePageAllocator<double>(use_huge_pages));
+    open_orders = std::vector<uint64_t, HugePageAllocator<uint64_t> >(HugePageAllocator<uint64_t>(use_huge_pages));
+    hash_values = std::vector<StateHash, HugePageAllocator<StateHash> >(HugePageAllocator<StateHash>(use_huge_pages));
+
+    state_chunks.clear();
+    num_nodes = 0;
+}
+
+template<class state_t, class action_t>
+inline std::size_t BFSNodeStore<state_t, action_t>::size() const
+{
+    return num_nodes;
+}
+
+template<class state_t, class action_t>
+inline const state_t& BFSNodeStore<state_t, action_t>::getState(NodeID id) const
+{
+    assert(id < size());
+    return state_chunks[id >> STATE_CHUNK_BITS][id & (((NodeID) 1 << STATE_CHUNK_BITS) - 1)];
+}
+
+template<class state_t, class action_t>
+inline NodeID BFSNodeStore<state_t, action_t>::getParent(NodeID id) const
+{
+    return parent_ids[id];
+}
+
+template<class state_t, class action_t>
+inline const action_t& BFSNodeStore<state_t, action_t>::getGenAction(NodeID id) const
+{
+    return gen_actions[id];
+}
+
+template<class state_t, class action_t>
+inline double BFSNodeStore<state_t, action_t>::getGCost(NodeID id) const
+{
+    return g_costs[id];
+}
+
+template<class state_t, class action_t>
+inline double BFSNodeStore<state_t, action_t>::getHValue(NodeID id) const
+{
+    return h_values[id];
+}
+
+template<class state_t, class action_t>
+inline StateHash BFSNodeStore<state_t, action_t>::getHashValue(NodeID id) const
+{
+    return hash_values[id];
+}
+
+template<class state_t, class action_t>
+inline double BFSNodeStore<state_t, action_t>::getEval(NodeID id) const
+{
+    return evals[id];
+}
+
+template<class state_t, class action_t>
+inline void BFSNodeStore<state_t, action_t>::setPath(NodeID id, NodeID parent, const action_t& action, double g,
+        double node_eval)
+{
+    parent_ids[id] = parent;
+    gen_actions[id] = action;
+    g_costs[id] = g;
+    evals[id] = node_eval;
+}
+
+template<class state_t, class action_t>
+inline BFSOpenLocation BFSNodeStore<state_t, action_t>::getLocation(NodeID id) const
+{
+    return locations[id];
+}
+
+template<class state_t, class action_t>
+inline void BFSNodeStore<state_t, action_t>::setLocation(NodeID id, BFSOpenLocation loc)
+{
+    locations[id] = loc;
+}
+
+template<class state_t, class action_t>
+inline bool BFSNodeStore<state_t, action_t>::isOpen(NodeID id) const
+{
+    return (flags[id] & BFS_OPEN_FLAG) != 0;
+}
+
+template<class state_t, class action_t>
+inline void BFSNodeStore<state_t, action_t>::setOpen(NodeID id, bool in_open)
+{
+    if(in_open)
+        flags[id] |= BFS_OPEN_FLAG;
+    else
+        flags[id] &= ~BFS_OPEN_FLAG;
+}
+
+template<class state_t, class action_t>
+inline bool BFSNodeStore<state_t, action_t>::isReopened(NodeID id) const
+{
+    return (flags[id] & BFS_REOPENED_FLAG) != 0;
+}
+
+template<class state_t, class action_t>
+inline void BFSNodeStore<state_t, action_t>::setReopened(NodeID id)
+{
+    flags[id] |= BFS_REOPENED_FLAG;
+}
+
+template<class state_t, class action_t>
+inline uint64_t BFSNodeStore<state_t, action_t>::getOpenOrder(NodeID id) const
+{
+    return open_orders[id];
+}
+
+template<class state_t, class action_t>
+inline void BFSNodeStore<state_t, action_t>::setOpenOrder(NodeID id, uint64_t order)
+{
+    open_orders[id] = order;
+}
+
+#endif /* BFS_NODE_STORE_H_ */
@@ -0,0 +1,118 @@
+/*
+ * bucket_queue.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "bucket_queue.h"
+#include <cassert>
+
+BucketQueue::Bucket::Bucket()
+        : num_entries(0), low_sub_bucket((std::size_t) -1), high_sub_bucket(0), epoch(0)
+{
+}
+
+BucketQueue::BucketQueue()
+        : low_bucket((std::size_t) -1), num_entries(0), current_epoch(1)
+{
+}
+
+BucketQueue::~BucketQueue()
+{
+}
+
+void BucketQueue::push(NodeID id, std::size_t bucket, std::size_t sub_bucket)
+{
+    if(bucket >= buckets.size())
+        buckets.resize(bucket + 1);
+
+    Bucket &b = buckets[bucket];
+    refreshBucket(b);
+    if(sub_bucket >= b.sub_buckets.size())
+        b.sub_buckets.resize(sub_bucket + 1);
+
+    b.sub_buckets[sub_bucket].push_back(id);
+    b.num_entries++;
+
+    if(sub_bucket < b.low_sub_bucket)
+        b.low_sub_bucket = sub_bucket;
+    if(sub_bucket > b.high_sub_bucket)
+        b.high_sub_bucket = sub_bucket;
+
+    if(bucket < low_bucket)
+        low_bucket = bucket;
+
+    num_entries++;
+}
+
+NodeID BucketQueue::pop(bool high_sub_bucket, std::size_t& bucket, std::size_t& sub_bucket)
+{
+    assert(num_entries > 0);
+
+    while(buckets[low_bucket].epoch != current_epoch || buckets[low_bucket].num_entries == 0)
+        low_bucket++;
+
+    Bucket &b = buckets[low_bucket];
+
+    if(high_sub_bucket) {
+        while(b.sub_buckets[b.high_sub_bucket].empty())
+            b.high_sub_bucket--;
+        sub_bucket = b.high_sub_bucket;
+    } else {
+        while(b.sub_buckets[b.low_sub_bucket].empty())
+            b.low_sub_bucket++;
+        sub_bucket = b.low_sub_bucket;
+    }
+    bucket = low_bucket;
+
+    NodeID id = b.sub_buckets[sub_bucket].back();
+    b.sub_buckets[sub_bucket].pop_back();
+    b.num_entries--;
+    num_entries--;
+
+    if(b.num_entries == 0) {
+        b.low_sub_bucket = (std::size_t) -1;
+        b.high_sub_bucket = 0;
+    }
+
+    return id;
+}
+
+bool BucketQueue::isEmpty() const
+{
+    return num_entries == 0;
+}
+
+std::size_t BucketQueue::size() const
+{
+    return num_entries;
+}
+
+void BucketQueue::clear()
+{
+    low_bucket = (std::size_t) -1;
+    num_entries = 0;
+    current_epoch++;
+
+    if(current_epoch == 0) { // the epoch has wrapped around, so old stamps could match again
+        for(std::size_t i = 0; i < buckets.size(); i++)
+            buckets[i].epoch = 0;
+        current_epoch = 1;
+    }
+}
+
+void BucketQueue::refreshBucket(Bucket& b)
+{
+    if(b.epoch == current_epoch)
+        return;
+
+    for(std::size_t i = 0; i < b.sub_buckets.size(); i++)
+        b.sub_buckets[i].clear();
+    b.num_entries = 0;
+    b.low_sub_bucket = (std::size_t) -1;
+    b.high_sub_bucket = 0;
+    b.epoch = current_epoch;
+}
@@ -0,0 +1,116 @@
+/*
+ * bucket_queue.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef BUCKET_QUEUE_H_
+#define BUCKET_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "open_addressing_table.h"
+
+/**
+ * A priority queue of node ids for integer priorities drawn from a small range.
+ *
+ * Each entry has a primary index (the bucket, normally the f-value) and a secondary index (the sub-bucket, normally
+ * the g-value). Entries are popped from the lowest non-empty bucket, and within that bucket from either the lowest or
+ * the highest non-empty sub-bucket. Entries in the same sub-bucket are popped last-in, first-out.
+ *
+ * Pushing is constant time. Popping is amortized constant time provided that the lowest non-empty bucket mostly moves
+ * forward, which is the case for best-first searches with consistent heuristics. Entries are never removed except by
+ * popping them, so a priority change is handled by pushing a second entry and leaving it to the user to skip the
+ * out-of-date one when it is popped.
+ *
+ * @class BucketQueue
+ */
+class BucketQueue
+{
+public:
+    /**
+     * Constructor for an empty queue.
+     */
+    BucketQueue();
+
+    /**
+     * Destructor for the queue. Does nothing.
+     */
+    virtual ~BucketQueue();
+
+    /**
+     * Adds an entry to the queue.
+     *
+     * @param id The node id to add.
+     * @param bucket The primary index of the entry.
+     * @param sub_bucket The secondary index of the entry.
+     */
+    void push(NodeID id, std::size_t bucket, std::size_t sub_bucket);
+
+    /**
+     * Removes an entry from the lowest non-empty bucket and returns it.
+     *
+     * Assumes the queue is not empty.
+     *
+     * @param high_sub_bucket If the entry should come from the highest non-empty sub-bucket rather than the lowest.
+     * @param bucket Set to the primary index of the popped entry.
+     * @param sub_bucket Set to the secondary index of the popped entry.
+     * @return The node id of the popped entry.
+     */
+    NodeID pop(bool high_sub_bucket, std::size_t &bucket, std::size_t &sub_bucket);
+
+    /**
+     * Returns if there are no entries in the queue.
+     *
+     * @return If the queue is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns the number of entries in the queue.
+     *
+     * @return The number of entries.
+     */
+    std::size_t size() const;
+
+    /**
+     * Removes all entries in constant time. Memory used by the buckets is kept for later use.
+     *
+     * Each bucket is stamped with the epoch in which it was last pushed to, and buckets from earlier epochs are
+     * treated as empty until they are next pushed to.
+     */
+    void clear();
+
+protected:
+    /**
+     * A single bucket, split into sub-buckets.
+     */
+    struct Bucket
+    {
+        Bucket();
+
+        std::vector<std::vector<NodeID> > sub_buckets; ///< The entries in each sub-bucket.
+        std::size_t num_entries; ///< The number of entries in all sub-buckets.
+        std::size_t low_sub_bucket; ///< No sub-bucket below this one is non-empty.
+        std::size_t high_sub_bucket; ///< No sub-bucket above this one is non-empty.
+        uint32_t epoch; ///< The epoch in which the bucket was last pushed to.
+    };
+
+    /**
+     * Empties the given bucket if it still holds entries from an earlier epoch.
+     *
+     * @param b The bucket.
+     */
+    void refreshBucket(Bucket &b);
+
+    std::vector<Bucket> buckets; ///< The buckets.
+    std::size_t low_bucket; ///< No bucket below this one is non-empty.
+    std::size_t num_entries; ///< The number of entries in the queue.
+    uint32_t current_epoch; ///< The current epoch. Never 0, which is the epoch of a new bucket.
+};
+
+#endif /* BUCKET_QUEUE_H_ */
@@ -0,0 +1,106 @@
+/*
+ * direct_index_table.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "direct_index_table.h"
+#include <cassert>
+
+/**
+ * The log base 2 of the number of ids stored on each page. Pages of 1024 ids take up 4 KB.
+ */
+static const unsigned PAGE_BITS = 10;
+
+/**
+ * The number of ids stored on each page.
+ */
+static const std::size_t PAGE_SIZE = (std::size_t) 1 << PAGE_BITS;
+
+DirectIndexTable::DirectIndexTable()
+        : current_epoch(1), num_entries(0), num_pages(0)
+{
+}
+
+DirectIndexTable::~DirectIndexTable()
+{
+}
+
+bool DirectIndexTable::find(StateHash hash_value, NodeID& id) const
+{
+    std::size_t page = hash_value >> PAGE_BITS;
+
+    if(page >= pages.size() || page_epochs[page] != current_epoch || pages[page].empty())
+        return false;
+
+    id = pages[page][hash_value & (PAGE_SIZE - 1)];
+    return id != NO_NODE_ID;
+}
+
+void DirectIndexTable::insert(StateHash hash_value, NodeID id)
+{
+    assert(id != NO_NODE_ID);
+
+    std::size_t page = hash_value >> PAGE_BITS;
+    allocatePage(page);
+
+    if(page_epochs[page] != current_epoch) { // the page still holds entries from an earlier epoch
+        std::vector<NodeID> &ids = pages[page];
+        for(std::size_t i = 0; i < ids.size(); i++)
+            ids[i] = NO_NODE_ID;
+        page_epochs[page] = current_epoch;
+    }
+
+    assert(pages[page][hash_value & (PAGE_SIZE - 1)] == NO_NODE_ID);
+    pages[page][hash_value & (PAGE_SIZE - 1)] = id;
+    num_entries++;
+}
+
+void DirectIndexTable::clear()
+{
+    num_entries = 0;
+    current_epoch++;
+
+    if(current_epoch == 0) { // the epoch has wrapped around, so old stamps could match again
+        for(std::size_t i = 0; i < page_epochs.size(); i++)
+            page_epochs[i] = 0;
+        current_epoch = 1;
+    }
+}
+
+void DirectIndexTable::reserveRange(StateHash hash_range)
+{
+    if(hash_range == 0)
+        return;
+
+    std::size_t last_page = (hash_range - 1) >> PAGE_BITS;
+    for(std::size_t page = 0; page <= last_page; page++)
+        allocatePage(page);
+}
+
+std::size_t DirectIndexTable::size() const
+{
+    return num_entries;
+}
+
+std::size_t DirectIndexTable::getNumPages() const
+{
+    return num_pages;
+}
+
+void DirectIndexTable::allocatePage(std::size_t page)
+{
+    if(page >= pages.size()) {
+        pages.resize(page + 1);
+        page_epochs.resize(page + 1, 0);
+    }
+
+    if(pages[page].empty()) {
+        pages[page].resize(PAGE_SIZE, NO_NODE_ID);
+        page_epochs[page] = current_epoch;
+        num_pages++;
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * direct_index_table.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef DIRECT_INDEX_TABLE_H_
+#define DIRECT_INDEX_TABLE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "../../generic_defs/state_hash_function.h"
+#include "open_addressing_table.h"
+
+/**
+ * A table from state hash values to node ids that uses the hash value itself as an index into an array of ids.
+ *
+ * This is only appropriate when the hash function is injective and its values are reasonably dense, as is the case
+ * for MapLocHashFunction (the index of a grid cell) and PermutationHashFunction (the rank of a permutation). A lookup
+ * is then just two loads, with no hashing or probing.
+ *
+ * The array is split into fixed size pages that are only allocated once a hash value inside them is stored, so the
+ * memory used is proportional to the part of the hash range the search actually touches. All pages for a given
+ * range can also be allocated in advance using reserveRange.
+ *
+ * Each page is stamped with the epoch in which it was last written, and a page from an earlier epoch is treated as
+ * empty. Clearing the table just starts a new epoch, so it takes constant time. A stale page is only reset when an
+ * entry is next stored in it.
+ *
+ * Grid cell indices are a good fit, since a search touches cells that are close together. Permutation ranks of
+ * neighbouring tile puzzle states are often far apart, so a tile puzzle search can touch a page for almost every node
+ * it stores and an OpenAddressingTable will usually use less memory there.
+ *
+ * @class DirectIndexTable
+ */
+class DirectIndexTable
+{
+public:
+    /**
+     * Constructor for the table. Allocates no pages.
+     */
+    DirectIndexTable();
+
+    /**
+     * Destructor for the table. Does nothing.
+     */
+    virtual ~DirectIndexTable();
+
+    /**
+     * Looks up the given hash value.
+     *
+     * @param hash_value The hash value to look for.
+     * @param id Set to the id associated with the hash value if it is found.
+     * @return If the hash value is stored in the table.
+     */
+    bool find(StateHash hash_value, NodeID &id) const;
+
+    /**
+     * Associates the given hash value with the given id.
+     *
+     * Assumes the hash value is not already in the table.
+     *
+     * @param hash_value The hash value to add.
+     * @param id The id to associate with the hash value.
+     */
+    void insert(StateHash hash_value, NodeID id);
+
+    /**
+     * Removes all entries from the table in constant time. Pages that have been allocated are kept for later searches.
+     */
+    void clear();
+
+    /**
+     * Allocates all of the pages needed to store hash values from 0 up to (but not including) the given value.
+     *
+     * @param hash_range The number of hash values to allocate pages for.
+     */
+    void reserveRange(StateHash hash_range);
+
+    /**
+     * Returns the number of entries stored.
+     *
+     * @return The number of entries stored.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the number of pages currently allocated.
+     *
+     * @return The number of allocated pages.
+     */
+    std::size_t getNumPages() const;
+
+protected:
+    /**
+     * Allocates the page with the given index if it has not already been allocated.
+     *
+     * @param page The index of the page.
+     */
+    void allocatePage(std::size_t page);
+
+    std::vector<std::vector<NodeID> > pages; ///< The pages of ids, indexed by the high bits of the hash value.
+    std::vector<uint32_t> page_epochs; ///< The epoch in which each page was last written.
+    uint32_t current_epoch; ///< The current epoch. Pages from any other epoch are treated as empty.
+
+    std::size_t num_entries; ///< The number of entries stored.
+    std::size_t num_pages; ///< The number of pages allocated.
+};
+
+#endif /* DIRECT_INDEX_TABLE_H_ */
@@ -13,8 +13,8 @@
 #include "best_first_search.h"
 #include "a_star.h"
 
-template<class state_t, class action_t>
-class GBFS: public AStar<state_t, action_t>
+template<class state_t, class action_t, class tie_breaker_t = ConfigurableTieBreaking>
+class GBFS: public AStar<state_t, action_t, tie_breaker_t>
 {
 public:
     GBFS();
@@ -24,18 +24,18 @@ protected:
     virtual double nodeEval(const state_t &state, double g_cost, double h_cost);
 };
 
-template<class state_t, class action_t>
-inline GBFS<state_t, action_t>::GBFS()
+template<class state_t, class action_t, class tie_breaker_t>
+inline GBFS<state_t, action_t, tie_breaker_t>::GBFS()
 {
 }
 
-template<class state_t, class action_t>
-inline GBFS<state_t, action_t>::~GBFS()
+template<class state_t, class action_t, class tie_breaker_t>
+inline GBFS<state_t, action_t, tie_breaker_t>::~GBFS()
 {
 }
 
-template<class state_t, class action_t>
-inline double GBFS<state_t, action_t>::nodeEval(const state_t& state, double g_cost, double h_cost)
+template<class state_t, class action_t, class tie_breaker_t>
+inline double GBFS<state_t, action_t, tie_breaker_t>::nodeEval(const state_t& state, double g_cost, double h_cost)
 {
     return h_cost;
 }
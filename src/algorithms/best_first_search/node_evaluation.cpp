@@ -0,0 +1,36 @@
+/*
+ * node_evaluation.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "node_evaluation.h"
+#include "../../utils/floating_point_utils.h"
+
+#include <iostream>
+
+using std::cerr;
+using std::endl;
+
+WeightedAStarEval::WeightedAStarEval()
+        : weight(1.0)
+{
+}
+
+bool WeightedAStarEval::setWeight(double new_weight)
+{
+    if(fp_less(new_weight, 0.0)) {
+        cerr << "Weight of " << new_weight << " is less than 0.0 and is thus invalid." << endl;
+        return false;
+    }
+    weight = new_weight;
+    return true;
+}
+
+double WeightedAStarEval::getWeight() const
+{
+    return weight;
+}
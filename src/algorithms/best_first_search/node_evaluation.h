@@ -0,0 +1,91 @@
+/*
+ * node_evaluation.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef NODE_EVALUATION_H_
+#define NODE_EVALUATION_H_
+
+/**
+ * Policies for computing the evaluation of a node, for use with StaticBestFirstSearch.
+ *
+ * A policy is a class with the following const member function:
+ *
+ * double getEval(double g_cost, double h_value) - returns the evaluation of a node with the given g-cost and heuristic
+ * value. Nodes with lower evaluations are expanded first.\n
+ *
+ * These match the nodeEval functions of AStar, WeightedAStar, and GBFS.
+ */
+
+/**
+ * The A* evaluation function, g + h.
+ *
+ * @class AStarEval
+ */
+class AStarEval
+{
+public:
+    double getEval(double g_cost, double h_value) const
+    {
+        return g_cost + h_value;
+    }
+};
+
+/**
+ * The weighted A* evaluation function, g + w * h.
+ *
+ * @class WeightedAStarEval
+ */
+class WeightedAStarEval
+{
+public:
+    /**
+     * Constructor for the policy. Uses a weight of 1.0.
+     */
+    WeightedAStarEval();
+
+    /**
+     * Sets the weight to multiply heuristic values by.
+     *
+     * Value must be at least 0.0. False is returned if it is not.
+     *
+     * @param new_weight The new weight.
+     * @return If the weight was successfully set.
+     */
+    bool setWeight(double new_weight);
+
+    /**
+     * Returns the weight heuristic values are multiplied by.
+     *
+     * @return The weight.
+     */
+    double getWeight() const;
+
+    double getEval(double g_cost, double h_value) const
+    {
+        return g_cost + weight * h_value;
+    }
+
+protected:
+    double weight; ///< The weight on the heuristic value.
+};
+
+/**
+ * The greedy best-first search evaluation function, which is just h.
+ *
+ * @class GBFSEval
+ */
+class GBFSEval
+{
+public:
+    double getEval(double g_cost, double h_value) const
+    {
+        return h_value;
+    }
+};
+
+#endif /* NODE_EVALUATION_H_ */
@@ -8,8 +8,125 @@
  */
 
 #include "node_table.h"
+#include <cassert>
 
 std::size_t NodeKeyHash::operator ()(StateHash hash_value) const
 {
     return (std::size_t) (hash_value);
 }
+
+NodeTable::NodeTable()
+        : num_nodes(0), backend(NodeTableBackend::unordered_map)
+{
+}
+
+NodeTable::~NodeTable()
+{
+}
+
+bool NodeTable::isNodeStored(StateHash hash_value, NodeID& id) const
+{
+    if(backend == NodeTableBackend::direct_index) {
+        assert(num_nodes == direct_map.size());
+        if(!direct_map.find(hash_value, id))
+            return false;
+
+        assert(id < num_nodes);
+        return true;
+    } else if(backend == NodeTableBackend::open_addressing) {
+        assert(num_nodes == flat_map.size());
+        if(!flat_map.find(hash_value, id))
+            return false;
+
+        assert(id < num_nodes);
+        return true;
+    }
+
+    assert(num_nodes == node_map.size());
+
+    NodeMap::const_iterator node_check = node_map.find(hash_value);
+
+    if(node_check == node_map.end())
+        return false;
+
+    id = node_check->second;
+    assert(id < num_nodes);
+    return true;
+}
+
+NodeID NodeTable::addNewSearchNode(StateHash hash_value)
+{
+    NodeID new_id = num_nodes;
+
+    if(backend == NodeTableBackend::direct_index)
+        direct_map.insert(hash_value, new_id);
+    else if(backend == NodeTableBackend::open_addressing)
+        flat_map.insert(hash_value, new_id);
+    else
+        node_map[hash_value] = new_id;
+
+    num_nodes++;
+    return new_id;
+}
+
+void NodeTable::clear()
+{
+    num_nodes = 0;
+
+    if(backend == NodeTableBackend::direct_index)
+        direct_map.clear();
+    else if(backend == NodeTableBackend::open_addressing)
+        flat_map.clear();
+    else
+        node_map.clear();
+}
+
+void NodeTable::setBackend(NodeTableBackend new_backend)
+{
+    node_map.clear();
+    flat_map.clear();
+    direct_map.clear();
+    num_nodes = 0;
+    backend = new_backend;
+}
+
+NodeTableBackend NodeTable::getBackend() const
+{
+    return backend;
+}
+
+void NodeTable::reserve(std::size_t new_nodes)
+{
+    if(backend == NodeTableBackend::open_addressing)
+        flat_map.reserve(new_nodes);
+    else if(backend == NodeTableBackend::unordered_map)
+        node_map.reserve(new_nodes);
+}
+
+void NodeTable::reserveHashRange(StateHash hash_range)
+{
+    if(backend == NodeTableBackend::direct_index)
+        direct_map.reserveRange(hash_range);
+}
+
+void NodeTable::setMaxLoadFactor(double load_factor)
+{
+    flat_map.setMaxLoadFactor(load_factor);
+    node_map.max_load_factor(load_factor);
+}
+
+void NodeTable::setUseHugePages(bool use_huge_pages)
+{
+    clear();
+    flat_map.setUseHugePages(use_huge_pages);
+}
+
+const HashTableStats& NodeTable::getTableStats() const
+{
+    return flat_map.getStats();
+}
+
+std::size_t NodeTable::size() const
+{
+    return num_nodes;
+}
@@ -10,15 +10,11 @@
 #ifndef NODE_TABLE_H_
 #define NODE_TABLE_H_
 
-#include <cassert>
-#include <vector>
+#include <cstddef>
 #include <unordered_map>
-#include <utility>
-#include <stdio.h>
-#include <iostream>
 #include "../../generic_defs/state_hash_function.h"
-
-typedef unsigned NodeID; ///< The ID of a node is the location of the node in the node table.
+#include "open_addressing_table.h"
+#include "direct_index_table.h"
 
 /**
  * A struct that turns a given hash value and turns it into something an unordered_map can use.
@@ -32,16 +28,36 @@ struct NodeKeyHash
 };
 
 /**
- * A table of search nodes that maintains a hash map that can be used to tell if items are already held in the table.
+ * Defines the possible structures a node table can use to map hash values to nodes.
+ *
+ * Below is the meaning of each of the values:
+ *
+ * unordered_map - a std::unordered_map, which allocates a separate bucket entry for each node.\n
+ * open_addressing - an OpenAddressingTable, which stores entries in a single contiguous slot array.\n
+ * direct_index - a DirectIndexTable, which uses the hash value as an array index. Only valid if the hash function is
+ * injective and has a dense range, like MapLocHashFunction or PermutationHashFunction.\n
+ *
+ * @class NodeTableBackend
+ */
+enum class NodeTableBackend
+{
+    unordered_map, open_addressing, direct_index
+};
+
+/**
+ * A table that assigns ids to search nodes and maintains a hash map that can be used to tell if a node for a given
+ * state is already stored.
  *
- * The node type is a a template type, and so can be anything. It uses the given hash value to determine if the item
- * is already there. The ID of a node is the location in the table.
+ * Nodes are given consecutive ids starting at 0 in the order they are added. The table only stores the mapping from
+ * hash values to ids, so the node data itself can be kept in separate arrays indexed by id (see BFSNodeStore).
+ *
+ * The structure used to map hash values to node ids can be selected using setBackend. By default, a
+ * std::unordered_map is used.
  *
  * @todo Change the NodeKeyHash so that we can check the state if the hash function isn't injective.
  *
  * @class NodeTable
  */
-template<class node_t>
 class NodeTable
 {
     typedef std::unordered_map<StateHash, NodeID, NodeKeyHash> NodeMap; ///< Defines the type for a map.
@@ -69,135 +85,90 @@ public:
     bool isNodeStored(StateHash hash_value, NodeID &id) const;
 
     /**
-     * Adds the given search node to the node table.
+     * Adds a new node with the given hash value to the table.
      *
      * Assumes the hash value is not already associated with a node.
      *
-     * @param new_node The new node to store.
      * @param hash_value The hash value to associate the node with.
      * @return The ID of the added node.
      */
-    NodeID addNewSearchNode(node_t new_node, StateHash hash_value);
+    NodeID addNewSearchNode(StateHash hash_value);
 
     /**
      * Clears the node table.
+     *
+     * Takes constant time with the open addressing and direct index backends. Clearing a std::unordered_map takes time
+     * proportional to the number of nodes it held.
      */
     void clear();
 
     /**
-     * Returns the number of nodes in the node table.
+     * Sets the structure used to map hash values to node ids. Clears the node table.
      *
-     * @return Numb
+     * @param new_backend The structure to use.
      */
-    std::size_t size() const;
+    void setBackend(NodeTableBackend new_backend);
 
     /**
-     * Returns a reference to the node with the given id.
-     *
-     * Does not check if no such node exists.
+     * Returns the structure currently used to map hash values to node ids.
      *
-     * @param node_id The id of the node to return.
-     * @return A reference to the node to return.
+     * @return The backend in use.
      */
-    node_t &getNode(NodeID node_id);
+    NodeTableBackend getBackend() const;
 
-    const node_t &getNode(NodeID node_id) const;
+    /**
+     * Reserves enough memory to store the given number of nodes without the hash map growing.
+     *
+     * @param new_nodes The number of nodes to reserve space for.
+     */
+    void reserve(std::size_t new_nodes);
 
     /**
-     * Returns a reference to the node with the given id.
+     * Allocates the memory needed to store all hash values below the given value when using the direct index backend.
      *
-     * Does not check if no such node exists.
+     * Does nothing for the other backends.
      *
-     * @param node_id The id of the node to return.
-     * @return A refernce to the node with the given id.
+     * @param hash_range One more than the largest hash value to allocate memory for.
      */
-    node_t &operator[](NodeID node_id);
-
-    const node_t &operator[](NodeID node_id) const;
-
-protected:
-    std::vector<node_t> nodes; ///< A list of the nodes being stored.
-
-    NodeMap node_map; ///< The map used to determine if a hash value is already associated with a node.
-};
-
-template<class node_t>
-inline NodeTable<node_t>::NodeTable()
-{
-}
-
-template<class node_t>
-inline NodeTable<node_t>::~NodeTable()
-{
-}
-
-template<class node_t>
-bool NodeTable<node_t>::isNodeStored(StateHash hash_value, NodeID& id) const
-{
-    assert(nodes.size() == node_map.size());
+    void reserveHashRange(StateHash hash_range);
 
-    typename NodeMap::const_iterator node_check = node_map.find(hash_value);
-
-    if(node_check == node_map.end())
-        return false;
-
-    id = node_check->second;
-    assert(id < nodes.size());
-    return true;
-}
-
-template<class node_t>
-NodeID NodeTable<node_t>::addNewSearchNode(node_t new_node, StateHash hash_value)
-{
-    nodes.push_back(new_node);
-    node_map[hash_value] = nodes.size() - 1;
+    /**
+     * Sets the maximum load factor of the hash map.
+     *
+     * @param load_factor The maximum load factor.
+     */
+    void setMaxLoadFactor(double load_factor);
 
-    return nodes.size() - 1;
-}
+    /**
+     * Sets if the open addressing hash map should be backed by huge pages. Clears the node table.
+     *
+     * @param use_huge_pages If huge pages should be requested.
+     */
+    void setUseHugePages(bool use_huge_pages);
 
-template<class node_t>
-void NodeTable<node_t>::clear()
-{
-    nodes.clear();
-    node_map.clear();
-}
+    /**
+     * Returns the probe statistics of the hash map.
+     *
+     * Only collected when the open addressing backend is in use.
+     *
+     * @return The probe statistics.
+     */
+    const HashTableStats &getTableStats() const;
 
-template<class node_t>
-node_t& NodeTable<node_t>::getNode(NodeID node_id)
-{
-    if(node_id >= nodes.size()) {
-        //std::cout << "Bad node id " << node_id << std::endl;
-        assert(false);
-    }
-    return nodes[node_id];
-}
-
-template<class node_t>
-const node_t& NodeTable<node_t>::getNode(NodeID node_id) const
-{
-    if(node_id >= nodes.size()) {
-        //std::cout << "Bad node id " << node_id << std::endl;
-        assert(false);
-    }
-    return nodes[node_id];
-}
-
-template<class node_t>
-inline std::size_t NodeTable<node_t>::size() const
-{
-    return nodes.size();
-}
+    /**
+     * Returns the number of nodes in the node table.
+     *
+     * @return The number of nodes.
+     */
+    std::size_t size() const;
 
-template<class node_t>
-node_t& NodeTable<node_t>::operator [](NodeID node_id)
-{
-    return getNode(node_id);
-}
+protected:
+    std::size_t num_nodes; ///< The number of nodes stored.
 
-template<class node_t>
-const node_t& NodeTable<node_t>::operator [](NodeID node_id) const
-{
-    return getNode(node_id);
-}
+    NodeTableBackend backend; ///< The structure used to map hash values to node ids.
+    NodeMap node_map; ///< The map used if the backend is an unordered map.
+    OpenAddressingTable flat_map; ///< The map used if the backend is an open addressing table.
+    DirectIndexTable direct_map; ///< The map used if the backend is a direct index table.
+};
 
 #endif /* NODE_TABLE_H_ */
@@ -0,0 +1,188 @@
+/*
+ * open_addressing_table.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "open_addressing_table.h"
+#include <cassert>
+
+/**
+ * The number of slots allocated the first time an entry is added to an empty table.
+ */
+static const unsigned MIN_CAPACITY_BITS = 10;
+
+/**
+ * Multiplier used for Fibonacci hashing. It scatters hash values that are close together, such as consecutive
+ * map cell indices, across the slot array.
+ */
+static const uint64_t FIBONACCI_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+
+HashTableStats::HashTableStats()
+        : num_lookups(0), num_probes(0), max_probe_length(0), num_grows(0)
+{
+}
+
+double HashTableStats::getAverageProbeLength() const
+{
+    if(num_lookups == 0)
+        return 0.0;
+    return num_probes / (double) num_lookups;
+}
+
+OpenAddressingTable::OpenAddressingTable()
+        : num_entries(0), grow_threshold(0), capacity_bits(0), max_load_factor(0.7), current_epoch(1)
+{
+}
+
+OpenAddressingTable::~OpenAddressingTable()
+{
+}
+
+bool OpenAddressingTable::find(StateHash hash_value, NodeID& id) const
+{
+    stats.num_lookups++;
+    if(slots.empty())
+        return false;
+
+    std::size_t mask = slots.size() - 1;
+    std::size_t loc = getHomeSlot(hash_value);
+    uint64_t probe_length = 1;
+
+    while(slots[loc].epoch == current_epoch) {
+        if(slots[loc].hash_value == hash_value) {
+            id = slots[loc].id;
+            break;
+        }
+        loc = (loc + 1) & mask;
+        probe_length++;
+    }
+
+    stats.num_probes += probe_length;
+    if(probe_length > stats.max_probe_length)
+        stats.max_probe_length = probe_length;
+
+    return slots[loc].epoch == current_epoch;
+}
+
+void OpenAddressingTable::insert(StateHash hash_value, NodeID id)
+{
+    assert(id != NO_NODE_ID);
+
+    if(num_entries >= grow_threshold) {
+        if(slots.empty())
+            rehash((std::size_t) 1 << MIN_CAPACITY_BITS);
+        else
+            rehash(slots.size() * 2);
+        stats.num_grows++;
+    }
+
+    std::size_t mask = slots.size() - 1;
+    std::size_t loc = getHomeSlot(hash_value);
+
+    while(slots[loc].epoch == current_epoch) {
+        assert(slots[loc].hash_value != hash_value);
+        loc = (loc + 1) & mask;
+    }
+
+    slots[loc].hash_value = hash_value;
+    slots[loc].id = id;
+    slots[loc].epoch = current_epoch;
+    num_entries++;
+}
+
+void OpenAddressingTable::clear()
+{
+    num_entries = 0;
+    current_epoch++;
+
+    if(current_epoch == 0) { // the epoch has wrapped around, so old stamps could match again
+        for(std::size_t i = 0; i < slots.size(); i++)
+            slots[i].epoch = 0;
+        current_epoch = 1;
+    }
+}
+
+void OpenAddressingTable::reserve(std::size_t new_entries)
+{
+    std::size_t new_capacity = (std::size_t) 1 << MIN_CAPACITY_BITS;
+    while(new_capacity * max_load_factor <= new_entries)
+        new_capacity *= 2;
+
+    if(new_capacity > slots.size())
+        rehash(new_capacity);
+}
+
+bool OpenAddressingTable::setMaxLoadFactor(double load_factor)
+{
+    if(load_factor <= 0.0 || load_factor > 0.95)
+        return false;
+
+    max_load_factor = load_factor;
+    grow_threshold = slots.size() * max_load_factor;
+
+    if(num_entries >= grow_threshold)
+        reserve(num_entries);
+    return true;
+}
+
+std::size_t OpenAddressingTable::size() const
+{
+    return num_entries;
+}
+
+std::size_t OpenAddressingTable::capacity() const
+{
+    return slots.size();
+}
+
+void OpenAddressingTable::setUseHugePages(bool use_huge_pages)
+{
+    std::vector<Slot, HugePageAllocator<Slot> >(HugePageAllocator<Slot>(use_huge_pages)).swap(slots);
+    num_entries = 0;
+    grow_threshold = 0;
+    capacity_bits = 0;
+}
+
+const HashTableStats& OpenAddressingTable::getStats() const
+{
+    return stats;
+}
+
+void OpenAddressingTable::resetStats()
+{
+    stats = HashTableStats();
+}
+
+std::size_t OpenAddressingTable::getHomeSlot(StateHash hash_value) const
+{
+    return (std::size_t) ((hash_value * FIBONACCI_MULTIPLIER) >> (64 - capacity_bits));
+}
+
+void OpenAddressingTable::rehash(std::size_t new_capacity)
+{
+    assert((new_capacity & (new_capacity - 1)) == 0);
+
+    Slot empty_slot;
+    empty_slot.hash_value = 0;
+    empty_slot.id = NO_NODE_ID;
+    empty_slot.epoch = 0;
+
+    std::vector<Slot, HugePageAllocator<Slot> > old_slots(new_capacity, empty_slot, slots.get_allocator());
+    old_slots.swap(slots);
+
+    capacity_bits = 0;
+    while(((std::size_t) 1 << capacity_bits) < new_capacity)
+        capacity_bits++;
+
+    num_entries = 0;
+    grow_threshold = slots.size() * max_load_factor;
+
+    for(std::size_t i = 0; i < old_slots.size(); i++) {
+        if(old_slots[i].epoch == current_epoch)
+            insert(old_slots[i].hash_value, old_slots[i].id);
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ * open_addressing_table.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef OPEN_ADDRESSING_TABLE_H_
+#define OPEN_ADDRESSING_TABLE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "../../generic_defs/state_hash_function.h"
+#include "../../utils/huge_page_allocator.h"
+
+typedef unsigned NodeID; ///< The ID of a node is the location of the node in the node table.
+
+static const NodeID NO_NODE_ID = (NodeID) -1; ///< Marks a slot in a hash table that does not hold a node.
+
+/**
+ * Statistics describing how a hash table used for duplicate detection has performed.
+ *
+ * @struct HashTableStats
+ */
+struct HashTableStats
+{
+    /**
+     * Constructor that sets all of the statistics to 0.
+     */
+    HashTableStats();
+
+    /**
+     * Returns the average number of slots examined per lookup.
+     *
+     * @return The average probe length, or 0 if no lookups have been performed.
+     */
+    double getAverageProbeLength() const;
+
+    uint64_t num_lookups; ///< The number of lookups performed.
+    uint64_t num_probes; ///< The total number of slots examined during lookups.
+    uint64_t max_probe_length; ///< The largest number of slots examined during a single lookup.
+    uint64_t num_grows; ///< The number of times the table has had to grow and rehash.
+};
+
+/**
+ * A hash table from state hash values to node ids that uses linear probing over a single contiguous slot array.
+ *
+ * Unlike a std::unordered_map, storing a new entry never allocates once the table has been reserved, and a lookup
+ * touches consecutive slots rather than chasing bucket pointers. The capacity is always a power of two, and the
+ * table grows by doubling whenever the maximum load factor would be exceeded.
+ *
+ * Entries can not be removed individually, which is all a node table needs. Instead, each slot is stamped with the
+ * epoch in which it was filled, and a slot is only treated as full if its stamp matches the current epoch. Clearing
+ * the table just starts a new epoch, so it takes constant time however many entries the table held.
+ *
+ * @class OpenAddressingTable
+ */
+class OpenAddressingTable
+{
+public:
+    /**
+     * Constructor for the table. Allocates no slots until the first entry is added or reserve is called.
+     */
+    OpenAddressingTable();
+
+    /**
+     * Destructor for the table. Does nothing.
+     */
+    virtual ~OpenAddressingTable();
+
+    /**
+     * Looks up the given hash value.
+     *
+     * @param hash_value The hash value to look for.
+     * @param id Set to the id associated with the hash value if it is found.
+     * @return If the hash value is stored in the table.
+     */
+    bool find(StateHash hash_value, NodeID &id) const;
+
+    /**
+     * Associates the given hash value with the given id.
+     *
+     * Assumes the hash value is not already in the table.
+     *
+     * @param hash_value The hash value to add.
+     * @param id The id to associate with the hash value.
+     */
+    void insert(StateHash hash_value, NodeID id);
+
+    /**
+     * Removes all entries from the table in constant time. Keeps the slot array allocated.
+     */
+    void clear();
+
+    /**
+     * Grows the slot array so that the given number of entries can be stored without exceeding the load factor.
+     *
+     * @param num_entries The number of entries to make room for.
+     */
+    void reserve(std::size_t num_entries);
+
+    /**
+     * Sets the maximum fraction of slots that can be filled before the table grows.
+     *
+     * Values outside of (0, 0.95] are ignored.
+     *
+     * @param load_factor The new maximum load factor.
+     * @return If the load factor was set.
+     */
+    bool setMaxLoadFactor(double load_factor);
+
+    /**
+     * Returns the number of entries stored.
+     *
+     * @return The number of entries stored.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the number of slots in the table.
+     *
+     * @return The number of slots.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * Sets if the slot array should be backed by huge pages. Frees the current slot array and empties the table.
+     *
+     * @param use_huge_pages If huge pages should be requested.
+     */
+    void setUseHugePages(bool use_huge_pages);
+
+    /**
+     * Returns the probe statistics collected since they were last reset.
+     *
+     * @return The probe statistics.
+     */
+    const HashTableStats &getStats() const;
+
+    /**
+     * Resets the probe statistics.
+     */
+    void resetStats();
+
+protected:
+    /**
+     * A single slot in the table.
+     */
+    struct Slot
+    {
+        StateHash hash_value; ///< The hash value stored in this slot.
+        NodeID id; ///< The id for the stored hash value.
+        uint32_t epoch; ///< The epoch in which the slot was filled. The slot is empty in any other epoch.
+    };
+
+    /**
+     * Returns the slot at which the probe sequence for the given hash value begins.
+     *
+     * @param hash_value The hash value.
+     * @return The home slot of the hash value.
+     */
+    std::size_t getHomeSlot(StateHash hash_value) const;
+
+    /**
+     * Rebuilds the table with the given number of slots. The capacity must be a power of two.
+     *
+     * @param new_capacity The new number of slots.
+     */
+    void rehash(std::size_t new_capacity);
+
+    std::vector<Slot, HugePageAllocator<Slot> > slots; ///< The slot array.
+    std::size_t num_entries; ///< The number of filled slots.
+    std::size_t grow_threshold; ///< The number of entries at which the table must grow.
+    unsigned capacity_bits; ///< The log base 2 of the capacity.
+    double max_load_factor; ///< The maximum fraction of slots that can be filled.
+    uint32_t current_epoch; ///< The current epoch. Never 0, which is the epoch of a newly allocated slot.
+
+    mutable HashTableStats stats; ///< The probe statistics.
+};
+
+#endif /* OPEN_ADDRESSING_TABLE_H_ */
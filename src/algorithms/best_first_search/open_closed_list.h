@@ -12,13 +12,20 @@
 
 #include "../../utils/floating_point_utils.h"
 #include "node_table.h"
+#include "bfs_node_store.h"
+#include "bucket_queue.h"
+#include "tie_breaking.h"
 #include <stdio.h>
 #include <iostream>
 #include <time.h>
 #include <stdlib.h>
 #include <vector>
 
-typedef unsigned BFSOpenLocation; ///< The location of a node in the open list heap.
+/**
+ * The number of children of each node in the open list heap. A wider heap is shallower, so fewer entries are moved
+ * on each push, and the children of a node sit next to each other in memory.
+ */
+static const BFSOpenLocation OPEN_HEAP_ARITY = 4;
 
 /**
  * Defines the possible slocations for a state in the open list.
@@ -38,60 +45,48 @@ enum class StateLocation
 };
 
 /**
- * A class for a Best First Search node.
+ * Defines the possible structures used to order the open list.
+ *
+ * Below is the meaning of each of the values:
+ *
+ * heap - a d-ary heap ordered by node evaluation. Works for any evaluation values.\n
+ * buckets - a BucketQueue with a bucket for each evaluation and a sub-bucket for each g-cost. Intended for domains
+ * where evaluations and g-costs are integers (or multiples of a common bucket width), such as unit-cost tile puzzles
+ * and 4-connected maps. Values that fall into the same bucket are treated as ties.\n
  *
- * @class BFSNode
+ * @class OpenListType
  */
-template<class state_t, class action_t>
-class BFSNode
+enum class OpenListType
 {
-public:
-    /**
-     * A constructor for a BFSNode that sets the node attributes.
-     *
-     * The created node is assumed to be immediately put in the open list, and has not be reopened.
-     *
-     * @todo Make this more generic.
-     *
-     * @param node_state The state corresponding to the node.
-     * @param parent The id of the parent of this node. Should be set to 0 if it has no parent.
-     * @param action The action that generated this node from the corresponding parent.
-     * @param g The g-cost of this node.
-     * @param h The heuristic value of this node.
-     * @param node_eval The evaluation of this node.
-     * @param loc The location of this node in the open list.
-     */
-    BFSNode(const state_t &node_state, NodeID parent, const action_t &action, double g, double h, double node_eval,
-            BFSOpenLocation loc);
-
-    /**
-     * Destructor for a best-first search node. Does nothing.
-     */
-    ~BFSNode();
-
-    state_t state; ///< The state corresponding to this node.
-    NodeID parent_id; ///< The id of the parent of this node.
-    action_t gen_action; ///< A action used to generate this node.
+    heap, buckets
+};
 
-    double g_cost; ///< The g-cost of the node.
-    double h_value; ///< The heuristic value of the node.
+/**
+ * An entry in the open list heap.
+ *
+ * The sort keys are copied from the node so that comparisons made while moving entries through the heap do not need to
+ * access the node table.
+ *
+ * @class OpenListEntry
+ */
+struct OpenListEntry
+{
     double eval; ///< The evaluation of the node.
-
-    BFSOpenLocation location; ///< The location of the node in the open list heap. Means nothing if in_open is false.
-    bool in_open; ///< If the node is in the open list or not.
-
-    bool reopened; ///< If the node has been reopened.
+    double tie_key; ///< The tie-breaking key of the node. Lower keys are expanded first among equal evaluations.
+    NodeID id; ///< The id of the node.
 };
 
 /**
  * A class for an open and closed list to be used by a best-first search.
  *
- * @todo Make the NodeTable store pointers to BFSNode, so that it can creat things that inherit from them.
+ * Nodes with equal evaluations are ordered according to the tie-breaking policy given as the tie_breaker_t template
+ * parameter (see tie_breaking.h).
+ *
  * @todo Make more generic for OCL algorithm.
  *
  * @class OpenClosedList
  */
-template<class state_t, class action_t>
+template<class state_t, class action_t, class tie_breaker_t = ConfigurableTieBreaking>
 class OpenClosedList
 {
 public:
@@ -106,10 +101,64 @@ public:
     virtual ~OpenClosedList();
 
     /**
-     * Clears the open closed list by emptying the table and heap.
+     * Clears the open closed list by emptying the table and heap. Memory is kept for the next search.
      */
     void clear();
 
+    /**
+     * Sets the structure used by the node table to map hash values to nodes. Clears the open and closed lists.
+     *
+     * @param backend The structure to use.
+     */
+    void setNodeTableBackend(NodeTableBackend backend);
+
+    /**
+     * Sets the structure used to order the open list. Clears the open and closed lists.
+     *
+     * When using buckets, a node with evaluation f and g-cost g is put in bucket round(f / width) and sub-bucket
+     * round(g / width), where width is the given bucket width.
+     *
+     * @param type The structure to use.
+     * @param bucket_width The range of values that share a bucket. Ignored unless buckets are used.
+     */
+    void setOpenListType(OpenListType type, double bucket_width = 1.0);
+
+    /**
+     * Returns the tie-breaking policy so that it can be configured. Should only be changed while open is empty.
+     *
+     * @return The tie-breaking policy.
+     */
+    tie_breaker_t &getTieBreaker();
+
+    /**
+     * Sets if the large node and open list arrays should be backed by huge pages. Frees the memory they currently hold
+     * and clears the open and closed lists.
+     *
+     * @param use_huge_pages If huge pages should be requested.
+     */
+    void setUseHugePages(bool use_huge_pages);
+
+    /**
+     * Reserves enough memory to store the given number of nodes without the node table or open list growing.
+     *
+     * @param num_nodes The number of nodes to reserve space for.
+     */
+    void reserve(std::size_t num_nodes);
+
+    /**
+     * Allocates the memory needed by a direct index node table for all hash values below the given value.
+     *
+     * @param hash_range One more than the largest hash value to allocate memory for.
+     */
+    void reserveHashRange(StateHash hash_range);
+
+    /**
+     * Returns the probe statistics of the node table's hash map.
+     *
+     * @return The probe statistics.
+     */
+    const HashTableStats &getNodeTableStats() const;
+
     /**
      * Returns whether the state is in the open list, closed list, or is not stored.
      *
@@ -121,20 +170,76 @@ public:
     StateLocation getStateLocation(const state_t &state, StateHash hash_value, NodeID &id);
 
     /**
-     * Returns the node corresponding to the given id.
+     * Returns the state of the node with the given id.
+     *
+     * The reference remains valid while nodes are added, until the open and closed lists are cleared.
+     *
+     * @param id The id of the node.
+     * @return The state of the node.
+     */
+    const state_t &getState(NodeID id) const;
+
+    /**
+     * Returns the id of the parent of the node with the given id.
      *
-     * @param id The id of the node to return.
-     * @return The node corresponding to the given id.
+     * @param id The id of the node.
+     * @return The id of the parent.
      */
-    BFSNode<state_t, action_t> &getNode(NodeID id);
+    NodeID getParent(NodeID id) const;
 
     /**
-     * Returns a const reference to a node corresponding to the given id.
+     * Returns the action used to generate the node with the given id.
      *
-     * @param id The id of the node to return.
-     * @return The node corresponding to the given id.
+     * @param id The id of the node.
+     * @return The generating action.
      */
-    const BFSNode<state_t, action_t> &getNode(NodeID id) const;
+    const action_t &getGenAction(NodeID id) const;
+
+    /**
+     * Returns the g-cost of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The g-cost.
+     */
+    double getGCost(NodeID id) const;
+
+    /**
+     * Returns the heuristic value of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The heuristic value.
+     */
+    double getHValue(NodeID id) const;
+
+    /**
+     * Returns the hash value of the state of the node with the given id.
+     *
+     * @param id The id of the node.
+     * @return The hash value.
+     */
+    StateHash getHashValue(NodeID id) const;
+
+    /**
+     * Returns if the node with the given id has been reopened.
+     *
+     * @param id The id of the node.
+     * @return If the node has been reopened.
+     */
+    bool isReopened(NodeID id) const;
+
+    /**
+     * Replaces the path to the node with the given id with a new one.
+     *
+     * If the node is open, openNodeEvalChanged must be called afterwards. If it is closed, it can be reopened with
+     * reopenNode.
+     *
+     * @param id The id of the node.
+     * @param parent The id of the new parent.
+     * @param action The action that generates the node from the new parent.
+     * @param g The new g-cost.
+     * @param node_eval The new evaluation.
+     */
+    void setNodePath(NodeID id, NodeID parent, const action_t &action, double g, double node_eval);
 
     /**
      * Adds a new node with the given attributes to the open list.
@@ -169,16 +274,13 @@ public:
             double h, double node_eval);
 
     /**
-     * Finds the best node in the open list according to the node evaluation, returns its id, and moves it to closed.
+     * Finds the best node in the open list according to the node evaluation and the tie-breaking policy, returns its
+     * id, and moves it to closed.
      *
      * @return The node id of the best node on the open list.
      */
     virtual NodeID getBestNodeAndClose();
 
-    virtual NodeID getLowGAndClose();
-
-    virtual NodeID getHighGAndClose();
-
     /**
      * Adjusts the open list as needed because the node evaluation of the node with the given id has changed.
      *
@@ -223,23 +325,22 @@ public:
 
 protected:
     /**
-     * Returns true if the evaluation of the first node is less than or equal to the second.
+     * Returns true if the first entry should be expanded before the second. That is, if the evaluation of the first is
+     * lower than the second, or they are equal and the tie-breaking key of the first is lower.
      *
-     * @param node_1 The first node being compared.
-     * @param node_2 The second node being compared.
-     * @return If the evaluation of the first node is less than or equal to the second.
+     * @param entry_1 The first entry being compared.
+     * @param entry_2 The second entry being compared.
+     * @return If the first entry is better than the second.
      */
-    virtual bool nodeNoWorse(const BFSNode<state_t, action_t> &node_1,
-            const BFSNode<state_t, action_t> &node_2) const;
+    bool entryBetter(const OpenListEntry &entry_1, const OpenListEntry &entry_2) const;
 
     /**
-     * Returns true if the evaluation of the node in the open list at the first location is less than or equal to the second.
+     * Sets the open list entry at the given location to hold the current sort keys of the node with the given id.
      *
-     * @param loc_1 The location in the open list of the first node being compared.
-     * @param loc_2 The location in the open list of the second node being compared.
-     * @return If the evaluation of the first node is less than or equal to the second.
+     * @param loc The location in the open list.
+     * @param id The id of the node.
      */
-    virtual bool nodeNoWorse(BFSOpenLocation loc_1, BFSOpenLocation loc_2) const;
+    void setOpenEntry(BFSOpenLocation loc, NodeID id);
 
     /**
      * Heapify's up the node at the given open list location if it needs to be moved up.
@@ -257,75 +358,150 @@ protected:
      */
     bool heapifyDown(BFSOpenLocation loc);
 
+    void printOpen();
+
     /**
-     * Swaps the elements in their locations in the heaps at the given locations, and updates the nodes accordingly.
+     * Returns the bucket (or sub-bucket) that the given value belongs in when using a bucket open list.
      *
-     * @param loc_1 The first location in the heap.
-     * @param loc_2 The second location in the heap.
+     * @param value The evaluation or g-cost.
+     * @return The index of the bucket.
      */
-    void swapOpenLocations(BFSOpenLocation loc_1, BFSOpenLocation loc_2);
+    std::size_t getBucketIndex(double value) const;
 
-    void printOpen();
+    /**
+     * Pops entries from the bucket open list until finding one that is up to date, closes the node, and returns it.
+     *
+     * An entry is out of date if the node has been closed, or its evaluation or g-cost has changed since it was pushed.
+     * Since buckets can only break ties by g-cost, the tie-breaking policy is reduced to whether it prefers high or
+     * low g-costs, and remaining ties are broken in last-in, first-out order.
+     *
+     * @param high_g If ties in evaluation should be broken in favour of higher g-costs.
+     * @return The id of the node closed.
+     */
+    NodeID getBestBucketNodeAndClose(bool high_g);
+
+    NodeTable node_table; ///< The table mapping state hash values to node ids.
+    BFSNodeStore<state_t, action_t> nodes; ///< The nodes being stored.
+    std::vector<OpenListEntry, HugePageAllocator<OpenListEntry> > open_list_heap; ///< The open list heap.
 
-    NodeTable<BFSNode<state_t, action_t> > node_table; ///< The table of nodes being stored.
-    std::vector<NodeID> open_list_heap; ///< The heap holding node ids representing the open list.
+    tie_breaker_t tie_breaker; ///< The policy used to order nodes with equal evaluations.
+    uint64_t open_counter; ///< The number of times a node has been added to open or updated since the last clear.
+
+    OpenListType open_type; ///< The structure used to order the open list.
+    BucketQueue open_buckets; ///< The bucket open list. Only used if open_type is buckets.
+    double open_bucket_width; ///< The range of values that share a bucket.
+    std::size_t bucket_open_count; ///< The number of nodes open when using buckets.
 };
 
-template<class state_t, class action_t>
-BFSNode<state_t, action_t>::BFSNode(const state_t& node_state, NodeID parent, const action_t& action, double g,
-        double h, double node_eval, BFSOpenLocation loc)
-        : state(node_state), parent_id(parent), gen_action(action), g_cost(g), h_value(h), eval(node_eval),
-                location(loc), in_open(true), reopened(false)
+template<class state_t, class action_t, class tie_breaker_t>
+inline OpenClosedList<state_t, action_t, tie_breaker_t>::OpenClosedList()
+        : open_counter(0), open_type(OpenListType::heap), open_bucket_width(1.0), bucket_open_count(0)
 {
 }
 
-template<class state_t, class action_t>
-BFSNode<state_t, action_t>::~BFSNode()
+template<class state_t, class action_t, class tie_breaker_t>
+inline OpenClosedList<state_t, action_t, tie_breaker_t>::~OpenClosedList()
 {
 }
 
-template<class state_t, class action_t>
-inline OpenClosedList<state_t, action_t>::OpenClosedList()
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::clear()
 {
+    node_table.clear();
+    nodes.clear();
+    open_list_heap.clear();
+    open_buckets.clear();
+    bucket_open_count = 0;
+    open_counter = 0;
 }
 
-template<class state_t, class action_t>
-inline OpenClosedList<state_t, action_t>::~OpenClosedList()
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::setOpenListType(OpenListType type, double bucket_width)
 {
+    clear();
+    open_type = type;
+    if(fp_greater(bucket_width, 0.0))
+        open_bucket_width = bucket_width;
 }
 
-template<class state_t, class action_t>
-void OpenClosedList<state_t, action_t>::clear()
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::setNodeTableBackend(NodeTableBackend backend)
 {
-    node_table.clear();
-    open_list_heap.clear();
+    clear();
+    node_table.setBackend(backend);
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::setUseHugePages(bool use_huge_pages)
+{
+    clear();
+    node_table.setUseHugePages(use_huge_pages);
+    nodes.setUseHugePages(use_huge_pages);
+    open_list_heap = std::vector<OpenListEntry, HugePageAllocator<OpenListEntry> >(
+            HugePageAllocator<OpenListEntry>(use_huge_pages));
 }
 
-template<class state_t, class action_t>
-StateLocation OpenClosedList<state_t, action_t>::getStateLocation(const state_t& state, StateHash hash_value,
-        NodeID& id)
+template<class state_t, class action_t, class tie_breaker_t>
+inline tie_breaker_t& OpenClosedList<state_t, action_t, tie_breaker_t>::getTieBreaker()
+{
+    return tie_breaker;
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::reserve(std::size_t num_nodes)
+{
+    node_table.reserve(num_nodes);
+    nodes.reserve(num_nodes);
+    open_list_heap.reserve(num_nodes);
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+inline void OpenClosedList<state_t, action_t, tie_breaker_t>::reserveHashRange(StateHash hash_range)
+{
+    node_table.reserveHashRange(hash_range);
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+inline const HashTableStats& OpenClosedList<state_t, action_t, tie_breaker_t>::getNodeTableStats() const
+{
+    return node_table.getTableStats();
+}
+
+template<class state_t, class action_t, class tie_breaker_t>
+StateLocation OpenClosedList<state_t, action_t, tie_breaker_t>::getStateLocation(const state_t& state,
+        StateHash hash_value, NodeID& id)
 {
     bool is_stored = node_table.isNodeStored(hash_value, id);
 
     if(is_stored) {
-        if(node_table.getNode(id).in_open)
+        if(nodes.isOpen(id))
             return StateLocation::open;
         return StateLocation::closed;
     }
     return StateLocation::none;
 }
 
-template<class state_t, class action_t>
-NodeID OpenClosedList<state_t, action_t>::addNewNodeToOpen(const state_t& state, const action_t &action,
+template<class state_t, class action_t, class tie_breaker_t>
+NodeID OpenClosedList<state_t, action_t, tie_breaker_t>::addNewNodeToOpen(const state_t& state, const action_t &action,
         StateHash hash_value, double g, double h, double node_eval, NodeID parent)
 {
-    NodeID new_id = node_table.addNewSearchNode(
-            BFSNode<state_t, action_t>(state, parent, action, g, h, node_eval, open_list_heap.size()), hash_value);
+    NodeID new_id = node_table.addNewSearchNode(hash_value);
+    nodes.addNode(state, parent, action, g, h, node_eval, hash_value);
+    assert(nodes.size() == node_table.size());
 
     //std::cout << "New ID " << new_id << std::endl;
     //std::cout << "Node Table Size " << node_table.size() << std::endl;
 
-    open_list_heap.push_back(new_id);
+    nodes.setOpenOrder(new_id, open_counter++);
+
+    if(open_type == OpenListType::buckets) {
+        open_buckets.push(new_id, getBucketIndex(node_eval), getBucketIndex(g));
+        bucket_open_count++;
+        return new_id;
+    }
+
+    open_list_heap.push_back(OpenListEntry());
+    setOpenEntry(open_list_heap.size() - 1, new_id);
 
     heapifyUp(open_list_heap.size() - 1);
 
@@ -422,73 +598,109 @@ NodeID OpenClosedList<state_t, action_t>::addNewNodeToOpen(const state_t& state,
 //     return new_id;
 // }
 
-template<class state_t, class action_t>
-inline std::size_t OpenClosedList<state_t, action_t>::openListSize() const
+template<class state_t, class action_t, class tie_breaker_t>
+inline std::size_t OpenClosedList<state_t, action_t, tie_breaker_t>::openListSize() const
 {
+    if(open_type == OpenListType::buckets)
+        return bucket_open_count;
     return open_list_heap.size();
 }
 
-template<class state_t, class action_t>
-inline std::size_t OpenClosedList<state_t, action_t>::closedListSize() const
+template<class state_t, class action_t, class tie_breaker_t>
+inline std::size_t OpenClosedList<state_t, action_t, tie_breaker_t>::closedListSize() const
 {
     return size() - openListSize();
 }
 
-template<class state_t, class action_t>
-inline std::size_t OpenClosedList<state_t, action_t>::size() const
+template<class state_t, class action_t, class tie_breaker_t>
+inline std::size_t OpenClosedList<state_t, action_t, tie_breaker_t>::size() const
 {
     return node_table.size();
 }
 
-template<class state_t, class action_t>
-bool OpenClosedList<state_t, action_t>::heapifyUp(BFSOpenLocation loc)
+template<class state_t, class action_t, class tie_breaker_t>
+bool OpenClosedList<state_t, action_t, tie_breaker_t>::heapifyUp(BFSOpenLocation loc)
 {
     assert(loc < open_list_heap.size());
-    if(loc == 0)
-        return false;
 
-    BFSOpenLocation parent_loc = (loc - 1) / 2;
+    OpenListEntry entry = open_list_heap[loc];
+    BFSOpenLocation start_loc = loc;
 
-    if(!nodeNoWorse(parent_loc, loc)) {
-        swapOpenLocations(loc, parent_loc);
+    while(loc > 0) {
+        BFSOpenLocation parent_loc = (loc - 1) / OPEN_HEAP_ARITY;
 
-        heapifyUp(parent_loc);
-        return true;
+        if(!entryBetter(entry, open_list_heap[parent_loc]))
+            break;
+
+        open_list_heap[loc] = open_list_heap[parent_loc];
+        nodes.setLocation(open_list_heap[loc].id, loc);
+        loc = parent_loc;
     }
-    return false;
+
+    if(loc == start_loc)
+        return false;
+
+    open_list_heap[loc] = entry;
+    nodes.setLocation(entry.id, loc);
+    return true;
 }
 
-template<class state_t, class action_t>
-inline bool OpenClosedList<state_t, action_t>::nodeNoWorse(const BFSNode<state_t, action_t>& node_1,
-        const BFSNode<state_t, action_t>& node_2) const
+template<class state_t, class action_t, class tie_breaker_t>
+inline bool OpenClosedList<state_t, action_t, tie_breaker_t>::entryBetter(const OpenListEntry& entry_1,
+        const OpenListEntry& entry_2) const
 {
-    return !fp_greater
-    (node_1.eval, node_2.eval);
+    if(entry_1.eval < entry_2.eval - TOLERANCE)
+        return true;
+    if(entry_1.eval > entry_2.eval + TOLERANCE)
+        return false;
+    return entry_1.tie_key < entry_2.tie_key - TOLERANCE;
 }
 
-template<class state_t, class action_t>
-inline bool OpenClosedList<state_t, action_t>::nodeNoWorse(BFSOpenLocation loc_1, BFSOpenLocation loc_2) const
+template<class state_t, class action_t, class tie_breaker_t>
+inline void OpenClosedList<state_t, action_t, tie_breaker_t>::setOpenEntry(BFSOpenLocation loc, NodeID id)
 {
-    return nodeNoWorse(getNode(open_list_heap[loc_1]), getNode(open_list_heap[loc_2]));
+    open_list_heap[loc].eval = nodes.getEval(id);
+    open_list_heap[loc].tie_key = tie_breaker.getTieKey(nodes.getGCost(id), nodes.getHValue(id),
+            nodes.getOpenOrder(id));
+    open_list_heap[loc].id = id;
+    nodes.setLocation(id, loc);
 }
 
-template<class state_t, class action_t>
-void OpenClosedList<state_t, action_t>::openNodeEvalChanged(NodeID id)
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::openNodeEvalChanged(NodeID id)
 {
-    if(!heapifyUp(node_table[id].location))
-        heapifyDown(heapifyUp(node_table[id].location));
+    nodes.setOpenOrder(id, open_counter++);
+
+    if(open_type == OpenListType::buckets) { // the old entry is skipped when popped since it is now out of date
+        open_buckets.push(id, getBucketIndex(nodes.getEval(id)), getBucketIndex(nodes.getGCost(id)));
+        return;
+    }
+
+    BFSOpenLocation loc = nodes.getLocation(id);
+    setOpenEntry(loc, id);
+
+    if(!heapifyUp(loc))
+        heapifyDown(loc);
 }
 
-template<class state_t, class action_t>
-void OpenClosedList<state_t, action_t>::reopenNode(NodeID id)
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::reopenNode(NodeID id)
 {
-    assert(node_table[id].in_open == false);
-    node_table[id].in_open = true;
-    node_table[id].reopened = true;
-    node_table[id].location = open_list_heap.size();
-    open_list_heap.push_back(id);
+    assert(!nodes.isOpen(id));
+    nodes.setOpen(id, true);
+    nodes.setReopened(id);
+    nodes.setOpenOrder(id, open_counter++);
+
+    if(open_type == OpenListType::buckets) {
+        open_buckets.push(id, getBucketIndex(nodes.getEval(id)), getBucketIndex(nodes.getGCost(id)));
+        bucket_open_count++;
+        return;
+    }
+
+    open_list_heap.push_back(OpenListEntry());
+    setOpenEntry(open_list_heap.size() - 1, id);
 
-    heapifyUp(node_table[id].location);
+    heapifyUp(open_list_heap.size() - 1);
 }
 
 // template<class state_t, class action_t>
@@ -528,7 +740,7 @@ void OpenClosedList<state_t, action_t>::reopenNode(NodeID id)
 //     }
 
 //     NodeID best_id = open_list_heap[min_idx];
-//     node_table[best_id].in_open = false;
+//     nodes.setOpen(best_id, false);
 
 //     open_list_heap[min_idx] = open_list_heap.back();
 //     node_table.getNode(open_list_heap[min_idx]).location = 0;
@@ -539,192 +751,162 @@ void OpenClosedList<state_t, action_t>::reopenNode(NodeID id)
 //     return best_id;
 // }
 
-template<class state_t, class action_t>
-NodeID OpenClosedList<state_t, action_t>::getBestNodeAndClose()
+template<class state_t, class action_t, class tie_breaker_t>
+NodeID OpenClosedList<state_t, action_t, tie_breaker_t>::getBestNodeAndClose()
 {
+    if(open_type == OpenListType::buckets)
+        return getBestBucketNodeAndClose(tie_breaker.prefersHighG());
+
     assert(!open_list_heap.empty());
 
-    NodeID best_id = open_list_heap[0];
-    node_table[best_id].in_open = false;
+    NodeID best_id = open_list_heap[0].id;
+    nodes.setOpen(best_id, false);
 
     open_list_heap[0] = open_list_heap.back();
-    node_table.getNode(open_list_heap[0]).location = 0;
     open_list_heap.pop_back();
 
-    heapifyDown(0);
+    if(!open_list_heap.empty()) {
+        nodes.setLocation(open_list_heap[0].id, 0);
+        heapifyDown(0);
+    }
 
     return best_id;
 }
 
-template<class state_t, class action_t>
-NodeID OpenClosedList<state_t, action_t>::getLowGAndClose()
+template<class state_t, class action_t, class tie_breaker_t>
+inline const state_t& OpenClosedList<state_t, action_t, tie_breaker_t>::getState(NodeID id) const
 {
-
-    assert(!open_list_heap.empty());
-
-    unsigned int i;
-    int min_idx = 0;
-    double min_val = getNode(open_list_heap[0]).eval;
-    double min_g = getNode(open_list_heap[0]).g_cost;
-
-    // std::vector<int> tied_g_vals;
-    // int tie_g_count = 0;
-
-    if (open_list_heap.size() > 1) {
-        for (i = 1; i < open_list_heap.size(); i++) {
-            BFSNode<state_t, action_t> cur_node = getNode(open_list_heap[i]);
-            if (cur_node.eval < min_val) {
-                min_val = cur_node.eval;
-                min_g = cur_node.g_cost;
-                min_idx = i;
-            } else if (cur_node.eval == min_val) {
-                if (cur_node.g_cost < min_g) {
-                    min_val = cur_node.eval;
-                    min_g = cur_node.g_cost;
-                    min_idx = i;
-                    // tied_g_vals.clear();
-                    // tied_g_vals.push_back(i);
-                    // tie_g_count = 1;
-                // } else if (cur_node.g_cost == min_g) {
-                //     tied_g_vals.push_back(i);
-                //     tie_g_count++;
-                }
-
-            } else {
-                break;
-            }
-        }
-    }
-
-    // if (tie_g_count > 1) {
-    //     std::srand(time(0));
-    //     int r = (std::rand() % (tie_g_count));
-    //     min_idx = tied_g_vals[r];
-    //     // std::cout << r << std::endl;
-    //     // std::cout << "Tie g count: " << tie_g_count << std::endl;
-    // }
-
-
-    NodeID best_id = open_list_heap[min_idx];
-    node_table[best_id].in_open = false;
-
-    open_list_heap[min_idx] = open_list_heap.back();
-    node_table.getNode(open_list_heap[min_idx]).location = 0;
-    open_list_heap.pop_back();
-
-    heapifyDown(min_idx);
-
-    return best_id;
+    return nodes.getState(id);
 }
 
-template<class state_t, class action_t>
-NodeID OpenClosedList<state_t, action_t>::getHighGAndClose()
+template<class state_t, class action_t, class tie_breaker_t>
+inline NodeID OpenClosedList<state_t, action_t, tie_breaker_t>::getParent(NodeID id) const
 {
+    return nodes.getParent(id);
+}
 
-    assert(!open_list_heap.empty());
-
-    unsigned int i;
-    int min_idx = 0;
-    double min_val = getNode(open_list_heap[0]).eval;
-    double max_g = getNode(open_list_heap[0]).g_cost;
-
-    if (open_list_heap.size() > 1) {
-        for (i = 1; i < open_list_heap.size(); i++) {
-            BFSNode<state_t, action_t> cur_node = getNode(open_list_heap[i]);
-            if (cur_node.eval < min_val) {
-                min_val = cur_node.eval;
-                max_g = cur_node.g_cost;
-                min_idx = i;
-            } else if (cur_node.eval == min_val) {
-                if (cur_node.g_cost > max_g) {
-                    min_val = cur_node.eval;
-                    max_g = cur_node.g_cost;
-                    min_idx = i;
-                } 
-            } else {
-                break;
-            }
-        }
-    }
-
-    NodeID best_id = open_list_heap[min_idx];
-    node_table[best_id].in_open = false;
+template<class state_t, class action_t, class tie_breaker_t>
+inline const action_t& OpenClosedList<state_t, action_t, tie_breaker_t>::getGenAction(NodeID id) const
+{
+    return nodes.getGenAction(id);
+}
 
-    open_list_heap[min_idx] = open_list_heap.back();
-    node_table.getNode(open_list_heap[min_idx]).location = 0;
-    open_list_heap.pop_back();
+template<class state_t, class action_t, class tie_breaker_t>
+inline double OpenClosedList<state_t, action_t, tie_breaker_t>::getGCost(NodeID id) const
+{
+    return nodes.getGCost(id);
+}
 
-    heapifyDown(min_idx);
+template<class state_t, class action_t, class tie_breaker_t>
+inline double OpenClosedList<state_t, action_t, tie_breaker_t>::getHValue(NodeID id) const
+{
+    return nodes.getHValue(id);
+}
 
-    return best_id;
+template<class state_t, class action_t, class tie_breaker_t>
+inline StateHash OpenClosedList<state_t, action_t, tie_breaker_t>::getHashValue(NodeID id) const
+{
+    return nodes.getHashValue(id);
 }
 
-template<class state_t, class action_t>
-inline BFSNode<state_t, action_t>& OpenClosedList<state_t, action_t>::getNode(NodeID id)
+template<class state_t, class action_t, class tie_breaker_t>
+inline bool OpenClosedList<state_t, action_t, tie_breaker_t>::isReopened(NodeID id) const
 {
-    return node_table[id];
+    return nodes.isReopened(id);
 }
 
-template<class state_t, class action_t>
-inline const BFSNode<state_t, action_t>& OpenClosedList<state_t, action_t>::getNode(NodeID id) const
+template<class state_t, class action_t, class tie_breaker_t>
+inline void OpenClosedList<state_t, action_t, tie_breaker_t>::setNodePath(NodeID id, NodeID parent,
+        const action_t& action, double g, double node_eval)
 {
-    return node_table[id];
+    nodes.setPath(id, parent, action, g, node_eval);
 }
 
-template<class state_t, class action_t>
-inline NodeID OpenClosedList<state_t, action_t>::addInitialNodeToOpen(const state_t& state, const action_t& action,
-        StateHash hash_value, double h, double node_eval)
+template<class state_t, class action_t, class tie_breaker_t>
+inline NodeID OpenClosedList<state_t, action_t, tie_breaker_t>::addInitialNodeToOpen(const state_t& state,
+        const action_t& action, StateHash hash_value, double h, double node_eval)
 {
     return addNewNodeToOpen(state, action, hash_value, 0.0, h, node_eval, 0);
 }
 
-template<class state_t, class action_t>
-inline bool OpenClosedList<state_t, action_t>::isOpenEmpty() const
+template<class state_t, class action_t, class tie_breaker_t>
+inline bool OpenClosedList<state_t, action_t, tie_breaker_t>::isOpenEmpty() const
 {
-    return open_list_heap.size() == 0;
+    return openListSize() == 0;
 }
 
-template<class state_t, class action_t>
-bool OpenClosedList<state_t, action_t>::heapifyDown(BFSOpenLocation loc)
+template<class state_t, class action_t, class tie_breaker_t>
+bool OpenClosedList<state_t, action_t, tie_breaker_t>::heapifyDown(BFSOpenLocation loc)
 {
-    BFSOpenLocation left_child_loc = loc * 2 + 1;
-    BFSOpenLocation right_child_loc = loc * 2 + 2;
-    BFSOpenLocation best_child_loc;
+    assert(loc < open_list_heap.size());
 
-    if(left_child_loc >= open_list_heap.size())
-        return false;
-    else if(right_child_loc >= open_list_heap.size() || nodeNoWorse(left_child_loc, right_child_loc))
-        best_child_loc = left_child_loc;
-    else
-        best_child_loc = right_child_loc;
+    OpenListEntry entry = open_list_heap[loc];
+    BFSOpenLocation start_loc = loc;
+    BFSOpenLocation heap_size = open_list_heap.size();
 
-    if(!nodeNoWorse(loc, best_child_loc)) {
-        swapOpenLocations(loc, best_child_loc);
+    while(true) {
+        BFSOpenLocation first_child_loc = loc * OPEN_HEAP_ARITY + 1;
+        if(first_child_loc >= heap_size)
+            break;
 
-        heapifyDown(best_child_loc);
-        return true;
+        BFSOpenLocation end_child_loc = first_child_loc + OPEN_HEAP_ARITY;
+        if(end_child_loc > heap_size)
+            end_child_loc = heap_size;
+
+        BFSOpenLocation best_child_loc = first_child_loc;
+        for(BFSOpenLocation child_loc = first_child_loc + 1; child_loc < end_child_loc; child_loc++) {
+            if(entryBetter(open_list_heap[child_loc], open_list_heap[best_child_loc]))
+                best_child_loc = child_loc;
+        }
+
+        if(!entryBetter(open_list_heap[best_child_loc], entry))
+            break;
+
+        open_list_heap[loc] = open_list_heap[best_child_loc];
+        nodes.setLocation(open_list_heap[loc].id, loc);
+        loc = best_child_loc;
     }
 
-    return false;
+    if(loc == start_loc)
+        return false;
+
+    open_list_heap[loc] = entry;
+    nodes.setLocation(entry.id, loc);
+    return true;
 }
 
-template<class state_t, class action_t>
-inline void OpenClosedList<state_t, action_t>::swapOpenLocations(BFSOpenLocation loc_1, BFSOpenLocation loc_2)
+template<class state_t, class action_t, class tie_breaker_t>
+void OpenClosedList<state_t, action_t, tie_breaker_t>::printOpen()
 {
-    NodeID id = open_list_heap[loc_1];
-    open_list_heap[loc_1] = open_list_heap[loc_2];
-    open_list_heap[loc_2] = id;
+    for(unsigned i = 0; i < open_list_heap.size(); i++) {
+        std::cout << "ID " << open_list_heap[i].id << ", eval " << open_list_heap[i].eval << std::endl;
+    }
+}
 
-    node_table.getNode(open_list_heap[loc_1]).location = loc_1;
-    node_table.getNode(open_list_heap[loc_2]).location = loc_2;
+template<class state_t, class action_t, class tie_breaker_t>
+inline std::size_t OpenClosedList<state_t, action_t, tie_breaker_t>::getBucketIndex(double value) const
+{
+    if(fp_less(value, 0.0))
+        return 0;
+    return (std::size_t) (value / open_bucket_width + 0.5);
 }
 
-template<class state_t, class action_t>
-void OpenClosedList<state_t, action_t>::printOpen()
+template<class state_t, class action_t, class tie_breaker_t>
+NodeID OpenClosedList<state_t, action_t, tie_breaker_t>::getBestBucketNodeAndClose(bool high_g)
 {
-    for(unsigned i = 0; i < open_list_heap.size(); i++) {
-        std::cout << "ID " << open_list_heap[i] << ", eval " << getNode(open_list_heap[i]).eval << std::endl;
+    assert(bucket_open_count > 0);
+
+    std::size_t bucket, sub_bucket;
+    while(true) {
+        NodeID id = open_buckets.pop(high_g, bucket, sub_bucket);
+        if(nodes.isOpen(id) && getBucketIndex(nodes.getEval(id)) == bucket
+                && getBucketIndex(nodes.getGCost(id)) == sub_bucket) {
+            nodes.setOpen(id, false);
+            bucket_open_count--;
+            return id;
+        }
     }
+    return 0;
 }
 
 #endif /* OPEN_CLOSED_LIST_H_ */
@@ -0,0 +1,95 @@
+/*
+ * search_stats.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef SEARCH_STATS_H_
+#define SEARCH_STATS_H_
+
+/**
+ * Policies for how StaticBestFirstSearch keeps its operation counters, enforces the resource limits set on the search
+ * engine, and reports search events.
+ *
+ * A policy is a class with the following static constants:
+ *
+ * COUNT_OPERATIONS - if the goal test, successor function, state generation, action generation, and heuristic
+ * computation counters are updated. If false, the engine reports zero for all of them.\n
+ * CHECK_LIMITS - if the resource limits are enforced. Requires COUNT_OPERATIONS.\n
+ * LIMIT_CHECK_INTERVAL - how often the limits are checked. If 1, each limit is checked before every operation it
+ * limits, so the search stops exactly at the limit. If larger, all limits are checked together once every this many
+ * expansions, so a search can overrun a limit by up to an interval's worth of operations.\n
+ *
+ * It also has the following member function templates, which are called on the engine's copy of the policy:
+ *
+ * void nodeExpanded(const state_t &state, double g_cost) - called when a node is removed from open for expansion.\n
+ * void nodeGenerated(const state_t &state, double g_cost, double h_value) - called when a node is added to open.\n
+ *
+ * All constants are known at compile time and the hooks of the provided policies are empty, so whatever a policy
+ * disables adds no work to the search loop.
+ */
+
+/**
+ * A base class for policies with no observer hooks. Policies that need hooks can hide these with their own.
+ *
+ * @class NullSearchObserver
+ */
+class NullSearchObserver
+{
+public:
+    template<class state_t>
+    void nodeExpanded(const state_t &state, double g_cost)
+    {
+    }
+
+    template<class state_t>
+    void nodeGenerated(const state_t &state, double g_cost, double h_value)
+    {
+    }
+};
+
+/**
+ * A policy that updates all counters and checks each limit before every operation. This matches the behaviour of
+ * BestFirstSearch, and is the default policy.
+ *
+ * @class ExactSearchStats
+ */
+class ExactSearchStats: public NullSearchObserver
+{
+public:
+    static const bool COUNT_OPERATIONS = true;
+    static const bool CHECK_LIMITS = true;
+    static const unsigned LIMIT_CHECK_INTERVAL = 1;
+};
+
+/**
+ * A policy that updates all counters, but only checks the limits once every check_interval expansions.
+ *
+ * @class BatchedSearchStats
+ */
+template<unsigned check_interval>
+class BatchedSearchStats: public NullSearchObserver
+{
+public:
+    static const bool COUNT_OPERATIONS = true;
+    static const bool CHECK_LIMITS = true;
+    static const unsigned LIMIT_CHECK_INTERVAL = check_interval;
+};
+
+/**
+ * A policy that keeps no counters and ignores all limits.
+ *
+ * @class NoSearchStats
+ */
+class NoSearchStats: public NullSearchObserver
+{
+public:
+    static const bool COUNT_OPERATIONS = false;
+    static const bool CHECK_LIMITS = false;
+    static const unsigned LIMIT_CHECK_INTERVAL = 1;
+};
+
+#endif /* SEARCH_STATS_H_ */
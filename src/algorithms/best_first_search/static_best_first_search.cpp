@@ -0,0 +1,10 @@
+/*
+ * static_best_first_search.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "static_best_first_search.h"
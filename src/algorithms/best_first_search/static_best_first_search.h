@@ -0,0 +1,594 @@
+/*
+ * static_best_first_search.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef STATIC_BEST_FIRST_SEARCH_H_
+#define STATIC_BEST_FIRST_SEARCH_H_
+
+#include "best_first_search.h"
+#include "node_evaluation.h"
+#include "search_stats.h"
+#include <type_traits>
+
+/**
+ * A best-first search that is given the concrete types of its transition system, heuristic, and hash function, along
+ * with an evaluation policy (see node_evaluation.h), as template parameters.
+ *
+ * This makes the same expansions as the BestFirstSearch subclass that matches the evaluation policy, but every call
+ * made per generated node (action costs, applying actions, hashing, heuristic computation, node evaluation, and the
+ * search counters) is resolved at compile time, so the compiler can inline it. This matters most in domains where
+ * these functions are cheap, such as map pathfinding. BestFirstSearch should be used when the types of the search
+ * components are only known at runtime.
+ *
+ * The type requirements are as follows:
+ *
+ * transitions_t - a subclass of TransitionSystem<state_t, action_t>.\n
+ * heuristic_t - a subclass of Heuristic<state_t> that makes computeHValue public. If it is a subclass of
+ * IncrementalHeuristic<state_t, action_t>, the heuristic value of each child is computed from that of its parent.
+ * Otherwise, the heuristic values of the new children of each expansion are computed with one call to computeHValues.\n
+ * hash_t - a subclass of StateHashFunction<state_t>.\n
+ * eval_t - an evaluation policy.\n
+ * stats_t - a policy for the operation counters, resource limits, and observer hooks (see search_stats.h).\n
+ *
+ * The goal test is still called through the GoalTestFunction interface, since it is only called once per expansion.
+ *
+ * @class StaticBestFirstSearch
+ */
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t = ConfigurableTieBreaking, class stats_t = ExactSearchStats>
+class StaticBestFirstSearch: public SearchEngine<state_t, action_t>
+{
+    typedef SearchEngine<state_t, action_t> Engine;
+
+    /**
+     * If each limit is checked before every operation it limits.
+     */
+    static const bool EXACT_LIMITS = stats_t::CHECK_LIMITS && stats_t::LIMIT_CHECK_INTERVAL == 1;
+
+    /**
+     * If the heuristic computes the heuristic values of children from those of their parents.
+     */
+    static const bool INCREMENTAL_H = std::is_base_of<IncrementalHeuristic<state_t, action_t>, heuristic_t>::value;
+
+    using Engine::goal_test;
+    using Engine::incumbent_plan;
+    using Engine::incumbent_cost;
+
+    using Engine::hitSuccFuncLimit;
+    using Engine::hitGoalTestLimit;
+    using Engine::hitHCompLimit;
+
+public:
+    StaticBestFirstSearch();
+    virtual ~StaticBestFirstSearch();
+
+    /**
+     * Sets the transition system used by the search.
+     *
+     * @param o A pointer to the transition system.
+     */
+    void setTransitionSystem(const transitions_t *o);
+
+    /**
+     * Sets the hash function used by the search.
+     *
+     * @param hash A pointer to the hash function.
+     */
+    void setHashFunction(const hash_t *hash);
+
+    /**
+     * Sets the heuristic function used by the search.
+     *
+     * @param heur A pointer to the heuristic function to use.
+     */
+    void setHeuristic(const heuristic_t *heur);
+
+    /**
+     * Sets if closed nodes are moved back to open when a cheaper path to them is found. True by default.
+     *
+     * @param is_reopen If closed nodes should be reopened.
+     */
+    void setReopen(bool is_reopen);
+
+    /**
+     * Returns the evaluation policy, so that it can be configured.
+     *
+     * @return The evaluation policy.
+     */
+    eval_t &getEvaluator();
+
+    /**
+     * Sets the rule used to break ties between nodes with equal evaluations. Only available when using the default
+     * ConfigurableTieBreaking policy.
+     *
+     * @param type The tie-breaking rule to use.
+     */
+    void setTieBreaker(TieBreakType type);
+
+    /**
+     * Sets the structure used for duplicate detection. Resets the engine.
+     *
+     * @param backend The structure to map state hash values to nodes with.
+     */
+    void setNodeTableBackend(NodeTableBackend backend);
+
+    /**
+     * Sets the structure used to order the open list. Resets the engine.
+     *
+     * @param type The structure to use.
+     * @param bucket_width The range of values that share a bucket. Ignored unless buckets are used.
+     */
+    void setOpenListType(OpenListType type, double bucket_width = 1.0);
+
+    /**
+     * Sets if the large search arrays should be backed by huge pages. Resets the engine.
+     *
+     * @param use_huge_pages If huge pages should be requested.
+     */
+    void setUseHugePages(bool use_huge_pages);
+
+    /**
+     * Reserves enough memory to store the given number of nodes before any search structure has to grow.
+     *
+     * @param num_nodes The number of nodes to reserve space for.
+     */
+    void reserveNodeStorage(std::size_t num_nodes);
+
+    /**
+     * When using the direct index backend, allocates the memory for all hash values below the given value up front.
+     *
+     * @param hash_range One more than the largest hash value that will be generated.
+     */
+    void reserveHashRange(StateHash hash_range);
+
+    /**
+     * Returns the probe statistics of the hash map used for duplicate detection.
+     *
+     * @return The probe statistics.
+     */
+    const HashTableStats &getNodeTableStats() const;
+
+    /**
+     * Returns the number of unique goal tests.
+     *
+     * @return The number of unique goal tests.
+     */
+    uint64_t getUniqueGoalTests() const;
+
+    /**
+     * Returns the statistics policy, so that its observer hooks can be configured or inspected.
+     *
+     * @return The statistics policy.
+     */
+    stats_t &getStatsPolicy();
+
+protected:
+    // Overloaded functions
+    virtual SearchTermType searchForPlan(const state_t &init_state);
+    virtual void resetStatistics();
+    virtual bool isConfigured() const;
+    virtual void resetEngine();
+
+    /**
+     * Expands a single node and returns the result of the expansion (regarding if a solution as found or not).
+     *
+     * @return The result of the node expansion.
+     */
+    BfsExpansionResult nodeExpansion();
+
+    /**
+     * Computes the heuristic value of the given state without virtual dispatch.
+     *
+     * @param state The state to evaluate.
+     * @return The heuristic value of the state.
+     */
+    double computeHValue(const state_t &state) const;
+
+    /**
+     * Computes the heuristic values of the new children of the node being expanded without virtual dispatch, and
+     * stores them in new_child_h. If the heuristic is incremental, they are computed from the heuristic value of the
+     * parent. Otherwise, they are computed together with a single call to computeHValues.
+     *
+     * @param parent The state being expanded.
+     * @param parent_h The heuristic value of the state being expanded. Ignored if the heuristic is not incremental.
+     */
+    void computeNewChildHValues(const state_t &parent, double parent_h);
+
+    /**
+     * Overloads of computeNewChildHValues for incremental and non-incremental heuristics.
+     */
+    void computeNewChildHValues(const state_t &parent, double parent_h, std::true_type);
+    void computeNewChildHValues(const state_t &parent, double parent_h, std::false_type);
+
+    /**
+     * Extracts the path that ends at the node for the given id and stores it as the incumbent plan.
+     *
+     * @param path_end_id The node at the end of the path.
+     */
+    void extractSolutionPath(NodeID path_end_id);
+
+    const transitions_t *transitions; ///< The transition system.
+    const heuristic_t *heur_func; ///< The heuristic function.
+    const hash_t *hash_func; ///< The hash function.
+    eval_t evaluator; ///< The evaluation policy.
+    bool reopen; ///< If closed nodes should be reopened when a cheaper path to them is found.
+
+    OpenClosedList<state_t, action_t, tie_breaker_t> open_closed_list; ///< The open and closed list.
+
+    stats_t search_stats; ///< The statistics policy.
+    unsigned expansions_since_check; ///< The number of expansions since the limits were last checked.
+
+    uint64_t unique_goal_tests; ///< The number of unique goal tests performed.
+
+    SuccessorBuffer<state_t, action_t> successors; ///< A buffer to store the successors of the node being expanded.
+
+    std::vector<BfsChildInfo> child_info; ///< What is known about each successor of the node being expanded.
+    std::vector<const state_t *> new_child_states; ///< The successors that are new to the search.
+    std::vector<double> new_child_h; ///< The heuristic values of the new successors.
+};
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::StaticBestFirstSearch()
+        : transitions(0), heur_func(0), hash_func(0), reopen(true), expansions_since_check(0),
+                unique_goal_tests(0)
+{
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::~StaticBestFirstSearch()
+{
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setTransitionSystem(const transitions_t* o)
+{
+    transitions = o;
+    Engine::setTransitionSystem(o);
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setHashFunction(const hash_t* hash)
+{
+    hash_func = hash;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setHeuristic(const heuristic_t* heur)
+{
+    heur_func = heur;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setReopen(bool is_reopen)
+{
+    reopen = is_reopen;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline eval_t& StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::getEvaluator()
+{
+    return evaluator;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setTieBreaker(TieBreakType type)
+{
+    open_closed_list.getTieBreaker().setType(type);
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setNodeTableBackend(NodeTableBackend backend)
+{
+    open_closed_list.setNodeTableBackend(backend);
+    resetEngine();
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setOpenListType(OpenListType type, double bucket_width)
+{
+    open_closed_list.setOpenListType(type, bucket_width);
+    resetEngine();
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::setUseHugePages(bool use_huge_pages)
+{
+    open_closed_list.setUseHugePages(use_huge_pages);
+    resetEngine();
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::reserveNodeStorage(std::size_t num_nodes)
+{
+    open_closed_list.reserve(num_nodes);
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::reserveHashRange(StateHash hash_range)
+{
+    open_closed_list.reserveHashRange(hash_range);
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline const HashTableStats& StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::getNodeTableStats() const
+{
+    return open_closed_list.getNodeTableStats();
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline uint64_t StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::getUniqueGoalTests() const
+{
+    return unique_goal_tests;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline stats_t& StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::getStatsPolicy()
+{
+    return search_stats;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+SearchTermType StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::searchForPlan(const state_t& init_state)
+{
+    BfsExpansionResult exp_result = BfsExpansionResult::no_solution;
+
+    double init_h = computeHValue(init_state);
+    if(stats_t::COUNT_OPERATIONS)
+        Engine::incrementHCompCount();
+
+    open_closed_list.addInitialNodeToOpen(init_state, transitions->transitions_t::getDummyAction(),
+            hash_func->hash_t::getStateHash(init_state), init_h, evaluator.getEval(0.0, init_h));
+
+    while(exp_result == BfsExpansionResult::no_solution)
+        exp_result = nodeExpansion();
+
+    if(exp_result == BfsExpansionResult::res_limit)
+        return SearchTermType::res_limit;
+    return SearchTermType::completed;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::resetStatistics()
+{
+    Engine::resetStatistics();
+    unique_goal_tests = 0;
+    expansions_since_check = 0;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+BfsExpansionResult StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::nodeExpansion()
+{
+    if(open_closed_list.isOpenEmpty())
+        return BfsExpansionResult::empty_open;
+
+    if(stats_t::CHECK_LIMITS && !EXACT_LIMITS) {
+        expansions_since_check++;
+        if(expansions_since_check >= stats_t::LIMIT_CHECK_INTERVAL) {
+            expansions_since_check = 0;
+            if(hitGoalTestLimit() || hitSuccFuncLimit() || hitHCompLimit())
+                return BfsExpansionResult::res_limit;
+        }
+    }
+
+    NodeID to_expand_id = open_closed_list.getBestNodeAndClose();
+
+    const state_t &to_expand_state = open_closed_list.getState(to_expand_id);
+    double parent_g = open_closed_list.getGCost(to_expand_id);
+    StateHash parent_hash = open_closed_list.getHashValue(to_expand_id);
+    double parent_h = INCREMENTAL_H ? open_closed_list.getHValue(to_expand_id) : 0.0;
+
+    if(EXACT_LIMITS && hitGoalTestLimit())
+        return BfsExpansionResult::res_limit;
+
+    search_stats.nodeExpanded(to_expand_state, parent_g);
+
+    if(stats_t::COUNT_OPERATIONS) {
+        Engine::incrementGoalTestCount();
+        if(!open_closed_list.isReopened(to_expand_id))
+            unique_goal_tests++;
+    }
+
+    if(goal_test->isGoal(to_expand_state)) {
+        extractSolutionPath(to_expand_id);
+        return BfsExpansionResult::goal_found;
+    }
+
+    if(EXACT_LIMITS && hitSuccFuncLimit())
+        return BfsExpansionResult::res_limit;
+
+    transitions->transitions_t::generateSuccessors(to_expand_state, successors);
+
+    if(stats_t::COUNT_OPERATIONS) {
+        Engine::incrementSuccFuccCalls();
+        Engine::increaseActionGenCount(successors.size());
+    }
+
+    child_info.resize(successors.size());
+    new_child_states.clear();
+
+    // Look up all children first, so that the heuristic values of the new ones can be computed together
+    for(unsigned i = 0; i < successors.size(); i++) {
+        const state_t &child_state = successors[i].state;
+        if(stats_t::COUNT_OPERATIONS)
+            Engine::incrementStateGenCount();
+
+        BfsChildInfo &info = child_info[i];
+        info.hash_value = hash_func->hash_t::getChildStateHash(to_expand_state, parent_hash, child_state);
+        info.location = open_closed_list.getStateLocation(child_state, info.hash_value, info.id);
+        info.new_child_index = -1;
+
+        if(info.location != StateLocation::none)
+            continue;
+
+        // a state generated earlier in this expansion will be in open by the time this child is processed
+        bool generated_earlier = false;
+        for(unsigned j = 0; j < i && !generated_earlier; j++) {
+            generated_earlier = child_info[j].new_child_index >= 0 && child_info[j].hash_value == info.hash_value
+                    && successors[j].state == child_state;
+        }
+        if(!generated_earlier) {
+            info.new_child_index = new_child_states.size();
+            new_child_states.push_back(&child_state);
+        }
+    }
+
+    computeNewChildHValues(to_expand_state, parent_h);
+
+    for(unsigned i = 0; i < successors.size(); i++) {
+
+        double child_g = parent_g + successors[i].cost;
+
+        const state_t &child_state = successors[i].state;
+        BfsChildInfo &info = child_info[i];
+
+        if(info.location == StateLocation::none && info.new_child_index < 0)
+            info.location = open_closed_list.getStateLocation(child_state, info.hash_value, info.id);
+
+        if(info.location == StateLocation::open || info.location == StateLocation::closed) {
+            if(fp_less(child_g, open_closed_list.getGCost(info.id))) {
+                open_closed_list.setNodePath(info.id, to_expand_id, successors[i].action, child_g,
+                        evaluator.getEval(child_g, open_closed_list.getHValue(info.id)));
+
+                if(info.location == StateLocation::open)
+                    open_closed_list.openNodeEvalChanged(info.id);
+                else if(reopen)
+                    open_closed_list.reopenNode(info.id);
+            }
+        } else {
+            if(EXACT_LIMITS && hitHCompLimit())
+                return BfsExpansionResult::res_limit;
+
+            if(stats_t::COUNT_OPERATIONS)
+                Engine::incrementHCompCount();
+            double child_h = new_child_h[info.new_child_index];
+            search_stats.nodeGenerated(child_state, child_g, child_h);
+
+            open_closed_list.addNewNodeToOpen(child_state, successors[i].action, info.hash_value, child_g, child_h,
+                    evaluator.getEval(child_g, child_h), to_expand_id);
+        }
+    }
+
+    return BfsExpansionResult::no_solution;
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline double StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::computeHValue(const state_t& state) const
+{
+    return heur_func->heuristic_t::computeHValue(state);
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::computeNewChildHValues(const state_t& parent, double parent_h)
+{
+    new_child_h.resize(new_child_states.size());
+    if(!new_child_states.empty())
+        computeNewChildHValues(parent, parent_h, std::integral_constant<bool, INCREMENTAL_H>());
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::computeNewChildHValues(const state_t& parent, double parent_h, std::true_type)
+{
+    for(unsigned i = 0; i < successors.size(); i++) {
+        if(child_info[i].new_child_index >= 0) {
+            new_child_h[child_info[i].new_child_index] = heur_func->heuristic_t::computeChildHValue(parent, parent_h,
+                    successors[i].action, successors[i].state);
+        }
+    }
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+inline void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::computeNewChildHValues(const state_t& parent, double parent_h, std::false_type)
+{
+    heur_func->heuristic_t::computeHValues(&new_child_states[0], new_child_states.size(), &new_child_h[0]);
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+bool StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::isConfigured() const
+{
+    if(!transitions || !heur_func || !hash_func)
+        return false;
+    return Engine::isConfigured();
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::resetEngine()
+{
+    open_closed_list.clear();
+    Engine::resetEngine();
+}
+
+template<class state_t, class action_t, class transitions_t, class heuristic_t, class hash_t, class eval_t,
+        class tie_breaker_t, class stats_t>
+void StaticBestFirstSearch<state_t, action_t, transitions_t, heuristic_t, hash_t, eval_t,
+        tie_breaker_t, stats_t>::extractSolutionPath(NodeID path_end_id)
+{
+    incumbent_cost = 0.0;
+    incumbent_plan.clear();
+
+    NodeID id = path_end_id;
+    while(open_closed_list.getGenAction(id) != transitions->transitions_t::getDummyAction()) {
+        incumbent_plan.push_back(open_closed_list.getGenAction(id));
+        id = open_closed_list.getParent(id);
+        incumbent_cost += transitions->transitions_t::getActionCost(open_closed_list.getState(id),
+                incumbent_plan.back());
+    }
+
+    assert(!fp_greater(incumbent_cost, open_closed_list.getGCost(path_end_id)));
+}
+
+#endif /* STATIC_BEST_FIRST_SEARCH_H_ */
@@ -0,0 +1,30 @@
+/*
+ * tie_breaking.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "tie_breaking.h"
+
+ConfigurableTieBreaking::ConfigurableTieBreaking()
+        : tie_break_type(TieBreakType::none)
+{
+}
+
+void ConfigurableTieBreaking::setType(TieBreakType type)
+{
+    tie_break_type = type;
+}
+
+TieBreakType ConfigurableTieBreaking::getType() const
+{
+    return tie_break_type;
+}
+
+bool ConfigurableTieBreaking::prefersHighG() const
+{
+    return tie_break_type != TieBreakType::low_g;
+}
@@ -0,0 +1,199 @@
+/*
+ * tie_breaking.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef TIE_BREAKING_H_
+#define TIE_BREAKING_H_
+
+#include <cstdint>
+
+/**
+ * Policies for ordering open list nodes that have the same evaluation.
+ *
+ * A policy is a class with the following const member functions:
+ *
+ * double getTieKey(double g_cost, double h_value, uint64_t open_order) - returns a key for a node with the given
+ * g-cost, heuristic value, and open order (when it was last added to open or updated), such that among nodes with equal
+ * evaluations, those with lower keys are expanded first.\n
+ * bool prefersHighG() - returns true if the policy favours higher g-costs. Used by the bucket open list, which can only
+ * break ties by g-cost.\n
+ *
+ * The open list stores the key inline in its heap next to the evaluation, so comparisons never need to look at the
+ * nodes themselves.
+ */
+
+/**
+ * Defines the tie-breaking rules available to ConfigurableTieBreaking.
+ *
+ * Below is the meaning of each of the values:
+ *
+ * none - ties are broken arbitrarily by the open list.\n
+ * low_g - ties are broken in favour of nodes with lower g-cost.\n
+ * high_g - ties are broken in favour of nodes with higher g-cost.\n
+ * low_h - ties are broken in favour of nodes with lower heuristic value.\n
+ * lifo - ties are broken in favour of the node most recently added to open or updated.\n
+ *
+ * @class TieBreakType
+ */
+enum class TieBreakType
+{
+    none, low_g, high_g, low_h, lifo
+};
+
+/**
+ * A tie-breaking policy that leaves ties in whatever order the open list puts them in.
+ *
+ * @class NoTieBreaking
+ */
+class NoTieBreaking
+{
+public:
+    double getTieKey(double g_cost, double h_value, uint64_t open_order) const
+    {
+        return 0.0;
+    }
+
+    bool prefersHighG() const
+    {
+        return true;
+    }
+};
+
+/**
+ * A tie-breaking policy that favours nodes with lower g-costs.
+ *
+ * @class LowGTieBreaking
+ */
+class LowGTieBreaking
+{
+public:
+    double getTieKey(double g_cost, double h_value, uint64_t open_order) const
+    {
+        return g_cost;
+    }
+
+    bool prefersHighG() const
+    {
+        return false;
+    }
+};
+
+/**
+ * A tie-breaking policy that favours nodes with higher g-costs.
+ *
+ * @class HighGTieBreaking
+ */
+class HighGTieBreaking
+{
+public:
+    double getTieKey(double g_cost, double h_value, uint64_t open_order) const
+    {
+        return -g_cost;
+    }
+
+    bool prefersHighG() const
+    {
+        return true;
+    }
+};
+
+/**
+ * A tie-breaking policy that favours nodes with lower heuristic values.
+ *
+ * When the evaluation is g + h this is the same as favouring higher g-costs.
+ *
+ * @class LowHTieBreaking
+ */
+class LowHTieBreaking
+{
+public:
+    double getTieKey(double g_cost, double h_value, uint64_t open_order) const
+    {
+        return h_value;
+    }
+
+    bool prefersHighG() const
+    {
+        return true;
+    }
+};
+
+/**
+ * A tie-breaking policy that favours the node most recently added to the open list or updated.
+ *
+ * @class LIFOTieBreaking
+ */
+class LIFOTieBreaking
+{
+public:
+    double getTieKey(double g_cost, double h_value, uint64_t open_order) const
+    {
+        return -(double) open_order;
+    }
+
+    bool prefersHighG() const
+    {
+        return true;
+    }
+};
+
+/**
+ * A tie-breaking policy where the rule to use is chosen at runtime. This is the default policy of the open list.
+ *
+ * Computing each key has to branch on the rule, so a search that always uses the same rule can avoid this by using
+ * the corresponding policy directly.
+ *
+ * @class ConfigurableTieBreaking
+ */
+class ConfigurableTieBreaking
+{
+public:
+    /**
+     * Constructor for the policy. Uses TieBreakType::none.
+     */
+    ConfigurableTieBreaking();
+
+    /**
+     * Sets the rule to use to break ties.
+     *
+     * @param type The rule to use.
+     */
+    void setType(TieBreakType type);
+
+    /**
+     * Returns the rule being used to break ties.
+     *
+     * @return The rule being used.
+     */
+    TieBreakType getType() const;
+
+    double getTieKey(double g_cost, double h_value, uint64_t open_order) const;
+
+    bool prefersHighG() const;
+
+protected:
+    TieBreakType tie_break_type; ///< The rule used to break ties.
+};
+
+inline double ConfigurableTieBreaking::getTieKey(double g_cost, double h_value, uint64_t open_order) const
+{
+    switch(tie_break_type) {
+    case TieBreakType::low_g:
+        return LowGTieBreaking().getTieKey(g_cost, h_value, open_order);
+    case TieBreakType::high_g:
+        return HighGTieBreaking().getTieKey(g_cost, h_value, open_order);
+    case TieBreakType::low_h:
+        return LowHTieBreaking().getTieKey(g_cost, h_value, open_order);
+    case TieBreakType::lifo:
+        return LIFOTieBreaking().getTieKey(g_cost, h_value, open_order);
+    default:
+        return 0.0;
+    }
+}
+
+#endif /* TIE_BREAKING_H_ */
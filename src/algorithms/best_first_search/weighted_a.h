@@ -13,8 +13,8 @@
 #include "best_first_search.h"
 #include "a_star.h"
 
-template<class state_t, class action_t>
-class WeightedAStar: public AStar<state_t, action_t>
+template<class state_t, class action_t, class tie_breaker_t = ConfigurableTieBreaking>
+class WeightedAStar: public AStar<state_t, action_t, tie_breaker_t>
 {
 public:
     WeightedAStar();
@@ -27,18 +27,19 @@ protected:
 
 };
 
-template<class state_t, class action_t>
-inline WeightedAStar<state_t, action_t>::WeightedAStar()
+template<class state_t, class action_t, class tie_breaker_t>
+inline WeightedAStar<state_t, action_t, tie_breaker_t>::WeightedAStar()
 {
 }
 
-template<class state_t, class action_t>
-inline WeightedAStar<state_t, action_t>::~WeightedAStar()
+template<class state_t, class action_t, class tie_breaker_t>
+inline WeightedAStar<state_t, action_t, tie_breaker_t>::~WeightedAStar()
 {
 }
 
-template<class state_t, class action_t>
-inline double WeightedAStar<state_t, action_t>::nodeEval(const state_t& state, double g_cost, double h_cost)
+template<class state_t, class action_t, class tie_breaker_t>
+inline double WeightedAStar<state_t, action_t, tie_breaker_t>::nodeEval(const state_t& state, double g_cost,
+        double h_cost)
 {
 
 	if (weight == -1) {
@@ -49,8 +50,8 @@ inline double WeightedAStar<state_t, action_t>::nodeEval(const state_t& state, d
 	}
 }
 
-template<class state_t, class action_t>
-void WeightedAStar<state_t, action_t>::setWeights(double new_weight)
+template<class state_t, class action_t, class tie_breaker_t>
+void WeightedAStar<state_t, action_t, tie_breaker_t>::setWeights(double new_weight)
 {
     weight = new_weight;
 }
@@ -0,0 +1,623 @@
+/*
+ * contraction_hierarchy.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "contraction_hierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+namespace
+{
+/// The most locations a witness search settles when contracting a location, before giving up and adding a shortcut.
+const unsigned contraction_settle_limit = 500;
+
+/// The most locations a witness search settles when estimating a priority. Only checking for a direct edge between
+/// neighbours is far cheaper than a real search, and gives sparser hierarchies on grid maps.
+const unsigned priority_settle_limit = 1;
+
+/// The weight of the edge difference in the contraction priority, relative to the number of contracted neighbours.
+const int edge_difference_weight = 2;
+
+/// The number of items a thread takes at a time in parallel loops.
+const std::size_t items_per_chunk = 256;
+
+typedef std::pair<double, uint32_t> QueueEntry;
+
+/**
+ * Calls the given function for each index below the given count, splitting the indices between threads. The function
+ * is also given the number of the thread calling it.
+ */
+void parallelFor(unsigned num_threads, std::size_t count, const std::function<void(std::size_t, unsigned)> &func)
+{
+    std::atomic<std::size_t> next_chunk(0);
+    auto run_chunks = [&](unsigned thread) {
+        for(std::size_t start = next_chunk++ * items_per_chunk; start < count;
+                start = next_chunk++ * items_per_chunk) {
+            std::size_t end = std::min(count, start + items_per_chunk);
+            for(std::size_t i = start; i < end; i++)
+                func(i, thread);
+        }
+    };
+
+    vector<std::thread> workers;
+    for(unsigned t = 1; t < num_threads; t++)
+        workers.push_back(std::thread(run_chunks, t));
+    run_chunks(0);
+    for(std::thread &worker : workers)
+        worker.join();
+}
+}
+
+/**
+ * Contracts the locations of a map in order, recording the upward edges of each.
+ *
+ * @class Contractor
+ */
+class ContractionHierarchy::Contractor
+{
+public:
+    /**
+     * A shortcut to add when a location is contracted.
+     */
+    struct Shortcut
+    {
+        uint32_t from; ///< One end of the shortcut.
+        uint32_t to; ///< The other end of the shortcut.
+        double cost; ///< The length of the shortcut.
+    };
+
+    /**
+     * The state of a witness search, kept between searches so that only the locations reached need resetting.
+     */
+    struct WitnessSearch
+    {
+        vector<double> distances; ///< The distance to each location, or -1 if it has not been reached.
+        vector<uint32_t> reached; ///< The locations reached in the current search.
+        vector<QueueEntry> open; ///< The open list, as a min-heap.
+    };
+
+    /**
+     * Sets up the graph of single moves on the given map.
+     */
+    Contractor(const MapPathfindingTransitions &map, unsigned num_threads);
+
+    /**
+     * Contracts every location, setting the rank and upward edges of each.
+     */
+    void contractAll(vector<uint32_t> &ranks, vector<vector<Edge> > &up_lists, std::size_t &num_shortcuts);
+
+protected:
+    /**
+     * Finds the shortcuts needed to contract the given location, using witness searches that settle at most the given
+     * number of locations.
+     */
+    void findShortcuts(uint32_t loc, unsigned settle_limit, WitnessSearch &search, vector<Shortcut> &shortcuts) const;
+
+    /**
+     * Finds the distance from the given location to each location within the given cost, without passing through
+     * the location being contracted.
+     */
+    void runWitnessSearch(uint32_t source, uint32_t avoid, double max_cost, unsigned settle_limit,
+            WitnessSearch &search) const;
+
+    /**
+     * Computes the contraction priority of the given location. Lower priorities are contracted first.
+     */
+    int computePriority(uint32_t loc, WitnessSearch &search) const;
+
+    /**
+     * Checks if the given location has a lower priority than every uncontracted location within two moves of it.
+     */
+    bool isLocalMinimum(uint32_t loc) const;
+
+    /**
+     * Checks if the first location comes before the second in the contraction order.
+     */
+    bool comesBefore(uint32_t loc1, uint32_t loc2) const;
+
+    /**
+     * Adds an edge between the given uncontracted locations, or shortens the existing one.
+     */
+    void addEdge(uint32_t from, uint32_t to, double cost, uint32_t middle);
+
+    unsigned num_threads; ///< The number of threads to use.
+    vector<uint32_t> remaining; ///< The locations not yet contracted.
+    vector<vector<Edge> > edges; ///< The edges between uncontracted locations.
+    vector<int> priorities; ///< The contraction priority of each location.
+    vector<int> contracted_neighbours; ///< The number of neighbours of each location that have been contracted.
+    vector<WitnessSearch> searches; ///< The witness search state of each thread.
+};
+
+ContractionHierarchy::Contractor::Contractor(const MapPathfindingTransitions& map, unsigned num_threads)
+        : num_threads(num_threads)
+{
+    unsigned width = map.getMapWidth();
+    std::size_t num_locations = (std::size_t) width * map.getMapHeight();
+
+    edges.resize(num_locations);
+    priorities.assign(num_locations, 0);
+    contracted_neighbours.assign(num_locations, 0);
+
+    double costs[8];
+    for(unsigned d = 0; d < 8; d++)
+        costs[d] = map.getActionCost(MapLocation(0, 0), (MapDir) d);
+
+    for(uint32_t loc = 0; loc < num_locations; loc++) {
+        if(!map.isCellEmpty(loc % width, loc / width))
+            continue;
+
+        remaining.push_back(loc);
+        uint8_t moves = map.getMoveMask(MapLocation(loc % width, loc / width));
+        for(unsigned d = 0; d < 8; d++) {
+            if(!(moves & (1u << d)))
+                continue;
+
+            Edge edge;
+            edge.target = loc + map_dir_y[d] * (int) width + map_dir_x[d];
+            edge.middle = no_location;
+            edge.cost = costs[d];
+            edges[loc].push_back(edge);
+        }
+    }
+
+    searches.resize(num_threads);
+    for(WitnessSearch &search : searches)
+        search.distances.assign(num_locations, -1.0);
+}
+
+void ContractionHierarchy::Contractor::contractAll(std::vector<uint32_t>& ranks,
+        std::vector<std::vector<Edge> >& up_lists, std::size_t& num_shortcuts)
+{
+    ranks.assign(edges.size(), no_location);
+    up_lists.assign(edges.size(), vector<Edge>());
+    num_shortcuts = 0;
+
+    parallelFor(num_threads, remaining.size(), [&](std::size_t i, unsigned thread) {
+        priorities[remaining[i]] = computePriority(remaining[i], searches[thread]);
+    });
+
+    uint32_t next_rank = 0;
+    vector<uint8_t> selected(edges.size(), 0);
+    vector<uint32_t> batch;
+    vector<vector<Shortcut> > batch_shortcuts;
+    vector<uint32_t> affected;
+    vector<uint8_t> is_affected(edges.size(), 0);
+
+    while(!remaining.empty()) {
+        // Locations that are the lowest within two moves don't share neighbours, so they are contracted together
+        parallelFor(num_threads, remaining.size(), [&](std::size_t i, unsigned thread) {
+            selected[remaining[i]] = isLocalMinimum(remaining[i]) ? 1 : 0;
+        });
+
+        batch.clear();
+        std::size_t num_left = 0;
+        for(uint32_t loc : remaining) {
+            if(selected[loc])
+                batch.push_back(loc);
+            else
+                remaining[num_left++] = loc;
+        }
+        remaining.resize(num_left);
+
+        batch_shortcuts.assign(batch.size(), vector<Shortcut>());
+        parallelFor(num_threads, batch.size(), [&](std::size_t i, unsigned thread) {
+            findShortcuts(batch[i], contraction_settle_limit, searches[thread], batch_shortcuts[i]);
+        });
+
+        affected.clear();
+        for(std::size_t i = 0; i < batch.size(); i++) {
+            uint32_t loc = batch[i];
+            ranks[loc] = next_rank++;
+            up_lists[loc] = edges[loc];
+
+            for(const Edge &edge : edges[loc]) {
+                vector<Edge> &neighbour_edges = edges[edge.target];
+                for(std::size_t e = 0; e < neighbour_edges.size(); e++) {
+                    if(neighbour_edges[e].target == loc) {
+                        neighbour_edges[e] = neighbour_edges.back();
+                        neighbour_edges.pop_back();
+                        break;
+                    }
+                }
+                contracted_neighbours[edge.target]++;
+
+                if(!is_affected[edge.target]) {
+                    is_affected[edge.target] = 1;
+                    affected.push_back(edge.target);
+                }
+            }
+            vector<Edge>().swap(edges[loc]);
+
+            for(const Shortcut &shortcut : batch_shortcuts[i]) {
+                addEdge(shortcut.from, shortcut.to, shortcut.cost, loc);
+                addEdge(shortcut.to, shortcut.from, shortcut.cost, loc);
+            }
+            num_shortcuts += batch_shortcuts[i].size();
+        }
+
+        parallelFor(num_threads, affected.size(), [&](std::size_t i, unsigned thread) {
+            priorities[affected[i]] = computePriority(affected[i], searches[thread]);
+        });
+        for(uint32_t loc : affected)
+            is_affected[loc] = 0;
+    }
+}
+
+void ContractionHierarchy::Contractor::findShortcuts(uint32_t loc, unsigned settle_limit, WitnessSearch& search,
+        std::vector<Shortcut>& shortcuts) const
+{
+    shortcuts.clear();
+    const vector<Edge> &neighbours = edges[loc];
+
+    for(std::size_t i = 0; i + 1 < neighbours.size(); i++) {
+        double max_cost = 0.0;
+        for(std::size_t j = i + 1; j < neighbours.size(); j++)
+            max_cost = std::max(max_cost, neighbours[i].cost + neighbours[j].cost);
+
+        runWitnessSearch(neighbours[i].target, loc, max_cost, settle_limit, search);
+
+        // A shortcut is needed unless another path is at least as short
+        for(std::size_t j = i + 1; j < neighbours.size(); j++) {
+            double via_cost = neighbours[i].cost + neighbours[j].cost;
+            double witness_cost = search.distances[neighbours[j].target];
+            if(witness_cost < 0.0 || witness_cost > via_cost) {
+                Shortcut shortcut;
+                shortcut.from = neighbours[i].target;
+                shortcut.to = neighbours[j].target;
+                shortcut.cost = via_cost;
+                shortcuts.push_back(shortcut);
+            }
+        }
+
+        for(uint32_t reached : search.reached)
+            search.distances[reached] = -1.0;
+        search.reached.clear();
+    }
+}
+
+void ContractionHierarchy::Contractor::runWitnessSearch(uint32_t source, uint32_t avoid, double max_cost,
+        unsigned settle_limit, WitnessSearch& search) const
+{
+    std::greater<QueueEntry> compare;
+    search.open.clear();
+
+    search.distances[source] = 0.0;
+    search.reached.push_back(source);
+    search.open.push_back(QueueEntry(0.0, source));
+
+    unsigned num_settled = 0;
+    while(!search.open.empty() && num_settled < settle_limit) {
+        std::pop_heap(search.open.begin(), search.open.end(), compare);
+        QueueEntry entry = search.open.back();
+        search.open.pop_back();
+
+        if(entry.first > search.distances[entry.second])
+            continue; // stale entry
+        if(entry.first > max_cost)
+            break;
+        num_settled++;
+
+        for(const Edge &edge : edges[entry.second]) {
+            if(edge.target == avoid)
+                continue;
+
+            double next_distance = entry.first + edge.cost;
+            double &distance = search.distances[edge.target];
+            if(distance >= 0.0 && distance <= next_distance)
+                continue;
+
+            if(distance < 0.0)
+                search.reached.push_back(edge.target);
+            distance = next_distance;
+            search.open.push_back(QueueEntry(next_distance, edge.target));
+            std::push_heap(search.open.begin(), search.open.end(), compare);
+        }
+    }
+}
+
+int ContractionHierarchy::Contractor::computePriority(uint32_t loc, WitnessSearch& search) const
+{
+    vector<Shortcut> shortcuts;
+    findShortcuts(loc, priority_settle_limit, search, shortcuts);
+
+    int edge_difference = (int) shortcuts.size() - (int) edges[loc].size();
+    return edge_difference_weight * edge_difference + contracted_neighbours[loc];
+}
+
+bool ContractionHierarchy::Contractor::isLocalMinimum(uint32_t loc) const
+{
+    for(const Edge &edge : edges[loc]) {
+        if(comesBefore(edge.target, loc))
+            return false;
+
+        for(const Edge &next_edge : edges[edge.target]) {
+            if(next_edge.target != loc && comesBefore(next_edge.target, loc))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool ContractionHierarchy::Contractor::comesBefore(uint32_t loc1, uint32_t loc2) const
+{
+    return priorities[loc1] < priorities[loc2] || (priorities[loc1] == priorities[loc2] && loc1 < loc2);
+}
+
+void ContractionHierarchy::Contractor::addEdge(uint32_t from, uint32_t to, double cost, uint32_t middle)
+{
+    for(Edge &edge : edges[from]) {
+        if(edge.target == to) {
+            if(cost < edge.cost) {
+                edge.cost = cost;
+                edge.middle = middle;
+            }
+            return;
+        }
+    }
+
+    Edge edge;
+    edge.target = to;
+    edge.middle = middle;
+    edge.cost = cost;
+    edges[from].push_back(edge);
+}
+
+const uint32_t ContractionHierarchy::no_location;
+
+ContractionHierarchy::ContractionHierarchy()
+        : map_width(0), num_shortcuts(0), query_stamp(0), last_distance(-1.0), settled_count(0)
+{
+}
+
+ContractionHierarchy::~ContractionHierarchy()
+{
+}
+
+bool ContractionHierarchy::build(const MapPathfindingTransitions& map, unsigned num_threads)
+{
+    clear();
+
+    std::size_t num_locations = (std::size_t) map.getMapWidth() * map.getMapHeight();
+    if(num_locations >= no_location) {
+        cerr << "Map is too large to build a contraction hierarchy for." << endl;
+        return false;
+    }
+
+    if(num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    vector<vector<Edge> > up_lists;
+    Contractor contractor(map, num_threads);
+    contractor.contractAll(ranks, up_lists, num_shortcuts);
+
+    up_offsets.resize(num_locations + 1);
+    up_offsets[0] = 0;
+    for(std::size_t loc = 0; loc < num_locations; loc++)
+        up_offsets[loc + 1] = up_offsets[loc] + up_lists[loc].size();
+
+    up_edges.reserve(up_offsets.back());
+    for(vector<Edge> &up_list : up_lists) {
+        up_edges.insert(up_edges.end(), up_list.begin(), up_list.end());
+        vector<Edge>().swap(up_list);
+    }
+
+    map_width = map.getMapWidth();
+    for(QuerySide *side : {&forward, &backward}) {
+        side->distances.resize(num_locations);
+        side->parents.resize(num_locations);
+        side->parent_edges.resize(num_locations);
+        side->stamps.assign(num_locations, 0);
+    }
+    query_stamp = 0;
+    return true;
+}
+
+void ContractionHierarchy::clear()
+{
+    map_width = 0;
+    ranks.clear();
+    up_offsets.clear();
+    up_edges.clear();
+    num_shortcuts = 0;
+
+    for(QuerySide *side : {&forward, &backward}) {
+        side->distances.clear();
+        side->parents.clear();
+        side->parent_edges.clear();
+        side->stamps.clear();
+        side->open.clear();
+    }
+    query_stamp = 0;
+    last_distance = -1.0;
+    settled_count = 0;
+}
+
+bool ContractionHierarchy::isEmpty() const
+{
+    return up_offsets.empty();
+}
+
+double ContractionHierarchy::getDistance(const MapLocation& source, const MapLocation& target)
+{
+    assert(!isEmpty());
+    runQuery(source.y * map_width + source.x, target.y * map_width + target.x);
+    return last_distance;
+}
+
+bool ContractionHierarchy::getPath(const MapLocation& source, const MapLocation& target, std::vector<MapDir>& path)
+{
+    assert(!isEmpty());
+    path.clear();
+
+    uint32_t source_index = source.y * map_width + source.x;
+    uint32_t target_index = target.y * map_width + target.x;
+    uint32_t meeting = runQuery(source_index, target_index);
+    if(meeting == no_location)
+        return false;
+
+    // The forward search gives the edges up to the meeting location in reverse, so they are collected first
+    vector<uint32_t> forward_edges;
+    for(uint32_t loc = meeting; loc != source_index; loc = forward.parents[loc])
+        forward_edges.push_back(forward.parent_edges[loc]);
+
+    uint32_t loc = source_index;
+    for(auto edge = forward_edges.rbegin(); edge != forward_edges.rend(); ++edge) {
+        unpackEdge(loc, up_edges[*edge].target, up_edges[*edge].middle, path);
+        loc = up_edges[*edge].target;
+    }
+
+    for(loc = meeting; loc != target_index; loc = backward.parents[loc])
+        unpackEdge(loc, backward.parents[loc], up_edges[backward.parent_edges[loc]].middle, path);
+
+    return true;
+}
+
+std::size_t ContractionHierarchy::getNumShortcuts() const
+{
+    return num_shortcuts;
+}
+
+uint64_t ContractionHierarchy::getSettledCount() const
+{
+    return settled_count;
+}
+
+uint32_t ContractionHierarchy::runQuery(uint32_t source, uint32_t target)
+{
+    last_distance = -1.0;
+    settled_count = 0;
+    if(ranks[source] == no_location || ranks[target] == no_location)
+        return no_location;
+
+    query_stamp++;
+    if(query_stamp == 0) {
+        std::fill(forward.stamps.begin(), forward.stamps.end(), 0);
+        std::fill(backward.stamps.begin(), backward.stamps.end(), 0);
+        query_stamp = 1;
+    }
+
+    std::greater<QueueEntry> compare;
+    forward.open.clear();
+    backward.open.clear();
+    reach(forward, source, 0.0, no_location, no_location);
+    reach(backward, target, 0.0, no_location, no_location);
+
+    double best = std::numeric_limits<double>::max();
+    uint32_t meeting = no_location;
+    if(source == target) {
+        best = 0.0;
+        meeting = source;
+    }
+
+    // Each side can stop once it can't improve on the best path found, since both only move up the hierarchy
+    while(true) {
+        double forward_min = forward.open.empty() ? best : forward.open.front().first;
+        double backward_min = backward.open.empty() ? best : backward.open.front().first;
+        if(forward_min >= best && backward_min >= best)
+            break;
+
+        QuerySide &side = forward_min <= backward_min ? forward : backward;
+        QuerySide &other = forward_min <= backward_min ? backward : forward;
+
+        std::pop_heap(side.open.begin(), side.open.end(), compare);
+        QueueEntry entry = side.open.back();
+        side.open.pop_back();
+
+        uint32_t loc = entry.second;
+        if(entry.first > side.distances[loc])
+            continue; // stale entry
+        settled_count++;
+
+        for(uint32_t e = up_offsets[loc]; e < up_offsets[loc + 1]; e++) {
+            uint32_t next = up_edges[e].target;
+            double next_distance = entry.first + up_edges[e].cost;
+            if(isReached(side, next) && side.distances[next] <= next_distance)
+                continue;
+
+            reach(side, next, next_distance, loc, e);
+            if(isReached(other, next) && next_distance + other.distances[next] < best) {
+                best = next_distance + other.distances[next];
+                meeting = next;
+            }
+        }
+    }
+
+    if(meeting != no_location)
+        last_distance = best;
+    return meeting;
+}
+
+bool ContractionHierarchy::isReached(const QuerySide& side, uint32_t loc) const
+{
+    return side.stamps[loc] == query_stamp;
+}
+
+void ContractionHierarchy::reach(QuerySide& side, uint32_t loc, double distance, uint32_t parent, uint32_t edge)
+{
+    side.stamps[loc] = query_stamp;
+    side.distances[loc] = distance;
+    side.parents[loc] = parent;
+    side.parent_edges[loc] = edge;
+    side.open.push_back(QueueEntry(distance, loc));
+    std::push_heap(side.open.begin(), side.open.end(), std::greater<QueueEntry>());
+}
+
+void ContractionHierarchy::unpackEdge(uint32_t from, uint32_t to, uint32_t middle, std::vector<MapDir>& path) const
+{
+    // Each shortcut is replaced by the two edges from the location it skips, which were recorded when that location
+    // was contracted. The stack holds the edges still to unpack, last one first.
+    vector<Edge> stack;
+    Edge edge;
+    edge.target = to;
+    edge.middle = middle;
+    edge.cost = 0.0;
+    stack.push_back(edge);
+
+    while(!stack.empty()) {
+        Edge current = stack.back();
+        stack.pop_back();
+
+        if(current.middle == no_location) {
+            int dx = (int) (current.target % map_width) - (int) (from % map_width);
+            int dy = (int) (current.target / map_width) - (int) (from / map_width);
+            for(unsigned d = 0; d < 8; d++) {
+                if(map_dir_x[d] == dx && map_dir_y[d] == dy) {
+                    path.push_back((MapDir) d);
+                    break;
+                }
+            }
+            from = current.target;
+            continue;
+        }
+
+        Edge first_half, second_half;
+        first_half.target = current.middle;
+        first_half.middle = no_location;
+        second_half.target = current.target;
+        second_half.middle = no_location;
+        for(uint32_t e = up_offsets[current.middle]; e < up_offsets[current.middle + 1]; e++) {
+            if(up_edges[e].target == from)
+                first_half.middle = up_edges[e].middle;
+            else if(up_edges[e].target == current.target)
+                second_half.middle = up_edges[e].middle;
+        }
+
+        stack.push_back(second_half);
+        stack.push_back(first_half);
+    }
+}
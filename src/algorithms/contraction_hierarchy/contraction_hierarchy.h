@@ -0,0 +1,193 @@
+/*
+ * contraction_hierarchy.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef CONTRACTION_HIERARCHY_H_
+#define CONTRACTION_HIERARCHY_H_
+
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * A contraction hierarchy (CH) over the empty locations of a static map, for answering shortest path queries without
+ * searching the whole map.
+ *
+ * Locations are contracted one at a time: a location is removed from the graph, and a shortcut edge is added between
+ * each pair of its neighbours whose shortest path went through it. The order is chosen greedily by a weighted sum of
+ * the edge difference (the number of shortcuts added minus the number of edges removed) and the number of neighbours
+ * already contracted, which keeps the contraction spread evenly over the map. To preprocess in parallel, each round contracts
+ * every location whose priority is the lowest within two moves, since the shortcuts of such locations can't depend on
+ * each other.
+ *
+ * A query is a bidirectional Dijkstra search that only follows edges to locations contracted later, which meets at
+ * the latest contracted location on a shortest path. Each shortcut remembers the location it skips, so the path is
+ * unpacked back into single moves.
+ *
+ * The hierarchy depends on the connectivity and diagonal cost of the map, so it must be rebuilt if these or the map
+ * change. Queries reuse buffers held by the hierarchy, so only one query can run at a time.
+ *
+ * @class ContractionHierarchy
+ */
+class ContractionHierarchy
+{
+public:
+    /**
+     * Constructs an empty hierarchy.
+     */
+    ContractionHierarchy();
+
+    /**
+     * Destructor for the hierarchy. Does nothing.
+     */
+    ~ContractionHierarchy();
+
+    /**
+     * Builds the hierarchy for the given map, using its current connectivity and diagonal cost.
+     *
+     * @param map The map.
+     * @param num_threads The number of threads to use. If 0, uses as many as the hardware supports.
+     * @return If the hierarchy was built.
+     */
+    bool build(const MapPathfindingTransitions &map, unsigned num_threads = 0);
+
+    /**
+     * Empties the hierarchy.
+     */
+    void clear();
+
+    /**
+     * Checks if the hierarchy has been built.
+     *
+     * @return If the hierarchy is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns the length of a shortest path between the given locations.
+     *
+     * @param source The location to move from. Must be on the map.
+     * @param target The location to move to. Must be on the map.
+     * @return The length of the path, or -1 if there is none.
+     */
+    double getDistance(const MapLocation &source, const MapLocation &target);
+
+    /**
+     * Finds a shortest path between the given locations.
+     *
+     * Unlike the plans returned by search engines, the moves are listed from the source to the target.
+     *
+     * @param source The location to move from. Must be on the map.
+     * @param target The location to move to. Must be on the map.
+     * @param path Set as the moves of the path.
+     * @return If there is a path between the locations.
+     */
+    bool getPath(const MapLocation &source, const MapLocation &target, std::vector<MapDir> &path);
+
+    /**
+     * Returns the number of shortcuts added while building.
+     *
+     * @return The number of shortcuts.
+     */
+    std::size_t getNumShortcuts() const;
+
+    /**
+     * Returns the number of locations settled by the last query, counting both directions.
+     *
+     * @return The number of locations settled.
+     */
+    uint64_t getSettledCount() const;
+
+protected:
+    /**
+     * An edge of the hierarchy, which is either a single move or a shortcut.
+     *
+     * @class Edge
+     */
+    struct Edge
+    {
+        uint32_t target; ///< The location the edge leads to.
+        uint32_t middle; ///< The location a shortcut skips, or no_location for a single move.
+        double cost; ///< The length of the edge.
+    };
+
+    /**
+     * The state of a search in one direction of a query.
+     *
+     * @class QuerySide
+     */
+    struct QuerySide
+    {
+        std::vector<double> distances; ///< The distance to each location reached.
+        std::vector<uint32_t> parents; ///< The location each location was reached from.
+        std::vector<uint32_t> parent_edges; ///< The index of the edge each location was reached by.
+        std::vector<uint32_t> stamps; ///< The query each location was last reached in.
+        std::vector<std::pair<double, uint32_t> > open; ///< The open list, as a min-heap.
+    };
+
+    class Contractor;
+
+    /**
+     * Runs a query between the given locations.
+     *
+     * @param source The index of the location to move from.
+     * @param target The index of the location to move to.
+     * @return The location the searches met at on a shortest path, or no_location if there is none.
+     */
+    uint32_t runQuery(uint32_t source, uint32_t target);
+
+    /**
+     * Checks if the given side of the current query has reached the given location.
+     *
+     * @param side The side of the query.
+     * @param loc The location.
+     * @return If the location was reached.
+     */
+    bool isReached(const QuerySide &side, uint32_t loc) const;
+
+    /**
+     * Marks the given location as reached by the given side of the current query.
+     *
+     * @param side The side of the query.
+     * @param loc The location.
+     * @param distance The distance to the location.
+     * @param parent The location it was reached from.
+     * @param edge The index of the edge it was reached by.
+     */
+    void reach(QuerySide &side, uint32_t loc, double distance, uint32_t parent, uint32_t edge);
+
+    /**
+     * Adds the single moves that make up the edge between the given locations to the end of the path.
+     *
+     * @param from The location the edge starts at.
+     * @param to The location the edge ends at.
+     * @param middle The location skipped by the edge, or no_location if it is a single move.
+     * @param path The path to add to.
+     */
+    void unpackEdge(uint32_t from, uint32_t to, uint32_t middle, std::vector<MapDir> &path) const;
+
+    static const uint32_t no_location = UINT32_MAX; ///< Marks the lack of a location.
+
+    unsigned map_width; ///< The width of the map.
+
+    std::vector<uint32_t> ranks; ///< The position of each location in the contraction order, or no_location.
+    std::vector<uint32_t> up_offsets; ///< The upward edges of location i start at up_offsets[i].
+    std::vector<Edge> up_edges; ///< The edges from each location to the neighbours it had when it was contracted.
+    std::size_t num_shortcuts; ///< The number of shortcuts added while building.
+
+    QuerySide forward; ///< The search from the source.
+    QuerySide backward; ///< The search from the target.
+    uint32_t query_stamp; ///< Identifies the current query.
+    double last_distance; ///< The length of the path found by the last query.
+    uint64_t settled_count; ///< The number of locations settled by the last query.
+};
+
+#endif /* CONTRACTION_HIERARCHY_H_ */
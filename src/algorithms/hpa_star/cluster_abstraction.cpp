@@ -0,0 +1,389 @@
+/*
+ * cluster_abstraction.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "cluster_abstraction.h"
+#include "../../utils/floating_point_utils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iostream>
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+namespace
+{
+/// Runs of at least this many locations get a transition at each end instead of one in the middle.
+const unsigned long_run_length = 6;
+}
+
+const uint32_t ClusterAbstraction::no_entrance;
+
+ClusterAbstraction::ClusterAbstraction()
+        : map_ops(0), cluster_size(0), map_width(0), map_height(0), eight_connected(false), diagonal_cost(0.0),
+                clusters_x(0), clusters_y(0), search_cluster(0)
+{
+}
+
+ClusterAbstraction::~ClusterAbstraction()
+{
+}
+
+bool ClusterAbstraction::build(const MapPathfindingTransitions& map, unsigned size)
+{
+    clear();
+
+    if(size < 2) {
+        cerr << "Clusters must be at least 2 locations wide." << endl;
+        return false;
+    }
+    if(map.getMapWidth() == 0 || map.getMapHeight() == 0) {
+        cerr << "Cannot build an abstraction of an empty map." << endl;
+        return false;
+    }
+
+    map_ops = &map;
+    cluster_size = size;
+    map_width = map.getMapWidth();
+    map_height = map.getMapHeight();
+    eight_connected = map.is8Connected();
+    diagonal_cost = map.getActionCost(MapLocation(0, 0), MapDir::northeast);
+
+    clusters_x = (map_width + size - 1) / size;
+    clusters_y = (map_height + size - 1) / size;
+    clusters.resize(clusters_x * clusters_y);
+    for(unsigned cy = 0; cy < clusters_y; cy++) {
+        for(unsigned cx = 0; cx < clusters_x; cx++) {
+            Cluster &cluster = clusters[cy * clusters_x + cx];
+            cluster.min_x = cx * size;
+            cluster.min_y = cy * size;
+            cluster.width = std::min(size, map_width - cluster.min_x);
+            cluster.height = std::min(size, map_height - cluster.min_y);
+        }
+    }
+
+    entrance_indices.assign((std::size_t) map_width * map_height, no_entrance);
+    search_distances.resize(size * size);
+    search_moves.resize(size * size);
+
+    for(unsigned i = 0; i < clusters.size(); i++)
+        buildCluster(i);
+    return true;
+}
+
+void ClusterAbstraction::updateCells(const std::vector<MapLocation>& changed)
+{
+    // A location affects the moves of its neighbours, which may be in other clusters
+    vector<unsigned> affected;
+    for(const MapLocation &loc : changed) {
+        for(int y = (int) loc.y - 1; y <= (int) loc.y + 1; y++) {
+            for(int x = (int) loc.x - 1; x <= (int) loc.x + 1; x++) {
+                if(x >= 0 && y >= 0 && x < (int) map_width && y < (int) map_height)
+                    affected.push_back(getClusterIndex(MapLocation(x, y)));
+            }
+        }
+    }
+
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+    for(unsigned cluster : affected)
+        buildCluster(cluster);
+}
+
+void ClusterAbstraction::clear()
+{
+    map_ops = 0;
+    cluster_size = 0;
+    map_width = 0;
+    map_height = 0;
+    clusters_x = 0;
+    clusters_y = 0;
+    clusters.clear();
+    entrance_indices.clear();
+    search_distances.clear();
+    search_moves.clear();
+    search_open.clear();
+}
+
+bool ClusterAbstraction::isEmpty() const
+{
+    return clusters.empty();
+}
+
+bool ClusterAbstraction::fitsMap(const MapPathfindingTransitions& map) const
+{
+    if(map.getMapWidth() != map_width || map.getMapHeight() != map_height || map.is8Connected() != eight_connected)
+        return false;
+    return !eight_connected || fp_equal(map.getActionCost(MapLocation(0, 0), MapDir::northeast), diagonal_cost);
+}
+
+unsigned ClusterAbstraction::getClusterIndex(const MapLocation& loc) const
+{
+    assert(loc.x < map_width && loc.y < map_height);
+    return (loc.y / cluster_size) * clusters_x + loc.x / cluster_size;
+}
+
+uint32_t ClusterAbstraction::getEntranceIndex(const MapLocation& loc) const
+{
+    assert(loc.x < map_width && loc.y < map_height);
+    return entrance_indices[loc.y * map_width + loc.x];
+}
+
+unsigned ClusterAbstraction::getNumEntrances(unsigned cluster) const
+{
+    return clusters[cluster].entrances.size();
+}
+
+const MapLocation& ClusterAbstraction::getEntrance(unsigned cluster, unsigned entrance) const
+{
+    return clusters[cluster].entrances[entrance];
+}
+
+uint8_t ClusterAbstraction::getTransitionDirs(unsigned cluster, unsigned entrance) const
+{
+    return clusters[cluster].transition_dirs[entrance];
+}
+
+double ClusterAbstraction::getIntraDistance(unsigned cluster, unsigned from, unsigned to) const
+{
+    const Cluster &c = clusters[cluster];
+    return c.distances[from * c.entrances.size() + to];
+}
+
+double ClusterAbstraction::findEntranceDistances(const MapLocation& source, const MapLocation& target,
+        std::vector<double>& distances)
+{
+    searchCluster(source);
+
+    const Cluster &cluster = clusters[search_cluster];
+    distances.resize(cluster.entrances.size());
+    for(unsigned i = 0; i < cluster.entrances.size(); i++)
+        distances[i] = getSearchedDistance(cluster.entrances[i]);
+    return getSearchedDistance(target);
+}
+
+bool ClusterAbstraction::refineSegment(const MapLocation& from, const MapLocation& to, std::vector<MapDir>& moves)
+{
+    if(from == to)
+        return true;
+
+    unsigned cluster = getClusterIndex(from);
+    if(cluster != getClusterIndex(to)) {
+        // a transition, which is a single cardinal move
+        for(unsigned d = 0; d < 8; d += 2) {
+            if(from.x + map_dir_x[d] == to.x && from.y + map_dir_y[d] == to.y
+                    && (map_ops->getMoveMask(from) & MapPathfindingTransitions::getDirBit((MapDir) d))) {
+                moves.push_back((MapDir) d);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t from_entrance = getEntranceIndex(from);
+    uint32_t to_entrance = getEntranceIndex(to);
+    if(from_entrance == no_entrance || to_entrance == no_entrance) {
+        searchCluster(from);
+        if(getSearchedDistance(to) < 0.0)
+            return false;
+        addSearchedPath(to, moves);
+        return true;
+    }
+
+    Cluster &c = clusters[cluster];
+    if(c.distances[from_entrance * c.entrances.size() + to_entrance] < 0.0)
+        return false;
+
+    uint64_t key = ((uint64_t) from_entrance << 32) | to_entrance;
+    auto cached = c.path_cache.find(key);
+    if(cached == c.path_cache.end()) {
+        searchCluster(from);
+        cached = c.path_cache.insert(std::make_pair(key, vector<MapDir>())).first;
+        addSearchedPath(to, cached->second);
+    }
+    moves.insert(moves.end(), cached->second.begin(), cached->second.end());
+    return true;
+}
+
+std::size_t ClusterAbstraction::getNumEntrances() const
+{
+    std::size_t num_entrances = 0;
+    for(const Cluster &cluster : clusters)
+        num_entrances += cluster.entrances.size();
+    return num_entrances;
+}
+
+std::size_t ClusterAbstraction::getNumCachedPaths() const
+{
+    std::size_t num_paths = 0;
+    for(const Cluster &cluster : clusters)
+        num_paths += cluster.path_cache.size();
+    return num_paths;
+}
+
+void ClusterAbstraction::buildCluster(unsigned cluster)
+{
+    Cluster &c = clusters[cluster];
+    for(const MapLocation &loc : c.entrances)
+        entrance_indices[loc.y * map_width + loc.x] = no_entrance;
+    c.entrances.clear();
+    c.transition_dirs.clear();
+    c.path_cache.clear();
+
+    addBorderEntrances(cluster, MapDir::north);
+    addBorderEntrances(cluster, MapDir::east);
+    addBorderEntrances(cluster, MapDir::south);
+    addBorderEntrances(cluster, MapDir::west);
+
+    unsigned num_entrances = c.entrances.size();
+    c.distances.assign(num_entrances * num_entrances, -1.0);
+    for(unsigned i = 0; i < num_entrances; i++) {
+        searchCluster(c.entrances[i]);
+        for(unsigned j = 0; j < num_entrances; j++)
+            c.distances[i * num_entrances + j] = getSearchedDistance(c.entrances[j]);
+    }
+}
+
+void ClusterAbstraction::addBorderEntrances(unsigned cluster, MapDir side)
+{
+    Cluster &c = clusters[cluster];
+    unsigned side_index = (unsigned) side;
+
+    // The border is walked in increasing coordinate order from both of its sides, so both clusters on it place the
+    // same transitions
+    MapLocation start;
+    unsigned length;
+    int step_x, step_y;
+    if(map_dir_x[side_index] == 0) {
+        start.x = c.min_x;
+        start.y = map_dir_y[side_index] < 0 ? c.min_y : c.min_y + c.height - 1;
+        length = c.width;
+        step_x = 1;
+        step_y = 0;
+    } else {
+        start.x = map_dir_x[side_index] < 0 ? c.min_x : c.min_x + c.width - 1;
+        start.y = c.min_y;
+        length = c.height;
+        step_x = 0;
+        step_y = 1;
+    }
+
+    int outside_x = start.x + map_dir_x[side_index];
+    int outside_y = start.y + map_dir_y[side_index];
+    if(outside_x < 0 || outside_y < 0 || outside_x >= (int) map_width || outside_y >= (int) map_height)
+        return;
+
+    unsigned run_start = 0;
+    unsigned run_length = 0;
+    for(unsigned i = 0; i <= length; i++) {
+        int x = start.x + i * step_x;
+        int y = start.y + i * step_y;
+        if(i < length && map_ops->isCellEmpty(x, y)
+                && map_ops->isCellEmpty(x + map_dir_x[side_index], y + map_dir_y[side_index])) {
+            if(run_length == 0)
+                run_start = i;
+            run_length++;
+            continue;
+        }
+        if(run_length == 0)
+            continue;
+
+        unsigned picks[2] = {run_start + (run_length - 1) / 2, run_start + (run_length - 1) / 2};
+        if(run_length >= long_run_length) {
+            picks[0] = run_start;
+            picks[1] = run_start + run_length - 1;
+        }
+
+        for(unsigned pick : picks) {
+            MapLocation loc(start.x + pick * step_x, start.y + pick * step_y);
+            uint32_t &index = entrance_indices[loc.y * map_width + loc.x];
+            if(index == no_entrance) {
+                index = c.entrances.size();
+                c.entrances.push_back(loc);
+                c.transition_dirs.push_back(0);
+            }
+            c.transition_dirs[index] |= MapPathfindingTransitions::getDirBit(side);
+        }
+        run_length = 0;
+    }
+}
+
+void ClusterAbstraction::searchCluster(const MapLocation& source)
+{
+    search_cluster = getClusterIndex(source);
+    const Cluster &c = clusters[search_cluster];
+    std::fill(search_distances.begin(), search_distances.begin() + c.width * c.height, -1.0);
+
+    typedef std::pair<double, uint32_t> OpenEntry;
+    std::greater<OpenEntry> heap_order;
+
+    uint32_t source_index = (source.y - c.min_y) * c.width + source.x - c.min_x;
+    search_distances[source_index] = 0.0;
+    search_moves[source_index] = MapDir::dummy;
+    search_open.clear();
+    search_open.push_back(OpenEntry(0.0, source_index));
+
+    while(!search_open.empty()) {
+        std::pop_heap(search_open.begin(), search_open.end(), heap_order);
+        OpenEntry best = search_open.back();
+        search_open.pop_back();
+        if(fp_greater(best.first, search_distances[best.second]))
+            continue;
+
+        MapLocation loc(c.min_x + best.second % c.width, c.min_y + best.second / c.width);
+        uint8_t mask = map_ops->getMoveMask(loc);
+        for(unsigned d = 0; d < 8; d++) {
+            if(!(mask & (1 << d)))
+                continue;
+
+            unsigned x = loc.x + map_dir_x[d];
+            unsigned y = loc.y + map_dir_y[d];
+            if(x < c.min_x || y < c.min_y || x >= c.min_x + c.width || y >= c.min_y + c.height)
+                continue;
+
+            uint32_t index = (y - c.min_y) * c.width + x - c.min_x;
+            double distance = best.first + map_ops->getActionCost(loc, (MapDir) d);
+            if(search_distances[index] < 0.0 || fp_less(distance, search_distances[index])) {
+                search_distances[index] = distance;
+                search_moves[index] = (MapDir) d;
+                search_open.push_back(OpenEntry(distance, index));
+                std::push_heap(search_open.begin(), search_open.end(), heap_order);
+            }
+        }
+    }
+}
+
+void ClusterAbstraction::addSearchedPath(const MapLocation& target, std::vector<MapDir>& moves) const
+{
+    const Cluster &c = clusters[search_cluster];
+    std::size_t first_move = moves.size();
+
+    unsigned x = target.x;
+    unsigned y = target.y;
+    while(true) {
+        MapDir dir = search_moves[(y - c.min_y) * c.width + x - c.min_x];
+        if(dir == MapDir::dummy)
+            break;
+
+        moves.push_back(dir);
+        x -= map_dir_x[(unsigned) dir];
+        y -= map_dir_y[(unsigned) dir];
+    }
+    std::reverse(moves.begin() + first_move, moves.end());
+}
+
+double ClusterAbstraction::getSearchedDistance(const MapLocation& loc) const
+{
+    const Cluster &c = clusters[search_cluster];
+    if(loc.x < c.min_x || loc.y < c.min_y || loc.x >= c.min_x + c.width || loc.y >= c.min_y + c.height)
+        return -1.0;
+    return search_distances[(loc.y - c.min_y) * c.width + loc.x - c.min_x];
+}
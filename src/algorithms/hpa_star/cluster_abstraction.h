@@ -0,0 +1,262 @@
+/*
+ * cluster_abstraction.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef CLUSTER_ABSTRACTION_H_
+#define CLUSTER_ABSTRACTION_H_
+
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * The abstraction of a map used by HPA* (see HpaStar).
+ *
+ * The map is split into square clusters. Along each border between two clusters, the pairs of empty locations facing
+ * each other across the border are split into maximal runs. Each run gets one transition in its middle, or one at
+ * each end if it is long, and the locations on both sides of a transition are entrances of their clusters. The
+ * abstract graph has an edge for each transition, with the cost of the single move across it, and an edge between
+ * each pair of entrances of a cluster that are connected within it, with the cost of the shortest path that stays in
+ * the cluster. Diagonal moves across a border are not needed, since they can't cut corners and so can always be
+ * replaced by two moves across a transition run.
+ *
+ * Paths within a cluster are found again when a path through the abstract graph is refined, and those between
+ * entrances are cached. If locations of the map change, updateCells rebuilds only the clusters they touch.
+ *
+ * The abstraction depends on the connectivity and diagonal cost of the map, so it must be rebuilt if these change.
+ * The searches within clusters reuse buffers held by the abstraction, so only one query can use it at a time.
+ *
+ * @class ClusterAbstraction
+ */
+class ClusterAbstraction
+{
+public:
+    /**
+     * Constructs an empty abstraction.
+     */
+    ClusterAbstraction();
+
+    /**
+     * Destructor for the abstraction. Does nothing.
+     */
+    ~ClusterAbstraction();
+
+    /**
+     * Builds the abstraction for the given map, using its current connectivity and diagonal cost. The map is kept to
+     * search within clusters, so it must outlive the abstraction.
+     *
+     * @param map The map.
+     * @param size The width and height of the clusters. Must be at least 2.
+     * @return If the abstraction was built.
+     */
+    bool build(const MapPathfindingTransitions &map, unsigned size = 16);
+
+    /**
+     * Rebuilds the clusters affected by changes to the given locations, which must already have been made to the map
+     * the abstraction was built for.
+     *
+     * @param changed The locations that changed.
+     */
+    void updateCells(const std::vector<MapLocation> &changed);
+
+    /**
+     * Empties the abstraction.
+     */
+    void clear();
+
+    /**
+     * Checks if the abstraction has been built.
+     *
+     * @return If the abstraction is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Checks if the abstraction was built for a map with the same size, connectivity and diagonal cost as the given
+     * map.
+     *
+     * @param map The map.
+     * @return If the abstraction fits the map.
+     */
+    bool fitsMap(const MapPathfindingTransitions &map) const;
+
+    /**
+     * Returns the index of the cluster that contains the given location.
+     *
+     * @param loc The location. Must be on the map.
+     * @return The index of the cluster.
+     */
+    unsigned getClusterIndex(const MapLocation &loc) const;
+
+    /**
+     * Returns the index of the given location among the entrances of its cluster.
+     *
+     * @param loc The location. Must be on the map.
+     * @return The index of the entrance, or no_entrance if the location is not an entrance.
+     */
+    uint32_t getEntranceIndex(const MapLocation &loc) const;
+
+    /**
+     * Returns the number of entrances of the given cluster.
+     *
+     * @param cluster The index of the cluster.
+     * @return The number of entrances.
+     */
+    unsigned getNumEntrances(unsigned cluster) const;
+
+    /**
+     * Returns the location of the given entrance.
+     *
+     * @param cluster The index of the cluster.
+     * @param entrance The index of the entrance in the cluster.
+     * @return The location of the entrance.
+     */
+    const MapLocation &getEntrance(unsigned cluster, unsigned entrance) const;
+
+    /**
+     * Returns the directions of the transitions from the given entrance to other clusters.
+     *
+     * @param cluster The index of the cluster.
+     * @param entrance The index of the entrance in the cluster.
+     * @return A move mask with a bit set for the direction of each transition.
+     */
+    uint8_t getTransitionDirs(unsigned cluster, unsigned entrance) const;
+
+    /**
+     * Returns the length of a shortest path between two entrances of a cluster that stays in the cluster.
+     *
+     * @param cluster The index of the cluster.
+     * @param from The index of the entrance to move from.
+     * @param to The index of the entrance to move to.
+     * @return The length of the path, or -1 if there is none.
+     */
+    double getIntraDistance(unsigned cluster, unsigned from, unsigned to) const;
+
+    /**
+     * Finds the lengths of the shortest paths from the given location to each entrance of its cluster and to a target,
+     * staying in the cluster.
+     *
+     * @param source The location to move from.
+     * @param target The target location, which need not be in the cluster.
+     * @param distances Set as the length of the path to each entrance, or -1 if there is none.
+     * @return The length of the path to the target, or -1 if there is none.
+     */
+    double findEntranceDistances(const MapLocation &source, const MapLocation &target,
+            std::vector<double> &distances);
+
+    /**
+     * Finds a path between two locations that are in the same cluster, or on either side of a transition, and adds its
+     * moves to the end of the given list. A path between two locations in a cluster is a shortest path that stays in
+     * the cluster.
+     *
+     * @param from The location to move from.
+     * @param to The location to move to.
+     * @param moves The list of moves to add to.
+     * @return If there is such a path.
+     */
+    bool refineSegment(const MapLocation &from, const MapLocation &to, std::vector<MapDir> &moves);
+
+    /**
+     * Returns the number of entrances in all clusters.
+     *
+     * @return The number of entrances.
+     */
+    std::size_t getNumEntrances() const;
+
+    /**
+     * Returns the number of paths between entrances that have been cached.
+     *
+     * @return The number of cached paths.
+     */
+    std::size_t getNumCachedPaths() const;
+
+    static const uint32_t no_entrance = UINT32_MAX; ///< Marks a location that is not an entrance.
+
+protected:
+    /**
+     * A cluster of the map.
+     *
+     * @class Cluster
+     */
+    struct Cluster
+    {
+        unsigned min_x; ///< The smallest x coordinate in the cluster.
+        unsigned min_y; ///< The smallest y coordinate in the cluster.
+        unsigned width; ///< The width of the cluster.
+        unsigned height; ///< The height of the cluster.
+
+        std::vector<MapLocation> entrances; ///< The location of each entrance.
+        std::vector<uint8_t> transition_dirs; ///< The directions of the transitions from each entrance.
+        std::vector<double> distances; ///< The distance from entrance i to j is at i * entrances.size() + j.
+
+        /// Cached paths between entrances, keyed by the indices of their ends.
+        std::unordered_map<uint64_t, std::vector<MapDir> > path_cache;
+    };
+
+    /**
+     * Finds the entrances of the given cluster and the distances between them.
+     *
+     * @param cluster The index of the cluster.
+     */
+    void buildCluster(unsigned cluster);
+
+    /**
+     * Adds the entrances of the given cluster on the border with its neighbour in the given direction.
+     *
+     * @param cluster The index of the cluster.
+     * @param side The direction of the border. Must be a cardinal direction.
+     */
+    void addBorderEntrances(unsigned cluster, MapDir side);
+
+    /**
+     * Finds the shortest paths from the given location to every other location in its cluster that stay in the
+     * cluster. The results are left in search_distances and search_moves.
+     *
+     * @param source The location to move from.
+     */
+    void searchCluster(const MapLocation &source);
+
+    /**
+     * Adds the moves of the path to the given location found by the last searchCluster call to the end of the list.
+     *
+     * @param target The location to move to. Must have been reached.
+     * @param moves The list of moves to add to.
+     */
+    void addSearchedPath(const MapLocation &target, std::vector<MapDir> &moves) const;
+
+    /**
+     * Returns the distance to the given location found by the last searchCluster call.
+     *
+     * @param loc The location.
+     * @return The distance, or -1 if it was not reached or is outside of the cluster.
+     */
+    double getSearchedDistance(const MapLocation &loc) const;
+
+    const MapPathfindingTransitions *map_ops; ///< The map the abstraction was built for.
+    unsigned cluster_size; ///< The width and height of the clusters.
+    unsigned map_width; ///< The width of the map.
+    unsigned map_height; ///< The height of the map.
+    bool eight_connected; ///< If the map was 8-connected when built.
+    double diagonal_cost; ///< The cost of diagonal moves when built.
+
+    unsigned clusters_x; ///< The number of clusters in each row.
+    unsigned clusters_y; ///< The number of clusters in each column.
+    std::vector<Cluster> clusters; ///< The clusters, row by row.
+    std::vector<uint32_t> entrance_indices; ///< The index of each location among the entrances of its cluster.
+
+    unsigned search_cluster; ///< The cluster of the last searchCluster call.
+    std::vector<double> search_distances; ///< The distance to each location of the cluster, or -1.
+    std::vector<MapDir> search_moves; ///< The last move of the path to each location of the cluster.
+    std::vector<std::pair<double, uint32_t> > search_open; ///< The open list of the search, as a min-heap.
+};
+
+#endif /* CLUSTER_ABSTRACTION_H_ */
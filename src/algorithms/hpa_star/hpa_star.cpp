@@ -0,0 +1,277 @@
+/*
+ * hpa_star.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "hpa_star.h"
+
+#include <algorithm>
+
+namespace
+{
+/**
+ * Returns the direction from one location towards another. This is only used to label abstract edges, since the
+ * generating action of a node must not be the dummy action.
+ */
+MapDir getEdgeDir(const MapLocation &from, const MapLocation &to)
+{
+    if(to.x == from.x)
+        return to.y < from.y ? MapDir::north : MapDir::south;
+    if(to.y == from.y)
+        return to.x < from.x ? MapDir::west : MapDir::east;
+    if(to.x > from.x)
+        return to.y < from.y ? MapDir::northeast : MapDir::southeast;
+    return to.y < from.y ? MapDir::northwest : MapDir::southwest;
+}
+}
+
+HpaStar::HpaStar()
+        : map_ops(0), single_goal(0), heur_func(0), abstraction(0), goal_cluster(0), goal_is_entrance(false),
+                map_width(0), unique_goal_tests(0)
+{
+    // Cell indices are a perfect hash of the locations
+    open_closed_list.setNodeTableBackend(NodeTableBackend::direct_index);
+}
+
+HpaStar::~HpaStar()
+{
+}
+
+void HpaStar::setTransitionSystem(const MapPathfindingTransitions* map)
+{
+    map_ops = map;
+    map_width = map->getMapWidth();
+    open_closed_list.reserveHashRange((StateHash) map_width * map->getMapHeight());
+
+    SearchEngine<MapLocation, MapDir>::setTransitionSystem(map);
+}
+
+void HpaStar::setGoalTest(const SingleGoalTest<MapLocation>* goal)
+{
+    single_goal = goal;
+    SearchEngine<MapLocation, MapDir>::setGoalTest(goal);
+}
+
+void HpaStar::setHeuristic(const Heuristic<MapLocation>* heur)
+{
+    heur_func = heur;
+}
+
+void HpaStar::setAbstraction(ClusterAbstraction* abs)
+{
+    abstraction = abs;
+    resetEngine();
+}
+
+void HpaStar::setTieBreaker(TieBreakType type)
+{
+    open_closed_list.getTieBreaker().setType(type);
+}
+
+uint64_t HpaStar::getUniqueGoalTests() const
+{
+    return unique_goal_tests;
+}
+
+SearchTermType HpaStar::searchForPlan(const MapLocation& init_state)
+{
+    BfsExpansionResult exp_result = BfsExpansionResult::no_solution;
+
+    goal = single_goal->getCurrentGoal();
+    goal_cluster = abstraction->getClusterIndex(goal);
+    goal_is_entrance = abstraction->getEntranceIndex(goal) != ClusterAbstraction::no_entrance;
+
+    // paths within a cluster can be reversed, so the distances from the goal are also the distances to it
+    if(!goal_is_entrance)
+        abstraction->findEntranceDistances(goal, goal, goal_distances);
+
+    double init_h = heur_func->computeHValue(init_state);
+    incrementHCompCount();
+
+    open_closed_list.addInitialNodeToOpen(init_state, MapDir::dummy, init_state.y * map_width + init_state.x, init_h,
+            init_h);
+
+    while(exp_result == BfsExpansionResult::no_solution)
+        exp_result = nodeExpansion();
+
+    if(exp_result == BfsExpansionResult::res_limit)
+        return SearchTermType::res_limit;
+    return SearchTermType::completed;
+}
+
+void HpaStar::resetStatistics()
+{
+    SearchEngine<MapLocation, MapDir>::resetStatistics();
+    unique_goal_tests = 0;
+}
+
+bool HpaStar::isConfigured() const
+{
+    if(!heur_func || !map_ops || !single_goal || !abstraction)
+        return false;
+
+    // the base class setters may have been used to replace the map or goal test
+    if(op_system != map_ops || goal_test != single_goal)
+        return false;
+
+    if(abstraction->isEmpty() || !abstraction->fitsMap(*map_ops))
+        return false;
+
+    return SearchEngine<MapLocation, MapDir>::isConfigured();
+}
+
+void HpaStar::resetEngine()
+{
+    open_closed_list.clear();
+    SearchEngine<MapLocation, MapDir>::resetEngine();
+}
+
+BfsExpansionResult HpaStar::nodeExpansion()
+{
+    if(open_closed_list.isOpenEmpty())
+        return BfsExpansionResult::empty_open;
+
+    NodeID to_expand_id = open_closed_list.getBestNodeAndClose();
+
+    // copied since adding nodes may move the stored states
+    MapLocation to_expand_state = open_closed_list.getState(to_expand_id);
+
+    if(hitGoalTestLimit())
+        return BfsExpansionResult::res_limit;
+
+    incrementGoalTestCount();
+    if(!open_closed_list.isReopened(to_expand_id))
+        unique_goal_tests++;
+
+    if(goal_test->isGoal(to_expand_state)) {
+        extractSolutionPath(to_expand_id);
+        return BfsExpansionResult::goal_found;
+    }
+
+    if(hitSuccFuncLimit())
+        return BfsExpansionResult::res_limit;
+
+    incrementSuccFuccCalls();
+
+    BfsExpansionResult result = BfsExpansionResult::no_solution;
+    unsigned cluster = abstraction->getClusterIndex(to_expand_state);
+    uint32_t index = abstraction->getEntranceIndex(to_expand_state);
+    unsigned num_entrances = abstraction->getNumEntrances(cluster);
+
+    if(index == ClusterAbstraction::no_entrance) {
+        // only the start can be expanded without being an entrance
+        double goal_distance = abstraction->findEntranceDistances(to_expand_state, goal, start_distances);
+
+        for(unsigned i = 0; i < num_entrances && result == BfsExpansionResult::no_solution; i++) {
+            if(start_distances[i] < 0.0)
+                continue;
+            increaseActionGenCount(1);
+            result = generateChild(to_expand_id, to_expand_state, abstraction->getEntrance(cluster, i),
+                    start_distances[i]);
+        }
+
+        if(result == BfsExpansionResult::no_solution && goal_distance >= 0.0) {
+            increaseActionGenCount(1);
+            result = generateChild(to_expand_id, to_expand_state, goal, goal_distance);
+        }
+        return result;
+    }
+
+    for(unsigned i = 0; i < num_entrances && result == BfsExpansionResult::no_solution; i++) {
+        double distance = abstraction->getIntraDistance(cluster, index, i);
+        if(i == index || distance < 0.0)
+            continue;
+        increaseActionGenCount(1);
+        result = generateChild(to_expand_id, to_expand_state, abstraction->getEntrance(cluster, i), distance);
+    }
+
+    uint8_t transition_dirs = abstraction->getTransitionDirs(cluster, index);
+    while(transition_dirs && result == BfsExpansionResult::no_solution) {
+        MapDir dir = (MapDir) __builtin_ctz(transition_dirs);
+        transition_dirs &= transition_dirs - 1;
+
+        MapLocation child_state(to_expand_state.x + map_dir_x[(unsigned) dir],
+                to_expand_state.y + map_dir_y[(unsigned) dir]);
+        increaseActionGenCount(1);
+        result = generateChild(to_expand_id, to_expand_state, child_state,
+                map_ops->getActionCost(to_expand_state, dir));
+    }
+
+    if(result == BfsExpansionResult::no_solution && !goal_is_entrance && cluster == goal_cluster
+            && goal_distances[index] >= 0.0) {
+        increaseActionGenCount(1);
+        result = generateChild(to_expand_id, to_expand_state, goal, goal_distances[index]);
+    }
+
+    return result;
+}
+
+BfsExpansionResult HpaStar::generateChild(NodeID parent_id, const MapLocation& parent_state,
+        const MapLocation& child_state, double edge_cost)
+{
+    incrementStateGenCount();
+
+    double child_g = open_closed_list.getGCost(parent_id) + edge_cost;
+    MapDir dir = getEdgeDir(parent_state, child_state);
+    StateHash child_hash = child_state.y * map_width + child_state.x;
+
+    NodeID child_id;
+    StateLocation location = open_closed_list.getStateLocation(child_state, child_hash, child_id);
+
+    if(location == StateLocation::open || location == StateLocation::closed) {
+        if(fp_less(child_g, open_closed_list.getGCost(child_id))) {
+            open_closed_list.setNodePath(child_id, parent_id, dir, child_g,
+                    child_g + open_closed_list.getHValue(child_id));
+
+            if(location == StateLocation::open)
+                open_closed_list.openNodeEvalChanged(child_id);
+            else
+                open_closed_list.reopenNode(child_id);
+        }
+    } else {
+        if(hitHCompLimit())
+            return BfsExpansionResult::res_limit;
+
+        incrementHCompCount();
+        double child_h = heur_func->computeHValue(child_state);
+
+        open_closed_list.addNewNodeToOpen(child_state, dir, child_hash, child_g, child_h, child_g + child_h,
+                parent_id);
+    }
+
+    return BfsExpansionResult::no_solution;
+}
+
+void HpaStar::extractSolutionPath(NodeID path_end_id)
+{
+    incumbent_cost = 0.0;
+    incumbent_plan.clear();
+
+    std::vector<MapLocation> path_states;
+    NodeID id = path_end_id;
+    path_states.push_back(open_closed_list.getState(id));
+    while(open_closed_list.getGenAction(id) != MapDir::dummy) {
+        id = open_closed_list.getParent(id);
+        path_states.push_back(open_closed_list.getState(id));
+    }
+
+    // the edges are refined from the start, and the plan is then reversed to end with the first move like other plans
+    for(unsigned i = path_states.size() - 1; i > 0; i--) {
+        bool refined = abstraction->refineSegment(path_states[i], path_states[i - 1], incumbent_plan);
+        assert(refined);
+        (void) refined;
+    }
+
+    MapLocation current = path_states.back();
+    for(MapDir dir : incumbent_plan) {
+        incumbent_cost += map_ops->getActionCost(current, dir);
+        map_ops->applyAction(current, dir);
+    }
+    std::reverse(incumbent_plan.begin(), incumbent_plan.end());
+
+    assert(!fp_greater(incumbent_cost, open_closed_list.getGCost(path_end_id)));
+}
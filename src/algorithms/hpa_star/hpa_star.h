@@ -0,0 +1,139 @@
+/*
+ * hpa_star.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef HPA_STAR_H_
+#define HPA_STAR_H_
+
+#include "../best_first_search/best_first_search.h"
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+#include "../../generic_defs/single_goal_test.h"
+#include "cluster_abstraction.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Hierarchical Path-Finding A* (HPA*) over a ClusterAbstraction of a map.
+ *
+ * At the start of each search, the goal is linked to the entrances of its cluster that it can reach within the
+ * cluster, unless it is an entrance itself. Expanding an entrance generates the other entrances of its cluster it is
+ * connected to, the entrances across its transitions, and the goal if it is linked. If the start is not an entrance,
+ * expanding it generates the entrances of its cluster it can reach within the cluster, and the goal if it can. Once
+ * the goal is found, each abstract edge is refined into single moves, using the paths the abstraction has cached.
+ *
+ * The plans returned are full sequences of single moves, but their costs are not always optimal, since paths are only
+ * allowed to enter and leave clusters through their entrances. The goal test count is the number of expansions, and
+ * the state and action generation counts are the number of abstract edges followed.
+ *
+ * Works with both 4- and 8-connected maps. The goal test must be a single goal test, and the abstraction must fit the
+ * map. If the map changes, the abstraction must be updated before the next search.
+ *
+ * @class HpaStar
+ */
+class HpaStar: public SearchEngine<MapLocation, MapDir>
+{
+public:
+    HpaStar();
+    virtual ~HpaStar();
+
+    /**
+     * Sets the map to search on.
+     *
+     * @param map The map.
+     */
+    void setTransitionSystem(const MapPathfindingTransitions *map);
+
+    /**
+     * Sets the goal test. The goal is read from the goal test at the start of each search.
+     *
+     * @param goal The goal test.
+     */
+    void setGoalTest(const SingleGoalTest<MapLocation> *goal);
+
+    /**
+     * Sets the heuristic function used by the search.
+     *
+     * @param heur A pointer to the heuristic function to use.
+     */
+    void setHeuristic(const Heuristic<MapLocation> *heur);
+
+    /**
+     * Sets the abstraction to search. It must have been built for the map that is searched on. It is not const since
+     * refining paths adds to its cache.
+     *
+     * @param abs The abstraction.
+     */
+    void setAbstraction(ClusterAbstraction *abs);
+
+    /**
+     * Sets the rule used to break ties between nodes with equal evaluations.
+     *
+     * @param type The tie-breaking rule to use.
+     */
+    void setTieBreaker(TieBreakType type);
+
+    /**
+     * Returns the number of unique goal tests.
+     *
+     * @return The number of unique goal tests.
+     */
+    uint64_t getUniqueGoalTests() const;
+
+protected:
+    // Overloaded functions
+    virtual SearchTermType searchForPlan(const MapLocation &init_state);
+    virtual void resetStatistics();
+    virtual bool isConfigured() const;
+    virtual void resetEngine();
+
+    /**
+     * Expands a single node and returns the result of the expansion (regarding if a solution as found or not).
+     *
+     * @return The result of the node expansion.
+     */
+    BfsExpansionResult nodeExpansion();
+
+    /**
+     * Generates the child at the given location for the node being expanded.
+     *
+     * @param parent_id The node being expanded.
+     * @param parent_state The location of the node being expanded.
+     * @param child_state The location of the child.
+     * @param edge_cost The cost of the abstract edge to the child.
+     * @return The result of the generation, which is no_solution unless a resource limit is hit.
+     */
+    BfsExpansionResult generateChild(NodeID parent_id, const MapLocation &parent_state,
+            const MapLocation &child_state, double edge_cost);
+
+    /**
+     * Extracts the path that ends at the node for the given id and stores it as the incumbent plan, with each abstract
+     * edge refined into single moves.
+     *
+     * @param path_end_id The node at the end of the path.
+     */
+    void extractSolutionPath(NodeID path_end_id);
+
+    const MapPathfindingTransitions *map_ops; ///< The map.
+    const SingleGoalTest<MapLocation> *single_goal; ///< The goal test.
+    const Heuristic<MapLocation> *heur_func; ///< The heuristic function.
+    ClusterAbstraction *abstraction; ///< The abstraction.
+
+    MapLocation goal; ///< The goal of the current search.
+    unsigned goal_cluster; ///< The cluster of the goal.
+    bool goal_is_entrance; ///< If the goal is an entrance of its cluster.
+    std::vector<double> goal_distances; ///< The distance from each entrance of the goal's cluster to the goal, or -1.
+    std::vector<double> start_distances; ///< The distance from the start to each entrance of its cluster, or -1.
+    unsigned map_width; ///< The width of the map.
+
+    OpenClosedList<MapLocation, MapDir> open_closed_list; ///< The open and closed list.
+
+    uint64_t unique_goal_tests; ///< The number of unique goal tests performed.
+};
+
+#endif /* HPA_STAR_H_ */
@@ -0,0 +1,207 @@
+/*
+ * jump_distance_table.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "jump_distance_table.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using std::cerr;
+using std::endl;
+
+namespace
+{
+/// Identifies jump distance table files.
+const char file_magic[8] = {'J', 'P', 'S', 'P', 'L', 'U', 'S', '\0'};
+
+/// The version of the file format.
+const uint32_t file_version = 1;
+
+/// The largest distance that can be stored.
+const unsigned max_distance = 32767;
+}
+
+JumpDistanceTable::JumpDistanceTable()
+        : map_width(0), map_height(0), map_hash(0), jump_distances(0)
+{
+}
+
+JumpDistanceTable::~JumpDistanceTable()
+{
+    clear();
+}
+
+bool JumpDistanceTable::build(const MapPathfindingTransitions& map)
+{
+    clear();
+
+    unsigned width = map.getMapWidth();
+    unsigned height = map.getMapHeight();
+    if(width > max_distance || height > max_distance) {
+        cerr << "Map is too large to build a jump distance table for." << endl;
+        return false;
+    }
+
+    built_distances.assign((std::size_t) width * height * 8, 0);
+
+    // Each distance is computed from the one of the next location in the same direction, so locations are visited
+    // starting from the far side of the map. Diagonal distances use the cardinal ones, so they are done last.
+    static const unsigned dir_order[8] = {0, 2, 4, 6, 1, 3, 5, 7};
+    for(unsigned i = 0; i < 8; i++) {
+        unsigned d = dir_order[i];
+
+        for(unsigned row = 0; row < height; row++) {
+            int y = map_dir_y[d] > 0 ? height - 1 - row : row;
+
+            for(unsigned col = 0; col < width; col++) {
+                int x = map_dir_x[d] > 0 ? width - 1 - col : col;
+                int next_x = x + map_dir_x[d];
+                int next_y = y + map_dir_y[d];
+
+                if(!map.isCellEmpty(x, y) || !map.isCellEmpty(next_x, next_y))
+                    continue;
+
+                int16_t *distances = &built_distances[((std::size_t) y * width + x) * 8];
+                const int16_t *next_distances = &built_distances[((std::size_t) next_y * width + next_x) * 8];
+
+                bool is_jump_point = false;
+                if(d & 1) {
+                    if(!map.isCellEmpty(next_x, y) || !map.isCellEmpty(x, next_y))
+                        continue;
+                    is_jump_point = next_distances[(d + 7) % 8] > 0 || next_distances[(d + 1) % 8] > 0;
+                } else {
+                    for(unsigned turn = 2; turn <= 6 && !is_jump_point; turn += 4) {
+                        unsigned side = (d + turn) % 8;
+                        is_jump_point = map.isCellEmpty(next_x + map_dir_x[side], next_y + map_dir_y[side])
+                                && !map.isCellEmpty(x + map_dir_x[side], y + map_dir_y[side]);
+                    }
+                }
+
+                if(is_jump_point)
+                    distances[d] = 1;
+                else if(next_distances[d] > 0)
+                    distances[d] = next_distances[d] + 1;
+                else
+                    distances[d] = next_distances[d] - 1;
+            }
+        }
+    }
+
+    setDistances(built_distances.data(), width, height, map.computeMapHash());
+    return true;
+}
+
+bool JumpDistanceTable::saveFile(const std::string& file_name) const
+{
+    if(isEmpty()) {
+        cerr << "Can't save an empty jump distance table." << endl;
+        return false;
+    }
+
+    std::ofstream out_stream(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(out_stream.fail()) {
+        cerr << "Could not open jump distance file " << file_name << " for writing." << endl;
+        return false;
+    }
+
+    FileHeader header = makeFileHeader(map_width, map_height, map_hash);
+    out_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out_stream.write(reinterpret_cast<const char *>(jump_distances),
+            (std::size_t) map_width * map_height * 8 * sizeof(int16_t));
+
+    if(!out_stream.good()) {
+        cerr << "Writing jump distance file " << file_name << " failed." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool JumpDistanceTable::loadFile(const std::string& file_name, const MapPathfindingTransitions& map)
+{
+    clear();
+
+    std::size_t data_size = (std::size_t) map.getMapWidth() * map.getMapHeight() * 8 * sizeof(int16_t);
+    std::size_t file_size = sizeof(FileHeader) + data_size;
+
+    FileHeader expected = makeFileHeader(map.getMapWidth(), map.getMapHeight(), map.computeMapHash());
+
+    if(!file.open(file_name)) {
+        cerr << "Could not open jump distance file " << file_name << "." << endl;
+        return false;
+    }
+
+    FileHeader header;
+    if(file.getSize() == file_size)
+        memcpy(&header, file.getData(), sizeof(header));
+
+    if(file.getSize() != file_size || memcmp(&header, &expected, sizeof(header)) != 0) {
+        clear();
+        cerr << "Jump distance file " << file_name << " does not match the map." << endl;
+        return false;
+    }
+
+    const int16_t *distances = reinterpret_cast<const int16_t *>(file.getData() + sizeof(header));
+    setDistances(distances, expected.map_width, expected.map_height, expected.map_hash);
+    return true;
+}
+
+bool JumpDistanceTable::loadOrBuild(const std::string& file_name, const MapPathfindingTransitions& map)
+{
+    // The file is missing on the first run, so only files that exist are loaded and reported on if they don't fit
+    if(std::ifstream(file_name).good() && loadFile(file_name, map))
+        return true;
+
+    if(!build(map))
+        return false;
+    saveFile(file_name);
+    return true;
+}
+
+void JumpDistanceTable::clear()
+{
+    file.close();
+    built_distances.clear();
+    setDistances(0, 0, 0, 0);
+}
+
+bool JumpDistanceTable::isEmpty() const
+{
+    return jump_distances == 0;
+}
+
+unsigned JumpDistanceTable::getMapWidth() const
+{
+    return map_width;
+}
+
+unsigned JumpDistanceTable::getMapHeight() const
+{
+    return map_height;
+}
+
+JumpDistanceTable::FileHeader JumpDistanceTable::makeFileHeader(unsigned width, unsigned height, uint64_t hash)
+{
+    FileHeader header;
+    memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.map_width = width;
+    header.map_height = height;
+    header.reserved = 0;
+    header.map_hash = hash;
+    return header;
+}
+
+void JumpDistanceTable::setDistances(const int16_t* distances, unsigned width, unsigned height, uint64_t hash)
+{
+    jump_distances = distances;
+    map_width = width;
+    map_height = height;
+    map_hash = hash;
+}
@@ -0,0 +1,180 @@
+/*
+ * jump_distance_table.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef JUMP_DISTANCE_TABLE_H_
+#define JUMP_DISTANCE_TABLE_H_
+
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+#include "../../utils/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * The precomputed jump distances used by JPS+, which replace the scanning done by Jump Point Search with lookups.
+ *
+ * For every location and direction, the table stores how far a jump in that direction goes when the goal is not in
+ * the way. A positive distance d means the jump ends at the jump point d moves away. Otherwise, there is no jump point
+ * in that direction and -d moves can be made before hitting an obstacle. Jump points are defined as in
+ * JumpPointSearch, so the table applies to 8-connected maps where diagonal moves cannot cut corners.
+ *
+ * Tables can be saved to a binary sidecar file and memory-mapped back in, so a static map only has to be preprocessed
+ * once. The file stores the map dimensions and a hash of the map, and is rejected if these do not match the map it is
+ * loaded for. It is written in the byte order of the machine that wrote it.
+ *
+ * The table is not copyable since it may own a file mapping.
+ *
+ * @class JumpDistanceTable
+ */
+class JumpDistanceTable
+{
+public:
+    /**
+     * Constructs an empty table.
+     */
+    JumpDistanceTable();
+
+    /**
+     * Releases the table, including any file mapping.
+     */
+    ~JumpDistanceTable();
+
+    JumpDistanceTable(const JumpDistanceTable &) = delete;
+    JumpDistanceTable &operator=(const JumpDistanceTable &) = delete;
+
+    /**
+     * Computes the jump distances for the given map. Ignores the connectivity the map is currently set to.
+     *
+     * Fails if either dimension of the map is too large for the distances to fit in the table.
+     *
+     * @param map The map.
+     * @return If the table was built.
+     */
+    bool build(const MapPathfindingTransitions &map);
+
+    /**
+     * Saves the table to the file with the given name.
+     *
+     * @param file_name The name of the file to write.
+     * @return If the file was written.
+     */
+    bool saveFile(const std::string &file_name) const;
+
+    /**
+     * Loads the table from the file with the given name by memory-mapping it.
+     *
+     * Fails, leaving the table empty, if the file can't be read or was not made for the given map.
+     *
+     * @param file_name The name of the file to load.
+     * @param map The map the table will be used for.
+     * @return If the table was loaded.
+     */
+    bool loadFile(const std::string &file_name, const MapPathfindingTransitions &map);
+
+    /**
+     * Loads the table from the file with the given name if it was made for the given map. Otherwise builds the table
+     * for the map and saves it to that file. A missing file is not reported as an error, since it is expected the
+     * first time.
+     *
+     * @param file_name The name of the file to use.
+     * @param map The map.
+     * @return If the table is ready for use. True even if the new table could not be saved.
+     */
+    bool loadOrBuild(const std::string &file_name, const MapPathfindingTransitions &map);
+
+    /**
+     * Empties the table.
+     */
+    void clear();
+
+    /**
+     * Checks if the table holds distances.
+     *
+     * @return If the table is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns the width of the map the table was made for.
+     *
+     * @return The width of the map.
+     */
+    unsigned getMapWidth() const;
+
+    /**
+     * Returns the height of the map the table was made for.
+     *
+     * @return The height of the map.
+     */
+    unsigned getMapHeight() const;
+
+    /**
+     * Returns the jump distance from the given location in the given direction.
+     *
+     * @param loc The location. Must be on the map.
+     * @param dir The direction. Must not be the dummy action.
+     * @return The jump distance, as described for the class.
+     */
+    int getJumpDistance(const MapLocation &loc, MapDir dir) const;
+
+protected:
+    /**
+     * The header at the start of a table file, which is followed by the distances.
+     *
+     * @class FileHeader
+     */
+    struct FileHeader
+    {
+        char magic[8]; ///< Identifies the file as a jump distance table.
+        uint32_t version; ///< The version of the file format.
+        uint32_t map_width; ///< The width of the map.
+        uint32_t map_height; ///< The height of the map.
+        uint32_t reserved; ///< Unused. Set as 0.
+        uint64_t map_hash; ///< The hash of the map.
+    };
+
+    /**
+     * Returns the header for a table file for a map with the given dimensions and hash.
+     *
+     * @param width The width of the map.
+     * @param height The height of the map.
+     * @param hash The hash of the map.
+     * @return The file header.
+     */
+    static FileHeader makeFileHeader(unsigned width, unsigned height, uint64_t hash);
+
+    /**
+     * Sets the distances to point to the given memory, which must stay valid until the table is cleared.
+     *
+     * @param distances The distances.
+     * @param width The width of the map.
+     * @param height The height of the map.
+     * @param hash The hash of the map.
+     */
+    void setDistances(const int16_t *distances, unsigned width, unsigned height, uint64_t hash);
+
+    unsigned map_width; ///< The width of the map.
+    unsigned map_height; ///< The height of the map.
+    uint64_t map_hash; ///< The hash of the map.
+
+    const int16_t *jump_distances; ///< The distance for direction d from location (x, y) is at (y * width + x) * 8 + d.
+    std::vector<int16_t> built_distances; ///< The distances if they were built rather than loaded.
+
+    MappedFile file; ///< The loaded file, if any.
+};
+
+inline int JumpDistanceTable::getJumpDistance(const MapLocation& loc, MapDir dir) const
+{
+    assert(loc.x < map_width && loc.y < map_height);
+    return jump_distances[((std::size_t) loc.y * map_width + loc.x) * 8 + (unsigned) dir];
+}
+
+#endif /* JUMP_DISTANCE_TABLE_H_ */
@@ -0,0 +1,385 @@
+/*
+ * jump_point_search.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "jump_point_search.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+JumpPointSearch::JumpPointSearch()
+        : map_ops(0), single_goal(0), heur_func(0), jump_table(0), map_width(0), map_height(0), row_words(0),
+                col_words(0), unique_goal_tests(0)
+{
+    // Cell indices are a perfect hash of the locations
+    open_closed_list.setNodeTableBackend(NodeTableBackend::direct_index);
+}
+
+JumpPointSearch::~JumpPointSearch()
+{
+}
+
+void JumpPointSearch::setTransitionSystem(const MapPathfindingTransitions* map)
+{
+    map_ops = map;
+    map_width = map->getMapWidth();
+    map_height = map->getMapHeight();
+
+    row_words = (line_offset + map_width) / 64 + 2;
+    col_words = (line_offset + map_height) / 64 + 2;
+    row_bits.assign((map_height + 2) * row_words, 0);
+    col_bits.assign((map_width + 2) * col_words, 0);
+
+    for(unsigned y = 0; y < map_height; y++) {
+        for(unsigned x = 0; x < map_width; x++) {
+            if(!map->isCellEmpty(x, y))
+                continue;
+
+            unsigned row_bit = x + line_offset;
+            row_bits[(y + 1) * row_words + row_bit / 64] |= (uint64_t) 1 << (row_bit % 64);
+
+            unsigned col_bit = y + line_offset;
+            col_bits[(x + 1) * col_words + col_bit / 64] |= (uint64_t) 1 << (col_bit % 64);
+        }
+    }
+
+    open_closed_list.reserveHashRange((StateHash) map_width * map_height);
+
+    SearchEngine<MapLocation, MapDir>::setTransitionSystem(map);
+}
+
+void JumpPointSearch::setGoalTest(const SingleGoalTest<MapLocation>* goal)
+{
+    single_goal = goal;
+    SearchEngine<MapLocation, MapDir>::setGoalTest(goal);
+}
+
+void JumpPointSearch::setHeuristic(const Heuristic<MapLocation>* heur)
+{
+    heur_func = heur;
+}
+
+void JumpPointSearch::setJumpDistanceTable(const JumpDistanceTable* table)
+{
+    jump_table = table;
+    resetEngine();
+}
+
+void JumpPointSearch::setTieBreaker(TieBreakType type)
+{
+    open_closed_list.getTieBreaker().setType(type);
+}
+
+uint64_t JumpPointSearch::getUniqueGoalTests() const
+{
+    return unique_goal_tests;
+}
+
+SearchTermType JumpPointSearch::searchForPlan(const MapLocation& init_state)
+{
+    BfsExpansionResult exp_result = BfsExpansionResult::no_solution;
+
+    goal = single_goal->getCurrentGoal();
+
+    double init_h = heur_func->computeHValue(init_state);
+    incrementHCompCount();
+
+    open_closed_list.addInitialNodeToOpen(init_state, MapDir::dummy, init_state.y * map_width + init_state.x, init_h,
+            init_h);
+
+    while(exp_result == BfsExpansionResult::no_solution)
+        exp_result = nodeExpansion();
+
+    if(exp_result == BfsExpansionResult::res_limit)
+        return SearchTermType::res_limit;
+    return SearchTermType::completed;
+}
+
+void JumpPointSearch::resetStatistics()
+{
+    SearchEngine<MapLocation, MapDir>::resetStatistics();
+    unique_goal_tests = 0;
+}
+
+bool JumpPointSearch::isConfigured() const
+{
+    if(!heur_func || !map_ops || !single_goal)
+        return false;
+
+    // the base class setters may have been used to replace the map or goal test
+    if(op_system != map_ops || goal_test != single_goal)
+        return false;
+
+    if(!map_ops->is8Connected() || map_ops->getMapWidth() != map_width || map_ops->getMapHeight() != map_height)
+        return false;
+
+    if(jump_table && (jump_table->isEmpty() || jump_table->getMapWidth() != map_width
+            || jump_table->getMapHeight() != map_height))
+        return false;
+
+    return SearchEngine<MapLocation, MapDir>::isConfigured();
+}
+
+void JumpPointSearch::resetEngine()
+{
+    open_closed_list.clear();
+    SearchEngine<MapLocation, MapDir>::resetEngine();
+}
+
+BfsExpansionResult JumpPointSearch::nodeExpansion()
+{
+    if(open_closed_list.isOpenEmpty())
+        return BfsExpansionResult::empty_open;
+
+    NodeID to_expand_id = open_closed_list.getBestNodeAndClose();
+
+    // copied since adding nodes may move the stored states
+    MapLocation to_expand_state = open_closed_list.getState(to_expand_id);
+
+    if(hitGoalTestLimit())
+        return BfsExpansionResult::res_limit;
+
+    incrementGoalTestCount();
+    if(!open_closed_list.isReopened(to_expand_id))
+        unique_goal_tests++;
+
+    if(goal_test->isGoal(to_expand_state)) {
+        extractSolutionPath(to_expand_id);
+        return BfsExpansionResult::goal_found;
+    }
+
+    double parent_g = open_closed_list.getGCost(to_expand_id);
+
+    if(hitSuccFuncLimit())
+        return BfsExpansionResult::res_limit;
+
+    incrementSuccFuccCalls();
+
+    unsigned jump_dirs = getJumpDirs(to_expand_state, open_closed_list.getGenAction(to_expand_id));
+    increaseActionGenCount(__builtin_popcount(jump_dirs));
+
+    MapLocation child_state;
+    while(jump_dirs) {
+        MapDir dir = (MapDir) __builtin_ctz(jump_dirs);
+        jump_dirs &= jump_dirs - 1;
+
+        unsigned num_moves = jump(to_expand_state, dir, child_state);
+        if(num_moves == 0)
+            continue;
+
+        incrementStateGenCount();
+
+        double child_g = parent_g + num_moves * map_ops->getActionCost(to_expand_state, dir);
+        StateHash child_hash = child_state.y * map_width + child_state.x;
+
+        NodeID child_id;
+        StateLocation location = open_closed_list.getStateLocation(child_state, child_hash, child_id);
+
+        if(location == StateLocation::open || location == StateLocation::closed) {
+            if(fp_less(child_g, open_closed_list.getGCost(child_id))) {
+                open_closed_list.setNodePath(child_id, to_expand_id, dir, child_g,
+                        child_g + open_closed_list.getHValue(child_id));
+
+                if(location == StateLocation::open)
+                    open_closed_list.openNodeEvalChanged(child_id);
+                else
+                    open_closed_list.reopenNode(child_id);
+            }
+        } else {
+            if(hitHCompLimit())
+                return BfsExpansionResult::res_limit;
+
+            incrementHCompCount();
+            double child_h = heur_func->computeHValue(child_state);
+
+            open_closed_list.addNewNodeToOpen(child_state, dir, child_hash, child_g, child_h, child_g + child_h,
+                    to_expand_id);
+        }
+    }
+
+    return BfsExpansionResult::no_solution;
+}
+
+uint8_t JumpPointSearch::getJumpDirs(const MapLocation& loc, MapDir arrival_dir) const
+{
+    uint8_t possible_dirs = map_ops->getMoveMask(loc);
+    if(arrival_dir == MapDir::dummy)
+        return possible_dirs;
+
+    unsigned dir = (unsigned) arrival_dir;
+    uint8_t jump_dirs = MapPathfindingTransitions::getDirBit(arrival_dir);
+
+    if(dir & 1) {
+        // diagonal moves can't cut corners, so only the cardinal directions they combine are natural
+        jump_dirs |= (1u << (dir + 7) % 8) | (1u << (dir + 1) % 8);
+    } else {
+        // a side is forced if it could not have been reached from the previous location without passing through loc
+        for(unsigned diag_turn = 1; diag_turn <= 7; diag_turn += 6) {
+            unsigned side = (dir + 2 * diag_turn) % 8;
+            if(isEmpty(loc.x + map_dir_x[side], loc.y + map_dir_y[side])
+                    && !isEmpty(loc.x - map_dir_x[dir] + map_dir_x[side], loc.y - map_dir_y[dir] + map_dir_y[side]))
+                jump_dirs |= (1u << side) | (1u << (dir + diag_turn) % 8);
+        }
+    }
+
+    return jump_dirs & possible_dirs;
+}
+
+unsigned JumpPointSearch::jump(const MapLocation& loc, MapDir dir, MapLocation& jump_point) const
+{
+    if(jump_table)
+        return lookUpJump(loc, dir, jump_point);
+
+    unsigned dir_index = (unsigned) dir;
+
+    if(map_dir_x[dir_index] == 0) {
+        unsigned pos = loc.y + line_offset;
+        unsigned end = jumpAlongLine(col_bits, col_words, loc.x + 1, pos, map_dir_y[dir_index] > 0, goal.x + 1,
+                goal.y + line_offset);
+        if(end == 0)
+            return 0;
+
+        jump_point.x = loc.x;
+        jump_point.y = end - line_offset;
+        return std::abs((int) end - (int) pos);
+    }
+
+    if(map_dir_y[dir_index] == 0) {
+        unsigned pos = loc.x + line_offset;
+        unsigned end = jumpAlongLine(row_bits, row_words, loc.y + 1, pos, map_dir_x[dir_index] > 0, goal.y + 1,
+                goal.x + line_offset);
+        if(end == 0)
+            return 0;
+
+        jump_point.x = end - line_offset;
+        jump_point.y = loc.y;
+        return std::abs((int) end - (int) pos);
+    }
+
+    uint8_t dir_bit = MapPathfindingTransitions::getDirBit(dir);
+    bool east = map_dir_x[dir_index] > 0;
+    bool south = map_dir_y[dir_index] > 0;
+
+    MapLocation current = loc;
+    for(unsigned num_moves = 1; map_ops->getMoveMask(current) & dir_bit; num_moves++) {
+        current.x += map_dir_x[dir_index];
+        current.y += map_dir_y[dir_index];
+
+        if(current == goal
+                || jumpAlongLine(row_bits, row_words, current.y + 1, current.x + line_offset, east, goal.y + 1,
+                        goal.x + line_offset)
+                || jumpAlongLine(col_bits, col_words, current.x + 1, current.y + line_offset, south, goal.x + 1,
+                        goal.y + line_offset)) {
+            jump_point = current;
+            return num_moves;
+        }
+    }
+    return 0;
+}
+
+unsigned JumpPointSearch::lookUpJump(const MapLocation& loc, MapDir dir, MapLocation& jump_point) const
+{
+    unsigned dir_index = (unsigned) dir;
+    int distance = jump_table->getJumpDistance(loc, dir);
+
+    // the number of moves in this direction to the goal, or to its row or column for diagonal moves
+    int goal_x_moves = ((int) goal.x - (int) loc.x) * map_dir_x[dir_index];
+    int goal_y_moves = ((int) goal.y - (int) loc.y) * map_dir_y[dir_index];
+    int goal_moves = 0;
+    if(map_dir_x[dir_index] == 0) {
+        if(goal.x == loc.x)
+            goal_moves = goal_y_moves;
+    } else if(map_dir_y[dir_index] == 0) {
+        if(goal.y == loc.y)
+            goal_moves = goal_x_moves;
+    } else {
+        goal_moves = std::min(goal_x_moves, goal_y_moves);
+    }
+
+    unsigned num_moves = 0;
+    if(goal_moves > 0 && goal_moves <= std::abs(distance))
+        num_moves = goal_moves;
+    else if(distance > 0)
+        num_moves = distance;
+    else
+        return 0;
+
+    jump_point.x = loc.x + (int) num_moves * map_dir_x[dir_index];
+    jump_point.y = loc.y + (int) num_moves * map_dir_y[dir_index];
+    return num_moves;
+}
+
+unsigned JumpPointSearch::jumpAlongLine(const std::vector<uint64_t>& lines, unsigned words, unsigned line,
+        unsigned pos, bool forward, unsigned goal_line, unsigned goal_pos)
+{
+    // Each pass checks a window of 64 positions that includes the current one. A position stops the jump if it is an
+    // obstacle, the goal, or has a forced neighbor: a location to the side which is empty while the one behind it
+    // is not.
+    if(forward) {
+        while(true) {
+            uint64_t cells = getLineBits(lines, words, line, pos);
+            uint64_t forced = (getLineBits(lines, words, line - 1, pos) & ~getLineBits(lines, words, line - 1, pos - 1))
+                    | (getLineBits(lines, words, line + 1, pos) & ~getLineBits(lines, words, line + 1, pos - 1));
+
+            uint64_t stops = (~cells | forced) & ~(uint64_t) 1;
+            if(line == goal_line && goal_pos > pos && goal_pos - pos < 64)
+                stops |= (uint64_t) 1 << (goal_pos - pos);
+
+            if(stops) {
+                unsigned offset = __builtin_ctzll(stops);
+                if(!((cells >> offset) & 1))
+                    return 0;
+                return pos + offset;
+            }
+            pos += 63;
+        }
+    }
+
+    while(true) {
+        unsigned start = pos - 63;
+        uint64_t cells = getLineBits(lines, words, line, start);
+        uint64_t forced = (getLineBits(lines, words, line - 1, start)
+                & ~getLineBits(lines, words, line - 1, start + 1))
+                | (getLineBits(lines, words, line + 1, start) & ~getLineBits(lines, words, line + 1, start + 1));
+
+        uint64_t stops = (~cells | forced) & ~((uint64_t) 1 << 63);
+        if(line == goal_line && goal_pos < pos && pos - goal_pos < 64)
+            stops |= (uint64_t) 1 << (goal_pos - start);
+
+        if(stops) {
+            unsigned offset = 63 - __builtin_clzll(stops);
+            if(!((cells >> offset) & 1))
+                return 0;
+            return start + offset;
+        }
+        pos = start;
+    }
+}
+
+void JumpPointSearch::extractSolutionPath(NodeID path_end_id)
+{
+    incumbent_cost = 0.0;
+    incumbent_plan.clear();
+
+    NodeID id = path_end_id;
+    while(open_closed_list.getGenAction(id) != MapDir::dummy) {
+        MapDir dir = open_closed_list.getGenAction(id);
+        MapLocation jump_end = open_closed_list.getState(id);
+        id = open_closed_list.getParent(id);
+        const MapLocation &jump_start = open_closed_list.getState(id);
+
+        unsigned num_moves = std::max(std::abs((int) jump_end.x - (int) jump_start.x),
+                std::abs((int) jump_end.y - (int) jump_start.y));
+        for(unsigned i = 0; i < num_moves; i++) {
+            incumbent_plan.push_back(dir);
+            incumbent_cost += map_ops->getActionCost(jump_start, dir);
+        }
+    }
+
+    assert(!fp_greater(incumbent_cost, open_closed_list.getGCost(path_end_id)));
+}
@@ -0,0 +1,226 @@
+/*
+ * jump_point_search.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef JUMP_POINT_SEARCH_H_
+#define JUMP_POINT_SEARCH_H_
+
+#include "../best_first_search/best_first_search.h"
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+#include "../../generic_defs/single_goal_test.h"
+#include "jump_distance_table.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Jump Point Search (JPS) for 8-connected grid maps with uniform costs.
+ *
+ * JPS is A* where each expansion only generates the jump points reached from the node: it moves in a straight line in
+ * each direction that cannot be reached at least as cheaply without passing through the node, and stops at the first
+ * location with a forced neighbor, at the goal, or at an obstacle (in which case nothing is generated). Diagonal moves
+ * stop at the first location from which a straight jump along either of its cardinal directions finds a jump point.
+ * Since the transition system does not allow diagonal moves that cut corners, locations reached diagonally never have
+ * forced neighbors.
+ *
+ * The map is copied into two bitmaps, one storing it row by row and one column by column, so that straight jumps in
+ * every direction are done 63 locations at a time with a few bit operations.
+ *
+ * The costs found are those of A* on the same map, and the plans returned are full sequences of single moves. The
+ * goal test count is the number of expansions, the state generation count is the number of jump points generated, and
+ * the action generation count is the number of directions jumped in.
+ *
+ * If a JumpDistanceTable is set, the search runs as JPS+: jumps are looked up in the table instead of scanned for. A
+ * jump that passes the goal, or for diagonal jumps the row or column of the goal, stops there instead. This generates
+ * some nodes online JPS would not, but finds the same costs.
+ *
+ * The map must be 8-connected, and the goal test must be a single goal test. The bitmaps are built when the transition
+ * system is set, so it must be set again if the map changes.
+ *
+ * @class JumpPointSearch
+ */
+class JumpPointSearch: public SearchEngine<MapLocation, MapDir>
+{
+public:
+    JumpPointSearch();
+    virtual ~JumpPointSearch();
+
+    /**
+     * Sets the map to search on and builds the bitmaps of it used for jumping.
+     *
+     * @param map The map. Must be 8-connected.
+     */
+    void setTransitionSystem(const MapPathfindingTransitions *map);
+
+    /**
+     * Sets the goal test. The goal is read from the goal test at the start of each search.
+     *
+     * @param goal The goal test.
+     */
+    void setGoalTest(const SingleGoalTest<MapLocation> *goal);
+
+    /**
+     * Sets the heuristic function used by the search.
+     *
+     * @param heur A pointer to the heuristic function to use.
+     */
+    void setHeuristic(const Heuristic<MapLocation> *heur);
+
+    /**
+     * Sets the table of jump distances to use, which makes the search run as JPS+. The table must be for the map that
+     * is searched on. Set as 0 to scan for jump points instead.
+     *
+     * @param table The jump distances.
+     */
+    void setJumpDistanceTable(const JumpDistanceTable *table);
+
+    /**
+     * Sets the rule used to break ties between nodes with equal evaluations.
+     *
+     * @param type The tie-breaking rule to use.
+     */
+    void setTieBreaker(TieBreakType type);
+
+    /**
+     * Returns the number of unique goal tests.
+     *
+     * @return The number of unique goal tests.
+     */
+    uint64_t getUniqueGoalTests() const;
+
+protected:
+    // Overloaded functions
+    virtual SearchTermType searchForPlan(const MapLocation &init_state);
+    virtual void resetStatistics();
+    virtual bool isConfigured() const;
+    virtual void resetEngine();
+
+    /**
+     * Expands a single node and returns the result of the expansion (regarding if a solution as found or not).
+     *
+     * @return The result of the node expansion.
+     */
+    BfsExpansionResult nodeExpansion();
+
+    /**
+     * Returns the mask of directions to jump in from the given location, given the direction it was reached in.
+     *
+     * @param loc The location being expanded.
+     * @param arrival_dir The direction the location was reached in, or the dummy action for the initial location.
+     * @return The move mask of directions to jump in.
+     */
+    uint8_t getJumpDirs(const MapLocation &loc, MapDir arrival_dir) const;
+
+    /**
+     * Jumps from the given location in the given direction.
+     *
+     * @param loc The location to jump from.
+     * @param dir The direction to jump in.
+     * @param jump_point Set as the jump point found, if there is one.
+     * @return The number of moves to the jump point, or 0 if there is none.
+     */
+    unsigned jump(const MapLocation &loc, MapDir dir, MapLocation &jump_point) const;
+
+    /**
+     * Jumps from the given location in the given direction using the jump distance table.
+     *
+     * @param loc The location to jump from.
+     * @param dir The direction to jump in.
+     * @param jump_point Set as the jump point found, if there is one.
+     * @return The number of moves to the jump point, or 0 if there is none.
+     */
+    unsigned lookUpJump(const MapLocation &loc, MapDir dir, MapLocation &jump_point) const;
+
+    /**
+     * Jumps along a line of one of the bitmaps from the given position, which must be empty.
+     *
+     * Positions are stored in the bitmap as explained for line_offset.
+     *
+     * @param lines The bitmap to jump in.
+     * @param words The number of words in each line of the bitmap.
+     * @param line The line to jump along.
+     * @param pos The position to jump from.
+     * @param forward If the jump is towards larger positions.
+     * @param goal_line The line that the goal is on.
+     * @param goal_pos The position of the goal on its line.
+     * @return The position of the jump point, or 0 if there is none.
+     */
+    static unsigned jumpAlongLine(const std::vector<uint64_t> &lines, unsigned words, unsigned line, unsigned pos,
+            bool forward, unsigned goal_line, unsigned goal_pos);
+
+    /**
+     * Returns the 64 bits of the given line of a bitmap that start at the given position.
+     *
+     * @param lines The bitmap.
+     * @param words The number of words in each line of the bitmap.
+     * @param line The line.
+     * @param start The position of the first bit.
+     * @return The bits for positions start to start + 63, with start as the lowest bit.
+     */
+    static uint64_t getLineBits(const std::vector<uint64_t> &lines, unsigned words, unsigned line, unsigned start);
+
+    /**
+     * Checks if the given location is empty. Locations one step outside of the map are obstacles.
+     *
+     * @param x_loc The x coordinate of the location.
+     * @param y_loc The y coordinate of the location.
+     * @return If the location is empty.
+     */
+    bool isEmpty(int x_loc, int y_loc) const;
+
+    /**
+     * Extracts the path that ends at the node for the given id and stores it as the incumbent plan, with each jump
+     * replaced by its single moves.
+     *
+     * @param path_end_id The node at the end of the path.
+     */
+    void extractSolutionPath(NodeID path_end_id);
+
+    /**
+     * The offset of the first map location in each line of the bitmaps. The word before it is all obstacles so that
+     * jumps towards smaller positions can read a full word behind the locations they check.
+     */
+    static const unsigned line_offset = 64;
+
+    const MapPathfindingTransitions *map_ops; ///< The map.
+    const SingleGoalTest<MapLocation> *single_goal; ///< The goal test.
+    const Heuristic<MapLocation> *heur_func; ///< The heuristic function.
+    const JumpDistanceTable *jump_table; ///< The jump distances, or 0 if jumps are scanned for.
+
+    MapLocation goal; ///< The goal of the current search.
+    unsigned map_width; ///< The width of the map.
+    unsigned map_height; ///< The height of the map.
+
+    unsigned row_words; ///< The number of words in each line of row_bits.
+    unsigned col_words; ///< The number of words in each line of col_bits.
+    std::vector<uint64_t> row_bits; ///< Location (x, y) is bit x + line_offset of line y + 1. Set if empty.
+    std::vector<uint64_t> col_bits; ///< Location (x, y) is bit y + line_offset of line x + 1. Set if empty.
+
+    OpenClosedList<MapLocation, MapDir> open_closed_list; ///< The open and closed list.
+
+    uint64_t unique_goal_tests; ///< The number of unique goal tests performed.
+};
+
+inline uint64_t JumpPointSearch::getLineBits(const std::vector<uint64_t>& lines, unsigned words, unsigned line,
+        unsigned start)
+{
+    const uint64_t *line_start = &lines[line * words + start / 64];
+    unsigned shift = start % 64;
+
+    if(shift == 0)
+        return line_start[0];
+    return (line_start[0] >> shift) | (line_start[1] << (64 - shift));
+}
+
+inline bool JumpPointSearch::isEmpty(int x_loc, int y_loc) const
+{
+    unsigned bit = x_loc + line_offset;
+    return (row_bits[(y_loc + 1) * row_words + bit / 64] >> (bit % 64)) & 1;
+}
+
+#endif /* JUMP_POINT_SEARCH_H_ */
@@ -0,0 +1,420 @@
+/*
+ * compressed_path_database.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "compressed_path_database.h"
+#include "../../domains/map_pathfinding/map_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+namespace
+{
+/// Identifies compressed path database files.
+const char file_magic[8] = {'M', 'A', 'P', 'C', 'P', 'D', '\0', '\0'};
+
+/// The version of the file format.
+const uint32_t file_version = 1;
+
+/// The number of source locations a thread takes at a time when building.
+const unsigned sources_per_chunk = 64;
+
+/**
+ * Returns the position of the given point on a Hilbert curve over a square with the given side length, which must be
+ * a power of 2.
+ */
+uint64_t getHilbertIndex(uint64_t side, uint64_t x, uint64_t y)
+{
+    uint64_t index = 0;
+    for(uint64_t s = side / 2; s > 0; s /= 2) {
+        uint64_t rx = (x & s) > 0 ? 1 : 0;
+        uint64_t ry = (y & s) > 0 ? 1 : 0;
+        index += s * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant so the curve inside it has the standard orientation
+        if(ry == 0) {
+            if(rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+}
+
+const uint32_t CompressedPathDatabase::no_region;
+const unsigned CompressedPathDatabase::run_move_bits;
+
+CompressedPathDatabase::CompressedPathDatabase()
+        : map_width(0), map_height(0), map_hash(0), four_connected(true), diag_cost(0.0), cell_order(CellOrder::dfs),
+                cell_ranks(0), cell_regions(0), run_offsets(0), first_move_runs(0), num_runs(0)
+{
+}
+
+CompressedPathDatabase::~CompressedPathDatabase()
+{
+    clear();
+}
+
+bool CompressedPathDatabase::build(const MapPathfindingTransitions& map, CellOrder order, unsigned num_threads)
+{
+    clear();
+
+    unsigned width = map.getMapWidth();
+    unsigned height = map.getMapHeight();
+    std::size_t num_locations = (std::size_t) width * height;
+    if(num_locations >= (UINT32_MAX >> run_move_bits)) {
+        cerr << "Map is too large to build a compressed path database for." << endl;
+        return false;
+    }
+
+    vector<uint32_t> locations;
+    orderLocations(map, order, locations);
+
+    vector<uint32_t> ranks(num_locations, UINT32_MAX);
+    for(uint32_t r = 0; r < locations.size(); r++)
+        ranks[locations[r]] = r;
+
+    // The regions are the components the map has labelled, so a target is reachable if it is in the source's region
+    vector<uint32_t> regions(num_locations);
+    for(std::size_t loc = 0; loc < num_locations; loc++)
+        regions[loc] = map.getComponent(MapLocation(loc % width, loc / width));
+
+    // Each thread takes chunks of sources and appends their runs to that chunk's list, so the lists can be joined in
+    // order afterwards
+    if(num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::size_t num_chunks = (num_locations + sources_per_chunk - 1) / sources_per_chunk;
+    num_threads = std::max<std::size_t>(1, std::min<std::size_t>(num_threads, num_chunks));
+
+    vector<vector<uint32_t> > chunk_runs(num_chunks);
+    vector<uint32_t> source_num_runs(num_locations, 0);
+    std::atomic<std::size_t> next_chunk(0);
+
+    auto compress_sources = [&]() {
+        vector<double> distances;
+        vector<uint8_t> first_moves;
+
+        for(std::size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+            std::size_t end = std::min<std::size_t>(num_locations, (chunk + 1) * sources_per_chunk);
+            for(std::size_t source = chunk * sources_per_chunk; source < end; source++) {
+                if(regions[source] == no_region)
+                    continue;
+                compute_map_distances(map, source, distances, 0, &first_moves);
+
+                // Targets in other regions and the source itself are skipped, so they join the run before them
+                uint8_t last_move = (uint8_t) MapDir::dummy;
+                for(uint32_t r = 0; r < locations.size(); r++) {
+                    uint32_t target = locations[r];
+                    if(target == source || regions[target] != regions[source])
+                        continue;
+
+                    if(first_moves[target] != last_move) {
+                        last_move = first_moves[target];
+                        chunk_runs[chunk].push_back((r << run_move_bits) | last_move);
+                        source_num_runs[source]++;
+                    }
+                }
+            }
+        }
+    };
+
+    vector<std::thread> workers;
+    for(unsigned t = 1; t < num_threads; t++)
+        workers.push_back(std::thread(compress_sources));
+    compress_sources();
+    for(std::thread &worker : workers)
+        worker.join();
+
+    std::size_t total_runs = 0;
+    for(const vector<uint32_t> &runs : chunk_runs)
+        total_runs += runs.size();
+    if(total_runs > UINT32_MAX) {
+        cerr << "Map has too many first move runs to store in a compressed path database." << endl;
+        return false;
+    }
+
+    built_offsets.resize(num_locations + 1);
+    built_offsets[0] = 0;
+    for(std::size_t loc = 0; loc < num_locations; loc++)
+        built_offsets[loc + 1] = built_offsets[loc] + source_num_runs[loc];
+
+    built_runs.reserve(total_runs);
+    for(vector<uint32_t> &runs : chunk_runs) {
+        built_runs.insert(built_runs.end(), runs.begin(), runs.end());
+        vector<uint32_t>().swap(runs);
+    }
+
+    built_ranks.swap(ranks);
+    built_regions.swap(regions);
+
+    map_width = width;
+    map_height = height;
+    map_hash = map.computeMapHash();
+    four_connected = map.is4Connected();
+    diag_cost = map.getActionCost(MapLocation(0, 0), MapDir::northeast);
+    cell_order = order;
+
+    setArrays(built_ranks.data(), built_regions.data(), built_offsets.data(), built_runs.data(), built_runs.size());
+    return true;
+}
+
+bool CompressedPathDatabase::saveFile(const std::string& file_name) const
+{
+    if(isEmpty()) {
+        cerr << "Can't save an empty compressed path database." << endl;
+        return false;
+    }
+
+    std::ofstream out_stream(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(out_stream.fail()) {
+        cerr << "Could not open compressed path database file " << file_name << " for writing." << endl;
+        return false;
+    }
+
+    FileHeader header = makeFileHeader(map_width, map_height, four_connected, diag_cost, map_hash, cell_order,
+            num_runs);
+    out_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::size_t num_locations = (std::size_t) map_width * map_height;
+    out_stream.write(reinterpret_cast<const char *>(cell_ranks), num_locations * sizeof(uint32_t));
+    out_stream.write(reinterpret_cast<const char *>(cell_regions), num_locations * sizeof(uint32_t));
+    out_stream.write(reinterpret_cast<const char *>(run_offsets), (num_locations + 1) * sizeof(uint32_t));
+    out_stream.write(reinterpret_cast<const char *>(first_move_runs), num_runs * sizeof(uint32_t));
+
+    if(!out_stream.good()) {
+        cerr << "Writing compressed path database file " << file_name << " failed." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool CompressedPathDatabase::loadFile(const std::string& file_name, const MapPathfindingTransitions& map)
+{
+    clear();
+
+    if(!file.open(file_name)) {
+        cerr << "Could not open compressed path database file " << file_name << "." << endl;
+        return false;
+    }
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    if(file.getSize() >= sizeof(header))
+        memcpy(&header, file.getData(), sizeof(header));
+
+    // The header is compared against the one the map would give, taking the order and size from the file
+    FileHeader expected = makeFileHeader(map.getMapWidth(), map.getMapHeight(), map.is4Connected(),
+            map.getActionCost(MapLocation(0, 0), MapDir::northeast), map.computeMapHash(),
+            (CellOrder) header.cell_order, header.num_runs);
+
+    std::size_t num_locations = (std::size_t) map.getMapWidth() * map.getMapHeight();
+    std::size_t file_size = sizeof(header) + (3 * num_locations + 1 + header.num_runs) * sizeof(uint32_t);
+
+    if(file.getSize() != file_size || memcmp(&header, &expected, sizeof(header)) != 0
+            || header.cell_order > (uint32_t) CellOrder::hilbert) {
+        clear();
+        cerr << "Compressed path database file " << file_name << " does not match the map." << endl;
+        return false;
+    }
+
+    const uint32_t *arrays = reinterpret_cast<const uint32_t *>(file.getData() + sizeof(header));
+    if(arrays[3 * num_locations] != header.num_runs) {
+        clear();
+        cerr << "Compressed path database file " << file_name << " is corrupt." << endl;
+        return false;
+    }
+
+    map_width = header.map_width;
+    map_height = header.map_height;
+    map_hash = header.map_hash;
+    four_connected = header.four_connected == 1;
+    diag_cost = header.diag_cost;
+    cell_order = (CellOrder) header.cell_order;
+
+    setArrays(arrays, arrays + num_locations, arrays + 2 * num_locations, arrays + 3 * num_locations + 1,
+            header.num_runs);
+    return true;
+}
+
+bool CompressedPathDatabase::loadOrBuild(const std::string& file_name, const MapPathfindingTransitions& map,
+        CellOrder order, unsigned num_threads)
+{
+    // The file is missing on the first run, so only files that exist are loaded and reported on if they don't fit
+    if(std::ifstream(file_name).good() && loadFile(file_name, map))
+        return true;
+
+    if(!build(map, order, num_threads))
+        return false;
+    saveFile(file_name);
+    return true;
+}
+
+void CompressedPathDatabase::clear()
+{
+    file.close();
+    built_ranks.clear();
+    built_regions.clear();
+    built_offsets.clear();
+    built_runs.clear();
+
+    map_width = 0;
+    map_height = 0;
+    map_hash = 0;
+    four_connected = true;
+    diag_cost = 0.0;
+    cell_order = CellOrder::dfs;
+    setArrays(0, 0, 0, 0, 0);
+}
+
+bool CompressedPathDatabase::isEmpty() const
+{
+    return run_offsets == 0;
+}
+
+MapDir CompressedPathDatabase::getFirstMove(const MapLocation& source, const MapLocation& target) const
+{
+    assert(!isEmpty());
+    assert(source.x < map_width && source.y < map_height && target.x < map_width && target.y < map_height);
+
+    std::size_t source_index = (std::size_t) source.y * map_width + source.x;
+    std::size_t target_index = (std::size_t) target.y * map_width + target.x;
+    if(source_index == target_index || cell_regions[source_index] == no_region
+            || cell_regions[source_index] != cell_regions[target_index])
+        return MapDir::dummy;
+
+    // The run holding the target is the last one starting at or before it
+    uint32_t key = (cell_ranks[target_index] << run_move_bits) | ((1u << run_move_bits) - 1);
+    const uint32_t *begin = first_move_runs + run_offsets[source_index];
+    const uint32_t *end = first_move_runs + run_offsets[source_index + 1];
+    const uint32_t *run = std::upper_bound(begin, end, key);
+    assert(run != begin);
+
+    return (MapDir) (*(run - 1) & ((1u << run_move_bits) - 1));
+}
+
+bool CompressedPathDatabase::getPath(const MapLocation& source, const MapLocation& target,
+        std::vector<MapDir>& path) const
+{
+    path.clear();
+
+    // Every step is on an optimal path, so the path visits each location at most once
+    std::size_t max_steps = (std::size_t) map_width * map_height;
+    MapLocation current = source;
+    while(current != target) {
+        MapDir move = getFirstMove(current, target);
+        if(move == MapDir::dummy || path.size() >= max_steps) {
+            path.clear();
+            return false;
+        }
+
+        path.push_back(move);
+        current.x += map_dir_x[(unsigned) move];
+        current.y += map_dir_y[(unsigned) move];
+    }
+    return true;
+}
+
+std::size_t CompressedPathDatabase::getNumRuns() const
+{
+    return num_runs;
+}
+
+CompressedPathDatabase::FileHeader CompressedPathDatabase::makeFileHeader(unsigned width, unsigned height,
+        bool four_connected, double diag_cost, uint64_t map_hash, CellOrder order, uint64_t num_runs)
+{
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.map_width = width;
+    header.map_height = height;
+    header.four_connected = four_connected ? 1 : 0;
+    header.cell_order = (uint32_t) order;
+    header.reserved = 0;
+    header.diag_cost = four_connected ? 0.0 : diag_cost;
+    header.map_hash = map_hash;
+    header.num_runs = num_runs;
+    return header;
+}
+
+void CompressedPathDatabase::orderLocations(const MapPathfindingTransitions& map, CellOrder order,
+        std::vector<uint32_t>& locations)
+{
+    unsigned width = map.getMapWidth();
+    unsigned height = map.getMapHeight();
+    std::size_t num_locations = (std::size_t) width * height;
+    locations.clear();
+
+    if(order == CellOrder::hilbert) {
+        uint64_t side = 1;
+        while(side < width || side < height)
+            side *= 2;
+
+        vector<std::pair<uint64_t, uint32_t> > indexed;
+        for(uint32_t loc = 0; loc < num_locations; loc++) {
+            if(map.isCellEmpty(loc % width, loc / width))
+                indexed.push_back(std::make_pair(getHilbertIndex(side, loc % width, loc / width), loc));
+        }
+        std::sort(indexed.begin(), indexed.end());
+
+        for(const std::pair<uint64_t, uint32_t> &entry : indexed)
+            locations.push_back(entry.second);
+        return;
+    }
+
+    // Depth-first preorder over all 8 neighbours, so that locations close on the map tend to be close in the order
+    vector<bool> visited(num_locations, false);
+    vector<uint32_t> stack;
+    for(uint32_t start = 0; start < num_locations; start++) {
+        if(visited[start] || !map.isCellEmpty(start % width, start / width))
+            continue;
+
+        stack.push_back(start);
+        while(!stack.empty()) {
+            uint32_t loc = stack.back();
+            stack.pop_back();
+            if(visited[loc])
+                continue;
+            visited[loc] = true;
+            locations.push_back(loc);
+
+            int x = loc % width;
+            int y = loc / width;
+            for(int d = 7; d >= 0; d--) {
+                int next_x = x + map_dir_x[d];
+                int next_y = y + map_dir_y[d];
+                if(map.isCellEmpty(next_x, next_y) && !visited[next_y * width + next_x])
+                    stack.push_back(next_y * width + next_x);
+            }
+        }
+    }
+}
+
+void CompressedPathDatabase::setArrays(const uint32_t* ranks, const uint32_t* regions, const uint32_t* offsets,
+        const uint32_t* runs, std::size_t num_runs)
+{
+    cell_ranks = ranks;
+    cell_regions = regions;
+    run_offsets = offsets;
+    first_move_runs = runs;
+    this->num_runs = num_runs;
+}
@@ -0,0 +1,240 @@
+/*
+ * compressed_path_database.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef COMPRESSED_PATH_DATABASE_H_
+#define COMPRESSED_PATH_DATABASE_H_
+
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+#include "../../utils/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Defines the orders that the locations of a map can be listed in when compressing a path database.
+ *
+ * Below is the meaning of each of the values:
+ *
+ * dfs - the preorder of a depth-first traversal of the map.\n
+ * hilbert - the order of a Hilbert curve over the map.\n
+ *
+ * @class CellOrder
+ */
+enum class CellOrder
+{
+    dfs, hilbert
+};
+
+/**
+ * A compressed path database (CPD) for a static map, which stores the first move of an optimal path between every
+ * pair of locations.
+ *
+ * The empty locations of the map are listed in a fixed order (see CellOrder). For each source location, the first
+ * moves towards the targets in this order are stored as runs of equal moves, so only the position in the order where
+ * each run starts and its move are kept. Orders that keep nearby locations together give long runs. Targets that
+ * can't be reached and the source itself never need a first move, so they are absorbed into the surrounding runs.
+ *
+ * Building runs one Dijkstra search per empty location, split between threads, so it is only suited to maps that are
+ * used for many queries. The database can be saved to a file and memory-mapped back in. The file is written in the
+ * byte order of the machine that wrote it and is rejected if it was made for a different map, connectivity, or
+ * diagonal cost.
+ *
+ * Answering a query needs no search: the path is followed by looking up the first move from each location on it, so
+ * the time taken is proportional to the path length (times the logarithm of the number of runs for a source).
+ *
+ * The database is not copyable since it may own a file mapping.
+ *
+ * @class CompressedPathDatabase
+ */
+class CompressedPathDatabase
+{
+public:
+    /**
+     * Constructs an empty database.
+     */
+    CompressedPathDatabase();
+
+    /**
+     * Releases the database, including any file mapping.
+     */
+    ~CompressedPathDatabase();
+
+    CompressedPathDatabase(const CompressedPathDatabase &) = delete;
+    CompressedPathDatabase &operator=(const CompressedPathDatabase &) = delete;
+
+    /**
+     * Builds the database for the given map, using its current connectivity and diagonal cost.
+     *
+     * Fails if the map is too large for the database format.
+     *
+     * @param map The map.
+     * @param order The order to list locations in for compression.
+     * @param num_threads The number of threads to use. If 0, uses as many as the hardware supports.
+     * @return If the database was built.
+     */
+    bool build(const MapPathfindingTransitions &map, CellOrder order = CellOrder::dfs, unsigned num_threads = 0);
+
+    /**
+     * Saves the database to the file with the given name.
+     *
+     * @param file_name The name of the file to write.
+     * @return If the file was written.
+     */
+    bool saveFile(const std::string &file_name) const;
+
+    /**
+     * Loads the database from the file with the given name by memory-mapping it.
+     *
+     * Fails, leaving the database empty, if the file can't be read or was not made for the given map with its current
+     * connectivity and diagonal cost.
+     *
+     * @param file_name The name of the file to load.
+     * @param map The map the database will be used for.
+     * @return If the database was loaded.
+     */
+    bool loadFile(const std::string &file_name, const MapPathfindingTransitions &map);
+
+    /**
+     * Loads the database from the file with the given name if it was made for the given map. Otherwise builds the
+     * database for the map and saves it to that file. A missing file is not reported as an error, since it is expected
+     * the first time.
+     *
+     * @param file_name The name of the file to use.
+     * @param map The map.
+     * @param order The order to list locations in if the database is built.
+     * @param num_threads The number of threads to build with. If 0, uses as many as the hardware supports.
+     * @return If the database is ready for use. True even if the new database could not be saved.
+     */
+    bool loadOrBuild(const std::string &file_name, const MapPathfindingTransitions &map,
+            CellOrder order = CellOrder::dfs, unsigned num_threads = 0);
+
+    /**
+     * Empties the database.
+     */
+    void clear();
+
+    /**
+     * Checks if the database holds any first moves.
+     *
+     * @return If the database is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns the first move of an optimal path between the given locations.
+     *
+     * @param source The location to move from. Must be on the map.
+     * @param target The location to move to. Must be on the map.
+     * @return The first move, or the dummy action if the locations are the same or there is no path between them.
+     */
+    MapDir getFirstMove(const MapLocation &source, const MapLocation &target) const;
+
+    /**
+     * Finds an optimal path between the given locations by following first moves.
+     *
+     * Unlike the plans returned by search engines, the moves are listed from the source to the target.
+     *
+     * @param source The location to move from. Must be on the map.
+     * @param target The location to move to. Must be on the map.
+     * @param path Set as the moves of the path.
+     * @return If there is a path between the locations.
+     */
+    bool getPath(const MapLocation &source, const MapLocation &target, std::vector<MapDir> &path) const;
+
+    /**
+     * Returns the total number of runs stored, which is the size of the database.
+     *
+     * @return The number of runs.
+     */
+    std::size_t getNumRuns() const;
+
+protected:
+    /**
+     * The header at the start of a database file, which is followed by the location ranks, location regions, run
+     * offsets, and runs, in that order.
+     *
+     * @class FileHeader
+     */
+    struct FileHeader
+    {
+        char magic[8]; ///< Identifies the file as a compressed path database.
+        uint32_t version; ///< The version of the file format.
+        uint32_t map_width; ///< The width of the map.
+        uint32_t map_height; ///< The height of the map.
+        uint32_t four_connected; ///< 1 if the map is 4-connected, 0 if it is 8-connected.
+        uint32_t cell_order; ///< The order used for compression.
+        uint32_t reserved; ///< Unused. Set as 0.
+        double diag_cost; ///< The cost of a diagonal move.
+        uint64_t map_hash; ///< The hash of the map.
+        uint64_t num_runs; ///< The number of runs.
+    };
+
+    /**
+     * Returns the header of a file for a database with the given properties.
+     *
+     * @param width The width of the map.
+     * @param height The height of the map.
+     * @param four_connected If the map is 4-connected.
+     * @param diag_cost The cost of a diagonal move on the map. Ignored if the map is 4-connected.
+     * @param map_hash The hash of the map.
+     * @param order The order used for compression.
+     * @param num_runs The number of runs.
+     * @return The file header.
+     */
+    static FileHeader makeFileHeader(unsigned width, unsigned height, bool four_connected, double diag_cost,
+            uint64_t map_hash, CellOrder order, uint64_t num_runs);
+
+    /**
+     * Lists the empty locations of the map in the given order.
+     *
+     * @param map The map.
+     * @param order The order.
+     * @param locations Set as the indices of the empty locations in order.
+     */
+    static void orderLocations(const MapPathfindingTransitions &map, CellOrder order, std::vector<uint32_t> &locations);
+
+    /**
+     * Sets the arrays to point to the given memory, which must stay valid until the database is cleared.
+     *
+     * @param ranks The position of each location in the order.
+     * @param regions The region of each location.
+     * @param offsets The index of the first run of each location.
+     * @param runs The runs.
+     * @param num_runs The number of runs.
+     */
+    void setArrays(const uint32_t *ranks, const uint32_t *regions, const uint32_t *offsets, const uint32_t *runs,
+            std::size_t num_runs);
+
+    static const uint32_t no_region = MapPathfindingTransitions::no_component; ///< The region of obstacles.
+    static const unsigned run_move_bits = 4; ///< Each run is its starting position shifted by this, plus its move.
+
+    unsigned map_width; ///< The width of the map.
+    unsigned map_height; ///< The height of the map.
+    uint64_t map_hash; ///< The hash of the map.
+    bool four_connected; ///< If the map was 4-connected.
+    double diag_cost; ///< The cost of a diagonal move on the map.
+    CellOrder cell_order; ///< The order used for compression.
+
+    const uint32_t *cell_ranks; ///< The position of each location in the order used for compression.
+    const uint32_t *cell_regions; ///< The connected region of each location.
+    const uint32_t *run_offsets; ///< The runs of location i are between run_offsets[i] and run_offsets[i + 1].
+    const uint32_t *first_move_runs; ///< The runs of first moves.
+    std::size_t num_runs; ///< The number of runs.
+
+    std::vector<uint32_t> built_ranks; ///< The location positions if they were built rather than loaded.
+    std::vector<uint32_t> built_regions; ///< The location regions if they were built rather than loaded.
+    std::vector<uint32_t> built_offsets; ///< The run offsets if they were built rather than loaded.
+    std::vector<uint32_t> built_runs; ///< The runs if they were built rather than loaded.
+
+    MappedFile file; ///< The loaded file, if any.
+};
+
+#endif /* COMPRESSED_PATH_DATABASE_H_ */
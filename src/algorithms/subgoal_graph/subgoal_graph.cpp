@@ -0,0 +1,289 @@
+/*
+ * subgoal_graph.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "subgoal_graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+namespace
+{
+/**
+ * Returns the direction of the diagonal and cardinal moves towards the given offset, and the number of each needed.
+ * The directions are arbitrary if none of that move is needed.
+ */
+void getOctileMoves(int dx, int dy, MapDir &diagonal, unsigned &num_diagonal, MapDir &cardinal, unsigned &num_cardinal)
+{
+    unsigned abs_x = std::abs(dx);
+    unsigned abs_y = std::abs(dy);
+
+    if(dx >= 0)
+        diagonal = dy <= 0 ? MapDir::northeast : MapDir::southeast;
+    else
+        diagonal = dy <= 0 ? MapDir::northwest : MapDir::southwest;
+
+    if(abs_x >= abs_y)
+        cardinal = dx >= 0 ? MapDir::east : MapDir::west;
+    else
+        cardinal = dy >= 0 ? MapDir::south : MapDir::north;
+
+    num_diagonal = std::min(abs_x, abs_y);
+    num_cardinal = std::max(abs_x, abs_y) - num_diagonal;
+}
+
+/**
+ * Checks if the given move can be made from the given location.
+ */
+bool canMove(const MapPathfindingTransitions &map, int x_loc, int y_loc, MapDir dir)
+{
+    return map.getMoveMask(MapLocation(x_loc, y_loc)) & MapPathfindingTransitions::getDirBit(dir);
+}
+}
+
+const uint32_t SubgoalGraph::no_subgoal;
+
+SubgoalGraph::SubgoalGraph()
+        : map_width(0), map_height(0)
+{
+}
+
+SubgoalGraph::~SubgoalGraph()
+{
+}
+
+bool SubgoalGraph::build(const MapPathfindingTransitions& map)
+{
+    clear();
+
+    double diag_cost = map.getActionCost(MapLocation(0, 0), MapDir::northeast);
+    if(!map.is8Connected() || diag_cost <= 1.0 || diag_cost >= 2.0) {
+        cerr << "Subgoal graphs need an 8-connected map with a diagonal cost between 1 and 2." << endl;
+        return false;
+    }
+
+    map_width = map.getMapWidth();
+    map_height = map.getMapHeight();
+    subgoal_indices.assign((std::size_t) map_width * map_height, no_subgoal);
+
+    // A location is a subgoal if it is next to the corner of an obstacle that a diagonal move can't cut
+    for(int y = 0; y < (int) map_height; y++) {
+        for(int x = 0; x < (int) map_width; x++) {
+            if(!map.isCellEmpty(x, y))
+                continue;
+
+            for(unsigned d = 1; d < 8; d += 2) {
+                if(!map.isCellEmpty(x + map_dir_x[d], y + map_dir_y[d]) && map.isCellEmpty(x + map_dir_x[d], y)
+                        && map.isCellEmpty(x, y + map_dir_y[d])) {
+                    subgoal_indices[y * map_width + x] = subgoals.size();
+                    subgoals.push_back(MapLocation(x, y));
+                    break;
+                }
+            }
+        }
+    }
+
+    vector<MapLocation> reached;
+    edge_offsets.push_back(0);
+    for(const MapLocation &subgoal : subgoals) {
+        findDirectHReachable(map, subgoal, 0, reached);
+        for(const MapLocation &loc : reached)
+            edges.push_back(getSubgoalIndex(loc));
+        edge_offsets.push_back(edges.size());
+    }
+    return true;
+}
+
+void SubgoalGraph::clear()
+{
+    map_width = 0;
+    map_height = 0;
+    subgoal_indices.clear();
+    subgoals.clear();
+    edge_offsets.clear();
+    edges.clear();
+}
+
+bool SubgoalGraph::isEmpty() const
+{
+    return edge_offsets.empty();
+}
+
+unsigned SubgoalGraph::getMapWidth() const
+{
+    return map_width;
+}
+
+unsigned SubgoalGraph::getMapHeight() const
+{
+    return map_height;
+}
+
+std::size_t SubgoalGraph::getNumSubgoals() const
+{
+    return subgoals.size();
+}
+
+std::size_t SubgoalGraph::getNumEdges() const
+{
+    return edges.size();
+}
+
+uint32_t SubgoalGraph::getSubgoalIndex(const MapLocation& loc) const
+{
+    assert(loc.x < map_width && loc.y < map_height);
+    return subgoal_indices[loc.y * map_width + loc.x];
+}
+
+const MapLocation& SubgoalGraph::getSubgoal(uint32_t index) const
+{
+    return subgoals[index];
+}
+
+const uint32_t* SubgoalGraph::getNeighboursBegin(uint32_t index) const
+{
+    return edges.data() + edge_offsets[index];
+}
+
+const uint32_t* SubgoalGraph::getNeighboursEnd(uint32_t index) const
+{
+    return edges.data() + edge_offsets[index + 1];
+}
+
+void SubgoalGraph::findDirectHReachable(const MapPathfindingTransitions& map, const MapLocation& source,
+        const MapLocation* extra_target, std::vector<MapLocation>& reached) const
+{
+    reached.clear();
+
+    // Each octant between a diagonal and a cardinal direction is swept one diagonal step at a time. Location (i, j)
+    // is i diagonal moves and j cardinal moves from the source, and is reached from (i - 1, j) or (i, j - 1). Targets
+    // are reached but not passed through. The rows hold if each location of the last row can be passed through.
+    vector<uint8_t> last_row, row;
+    for(unsigned d = 1; d < 8; d += 2) {
+        for(unsigned c = d - 1; c <= d + 1; c += 2) {
+            MapDir diagonal = (MapDir) d;
+            MapDir cardinal = (MapDir) (c % 8);
+            int card_x = map_dir_x[c % 8];
+            int card_y = map_dir_y[c % 8];
+
+            last_row.clear();
+            for(int i = 0;; i++) {
+                int row_x = source.x + i * map_dir_x[d];
+                int row_y = source.y + i * map_dir_y[d];
+
+                row.clear();
+                bool any_open = false;
+                for(int j = 0; j < (int) last_row.size() || (j > 0 && row[j - 1]) || (i == 0 && j == 0); j++) {
+                    int x = row_x + j * card_x;
+                    int y = row_y + j * card_y;
+
+                    bool is_reached;
+                    if(i == 0 && j == 0)
+                        is_reached = true;
+                    else
+                        is_reached = (j < (int) last_row.size() && last_row[j]
+                                && canMove(map, x - map_dir_x[d], y - map_dir_y[d], diagonal))
+                                || (j > 0 && row[j - 1] && canMove(map, x - card_x, y - card_y, cardinal));
+
+                    bool is_open = is_reached;
+                    if(is_reached && (i > 0 || j > 0) && isTarget(x, y, extra_target)) {
+                        reached.push_back(MapLocation(x, y));
+                        is_open = false;
+                    }
+                    row.push_back(is_open ? 1 : 0);
+                    any_open |= is_open;
+                }
+
+                if(!any_open)
+                    break;
+                last_row.swap(row);
+            }
+        }
+    }
+
+    // The lines between octants are swept twice
+    std::sort(reached.begin(), reached.end(), [](const MapLocation &loc1, const MapLocation &loc2) {
+        return loc1.y < loc2.y || (loc1.y == loc2.y && loc1.x < loc2.x);
+    });
+    reached.erase(std::unique(reached.begin(), reached.end()), reached.end());
+}
+
+bool SubgoalGraph::refineEdge(const MapPathfindingTransitions& map, const MapLocation& from, const MapLocation& to,
+        std::vector<MapDir>& moves)
+{
+    MapDir diagonal, cardinal;
+    unsigned num_diagonal, num_cardinal;
+    getOctileMoves((int) to.x - (int) from.x, (int) to.y - (int) from.y, diagonal, num_diagonal, cardinal,
+            num_cardinal);
+
+    int diag_x = map_dir_x[(unsigned) diagonal];
+    int diag_y = map_dir_y[(unsigned) diagonal];
+    int card_x = map_dir_x[(unsigned) cardinal];
+    int card_y = map_dir_y[(unsigned) cardinal];
+
+    // Marks which locations between the two can be reached using only the two moves, then walks back from the end
+    unsigned row_size = num_cardinal + 1;
+    vector<uint8_t> is_reached((num_diagonal + 1) * row_size, 0);
+    for(unsigned i = 0; i <= num_diagonal; i++) {
+        for(unsigned j = 0; j <= num_cardinal; j++) {
+            int x = from.x + i * diag_x + j * card_x;
+            int y = from.y + i * diag_y + j * card_y;
+
+            if(i == 0 && j == 0)
+                is_reached[0] = 1;
+            else if(i > 0 && is_reached[(i - 1) * row_size + j] && canMove(map, x - diag_x, y - diag_y, diagonal))
+                is_reached[i * row_size + j] = 1;
+            else if(j > 0 && is_reached[i * row_size + j - 1] && canMove(map, x - card_x, y - card_y, cardinal))
+                is_reached[i * row_size + j] = 1;
+        }
+    }
+
+    if(!is_reached[num_diagonal * row_size + num_cardinal])
+        return false;
+
+    std::size_t first_move = moves.size();
+    unsigned i = num_diagonal, j = num_cardinal;
+    while(i > 0 || j > 0) {
+        int x = from.x + i * diag_x + j * card_x;
+        int y = from.y + i * diag_y + j * card_y;
+
+        if(i > 0 && is_reached[(i - 1) * row_size + j] && canMove(map, x - diag_x, y - diag_y, diagonal)) {
+            moves.push_back(diagonal);
+            i--;
+        } else {
+            moves.push_back(cardinal);
+            j--;
+        }
+    }
+    std::reverse(moves.begin() + first_move, moves.end());
+    return true;
+}
+
+double SubgoalGraph::getOctileDistance(const MapPathfindingTransitions& map, const MapLocation& from,
+        const MapLocation& to)
+{
+    MapDir diagonal, cardinal;
+    unsigned num_diagonal, num_cardinal;
+    getOctileMoves((int) to.x - (int) from.x, (int) to.y - (int) from.y, diagonal, num_diagonal, cardinal,
+            num_cardinal);
+
+    return num_diagonal * map.getActionCost(from, diagonal) + num_cardinal * map.getActionCost(from, cardinal);
+}
+
+bool SubgoalGraph::isTarget(int x_loc, int y_loc, const MapLocation* extra_target) const
+{
+    if(extra_target && extra_target->x == x_loc && extra_target->y == y_loc)
+        return true;
+    return subgoal_indices[y_loc * map_width + x_loc] != no_subgoal;
+}
@@ -0,0 +1,189 @@
+/*
+ * subgoal_graph.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef SUBGOAL_GRAPH_H_
+#define SUBGOAL_GRAPH_H_
+
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A simple subgoal graph for an 8-connected map.
+ *
+ * The subgoals are the empty locations at the corners of obstacles: those with an obstacle diagonally adjacent to them
+ * whose two cardinal neighbours next to the obstacle are empty. Two locations are h-reachable if there is a path
+ * between them whose length is the octile distance, and such a path only ever uses the diagonal and cardinal move
+ * that point towards the other location. Each subgoal has an edge to every subgoal that is h-reachable from it without
+ * passing through another subgoal, so the graph is much smaller than the map.
+ *
+ * To find a path, the start and goal are connected to the subgoals they can reach in the same way, and the graph is
+ * searched with the octile distances as edge costs (see SubgoalGraphSearch). The costs found are optimal, and each
+ * edge is refined back into single moves.
+ *
+ * The graph must be rebuilt if the map changes. It does not depend on the diagonal cost as long as it is strictly
+ * between 1 and 2, since those are the costs for which octile paths only use the two moves towards their end.
+ *
+ * @class SubgoalGraph
+ */
+class SubgoalGraph
+{
+public:
+    /**
+     * Constructs an empty graph.
+     */
+    SubgoalGraph();
+
+    /**
+     * Destructor for the graph. Does nothing.
+     */
+    ~SubgoalGraph();
+
+    /**
+     * Places the subgoals on the given map and connects them.
+     *
+     * Fails if the map is not 8-connected, or its diagonal cost is not strictly between 1 and 2.
+     *
+     * @param map The map.
+     * @return If the graph was built.
+     */
+    bool build(const MapPathfindingTransitions &map);
+
+    /**
+     * Empties the graph.
+     */
+    void clear();
+
+    /**
+     * Checks if the graph has been built.
+     *
+     * @return If the graph is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns the width of the map the graph was built for.
+     *
+     * @return The width of the map.
+     */
+    unsigned getMapWidth() const;
+
+    /**
+     * Returns the height of the map the graph was built for.
+     *
+     * @return The height of the map.
+     */
+    unsigned getMapHeight() const;
+
+    /**
+     * Returns the number of subgoals.
+     *
+     * @return The number of subgoals.
+     */
+    std::size_t getNumSubgoals() const;
+
+    /**
+     * Returns the number of edges, counting each direction separately.
+     *
+     * @return The number of edges.
+     */
+    std::size_t getNumEdges() const;
+
+    /**
+     * Returns the index of the subgoal at the given location.
+     *
+     * @param loc The location. Must be on the map.
+     * @return The index of the subgoal, or no_subgoal if the location is not a subgoal.
+     */
+    uint32_t getSubgoalIndex(const MapLocation &loc) const;
+
+    /**
+     * Returns the location of the subgoal with the given index.
+     *
+     * @param index The index of the subgoal.
+     * @return The location of the subgoal.
+     */
+    const MapLocation &getSubgoal(uint32_t index) const;
+
+    /**
+     * Returns the first of the indices of the subgoals connected to the given subgoal. The rest follow it, up to
+     * getNeighboursEnd.
+     *
+     * @param index The index of the subgoal.
+     * @return A pointer to the first neighbour.
+     */
+    const uint32_t *getNeighboursBegin(uint32_t index) const;
+
+    /**
+     * Returns the end of the indices of the subgoals connected to the given subgoal.
+     *
+     * @param index The index of the subgoal.
+     * @return A pointer past the last neighbour.
+     */
+    const uint32_t *getNeighboursEnd(uint32_t index) const;
+
+    /**
+     * Finds the subgoals that are h-reachable from the given location without passing through another subgoal.
+     *
+     * @param map The map the graph was built for.
+     * @param source The location to search from.
+     * @param extra_target A location to find as if it were a subgoal, or 0 if there is none.
+     * @param reached Set as the locations found, each listed once. Does not include the source.
+     */
+    void findDirectHReachable(const MapPathfindingTransitions &map, const MapLocation &source,
+            const MapLocation *extra_target, std::vector<MapLocation> &reached) const;
+
+    /**
+     * Finds a path between two h-reachable locations and adds its moves to the end of the given list.
+     *
+     * @param map The map.
+     * @param from The location to move from.
+     * @param to The location to move to.
+     * @param moves The list of moves to add to.
+     * @return If the locations are h-reachable.
+     */
+    static bool refineEdge(const MapPathfindingTransitions &map, const MapLocation &from, const MapLocation &to,
+            std::vector<MapDir> &moves);
+
+    /**
+     * Returns the octile distance between the given locations on the given map.
+     *
+     * @param map The map.
+     * @param from One of the locations.
+     * @param to The other location.
+     * @return The octile distance.
+     */
+    static double getOctileDistance(const MapPathfindingTransitions &map, const MapLocation &from,
+            const MapLocation &to);
+
+    static const uint32_t no_subgoal = UINT32_MAX; ///< Marks a location that is not a subgoal.
+
+protected:
+    /**
+     * Checks if the given location is a subgoal, or is the extra target, if there is one.
+     *
+     * @param x_loc The x coordinate of the location.
+     * @param y_loc The y coordinate of the location.
+     * @param extra_target The extra target, or 0 if there is none.
+     * @return If the location is a target.
+     */
+    bool isTarget(int x_loc, int y_loc, const MapLocation *extra_target) const;
+
+    unsigned map_width; ///< The width of the map.
+    unsigned map_height; ///< The height of the map.
+
+    std::vector<uint32_t> subgoal_indices; ///< The subgoal index of each location, or no_subgoal.
+    std::vector<MapLocation> subgoals; ///< The location of each subgoal.
+    std::vector<uint32_t> edge_offsets; ///< The neighbours of subgoal i start at edge_offsets[i].
+    std::vector<uint32_t> edges; ///< The subgoal indices of the neighbours of each subgoal.
+};
+
+#endif /* SUBGOAL_GRAPH_H_ */
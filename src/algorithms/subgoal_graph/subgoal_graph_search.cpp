@@ -0,0 +1,264 @@
+/*
+ * subgoal_graph_search.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "subgoal_graph_search.h"
+
+#include <algorithm>
+
+namespace
+{
+/**
+ * Returns the direction of the first move of an octile path between the given locations if it is a straight line,
+ * or its diagonal move otherwise. This is only used to label the edge, since the generating action of a node must not
+ * be the dummy action.
+ */
+MapDir getEdgeDir(const MapLocation &from, const MapLocation &to)
+{
+    if(to.x == from.x)
+        return to.y < from.y ? MapDir::north : MapDir::south;
+    if(to.y == from.y)
+        return to.x < from.x ? MapDir::west : MapDir::east;
+    if(to.x > from.x)
+        return to.y < from.y ? MapDir::northeast : MapDir::southeast;
+    return to.y < from.y ? MapDir::northwest : MapDir::southwest;
+}
+}
+
+SubgoalGraphSearch::SubgoalGraphSearch()
+        : map_ops(0), single_goal(0), heur_func(0), subgoal_graph(0), map_width(0), search_stamp(0),
+                unique_goal_tests(0)
+{
+    // Cell indices are a perfect hash of the locations
+    open_closed_list.setNodeTableBackend(NodeTableBackend::direct_index);
+}
+
+SubgoalGraphSearch::~SubgoalGraphSearch()
+{
+}
+
+void SubgoalGraphSearch::setTransitionSystem(const MapPathfindingTransitions* map)
+{
+    map_ops = map;
+    map_width = map->getMapWidth();
+    open_closed_list.reserveHashRange((StateHash) map_width * map->getMapHeight());
+
+    SearchEngine<MapLocation, MapDir>::setTransitionSystem(map);
+}
+
+void SubgoalGraphSearch::setGoalTest(const SingleGoalTest<MapLocation>* goal)
+{
+    single_goal = goal;
+    SearchEngine<MapLocation, MapDir>::setGoalTest(goal);
+}
+
+void SubgoalGraphSearch::setHeuristic(const Heuristic<MapLocation>* heur)
+{
+    heur_func = heur;
+}
+
+void SubgoalGraphSearch::setSubgoalGraph(const SubgoalGraph* graph)
+{
+    subgoal_graph = graph;
+    goal_link_stamps.assign(graph->getNumSubgoals(), 0);
+    search_stamp = 0;
+    resetEngine();
+}
+
+void SubgoalGraphSearch::setTieBreaker(TieBreakType type)
+{
+    open_closed_list.getTieBreaker().setType(type);
+}
+
+uint64_t SubgoalGraphSearch::getUniqueGoalTests() const
+{
+    return unique_goal_tests;
+}
+
+SearchTermType SubgoalGraphSearch::searchForPlan(const MapLocation& init_state)
+{
+    BfsExpansionResult exp_result = BfsExpansionResult::no_solution;
+
+    goal = single_goal->getCurrentGoal();
+
+    search_stamp++;
+    if(search_stamp == 0) {
+        std::fill(goal_link_stamps.begin(), goal_link_stamps.end(), 0);
+        search_stamp = 1;
+    }
+
+    if(subgoal_graph->getSubgoalIndex(goal) == SubgoalGraph::no_subgoal) {
+        subgoal_graph->findDirectHReachable(*map_ops, goal, 0, reached);
+        for(const MapLocation &loc : reached)
+            goal_link_stamps[subgoal_graph->getSubgoalIndex(loc)] = search_stamp;
+    }
+
+    double init_h = heur_func->computeHValue(init_state);
+    incrementHCompCount();
+
+    open_closed_list.addInitialNodeToOpen(init_state, MapDir::dummy, init_state.y * map_width + init_state.x, init_h,
+            init_h);
+
+    while(exp_result == BfsExpansionResult::no_solution)
+        exp_result = nodeExpansion();
+
+    if(exp_result == BfsExpansionResult::res_limit)
+        return SearchTermType::res_limit;
+    return SearchTermType::completed;
+}
+
+void SubgoalGraphSearch::resetStatistics()
+{
+    SearchEngine<MapLocation, MapDir>::resetStatistics();
+    unique_goal_tests = 0;
+}
+
+bool SubgoalGraphSearch::isConfigured() const
+{
+    if(!heur_func || !map_ops || !single_goal || !subgoal_graph)
+        return false;
+
+    // the base class setters may have been used to replace the map or goal test
+    if(op_system != map_ops || goal_test != single_goal)
+        return false;
+
+    if(!map_ops->is8Connected() || subgoal_graph->isEmpty() || subgoal_graph->getMapWidth() != map_ops->getMapWidth()
+            || subgoal_graph->getMapHeight() != map_ops->getMapHeight()
+            || goal_link_stamps.size() != subgoal_graph->getNumSubgoals())
+        return false;
+
+    return SearchEngine<MapLocation, MapDir>::isConfigured();
+}
+
+void SubgoalGraphSearch::resetEngine()
+{
+    open_closed_list.clear();
+    SearchEngine<MapLocation, MapDir>::resetEngine();
+}
+
+BfsExpansionResult SubgoalGraphSearch::nodeExpansion()
+{
+    if(open_closed_list.isOpenEmpty())
+        return BfsExpansionResult::empty_open;
+
+    NodeID to_expand_id = open_closed_list.getBestNodeAndClose();
+
+    // copied since adding nodes may move the stored states
+    MapLocation to_expand_state = open_closed_list.getState(to_expand_id);
+
+    if(hitGoalTestLimit())
+        return BfsExpansionResult::res_limit;
+
+    incrementGoalTestCount();
+    if(!open_closed_list.isReopened(to_expand_id))
+        unique_goal_tests++;
+
+    if(goal_test->isGoal(to_expand_state)) {
+        extractSolutionPath(to_expand_id);
+        return BfsExpansionResult::goal_found;
+    }
+
+    if(hitSuccFuncLimit())
+        return BfsExpansionResult::res_limit;
+
+    incrementSuccFuccCalls();
+
+    BfsExpansionResult result = BfsExpansionResult::no_solution;
+    uint32_t index = subgoal_graph->getSubgoalIndex(to_expand_state);
+
+    if(index == SubgoalGraph::no_subgoal) {
+        // only the start can be expanded without being a subgoal
+        subgoal_graph->findDirectHReachable(*map_ops, to_expand_state, &goal, reached);
+        increaseActionGenCount(reached.size());
+
+        for(unsigned i = 0; i < reached.size() && result == BfsExpansionResult::no_solution; i++)
+            result = generateChild(to_expand_id, to_expand_state, reached[i]);
+        return result;
+    }
+
+    const uint32_t *neighbours_end = subgoal_graph->getNeighboursEnd(index);
+    for(const uint32_t *neighbour = subgoal_graph->getNeighboursBegin(index);
+            neighbour != neighbours_end && result == BfsExpansionResult::no_solution; neighbour++) {
+        increaseActionGenCount(1);
+        result = generateChild(to_expand_id, to_expand_state, subgoal_graph->getSubgoal(*neighbour));
+    }
+
+    if(result == BfsExpansionResult::no_solution && goal_link_stamps[index] == search_stamp) {
+        increaseActionGenCount(1);
+        result = generateChild(to_expand_id, to_expand_state, goal);
+    }
+
+    return result;
+}
+
+BfsExpansionResult SubgoalGraphSearch::generateChild(NodeID parent_id, const MapLocation& parent_state,
+        const MapLocation& child_state)
+{
+    incrementStateGenCount();
+
+    double child_g = open_closed_list.getGCost(parent_id)
+            + SubgoalGraph::getOctileDistance(*map_ops, parent_state, child_state);
+    MapDir dir = getEdgeDir(parent_state, child_state);
+    StateHash child_hash = child_state.y * map_width + child_state.x;
+
+    NodeID child_id;
+    StateLocation location = open_closed_list.getStateLocation(child_state, child_hash, child_id);
+
+    if(location == StateLocation::open || location == StateLocation::closed) {
+        if(fp_less(child_g, open_closed_list.getGCost(child_id))) {
+            open_closed_list.setNodePath(child_id, parent_id, dir, child_g,
+                    child_g + open_closed_list.getHValue(child_id));
+
+            if(location == StateLocation::open)
+                open_closed_list.openNodeEvalChanged(child_id);
+            else
+                open_closed_list.reopenNode(child_id);
+        }
+    } else {
+        if(hitHCompLimit())
+            return BfsExpansionResult::res_limit;
+
+        incrementHCompCount();
+        double child_h = heur_func->computeHValue(child_state);
+
+        open_closed_list.addNewNodeToOpen(child_state, dir, child_hash, child_g, child_h, child_g + child_h,
+                parent_id);
+    }
+
+    return BfsExpansionResult::no_solution;
+}
+
+void SubgoalGraphSearch::extractSolutionPath(NodeID path_end_id)
+{
+    incumbent_cost = 0.0;
+    incumbent_plan.clear();
+
+    std::vector<MapLocation> path_states;
+    NodeID id = path_end_id;
+    path_states.push_back(open_closed_list.getState(id));
+    while(open_closed_list.getGenAction(id) != MapDir::dummy) {
+        id = open_closed_list.getParent(id);
+        path_states.push_back(open_closed_list.getState(id));
+    }
+
+    // the edges are refined from the start, and the plan is then reversed to end with the first move like other plans
+    for(unsigned i = path_states.size() - 1; i > 0; i--) {
+        bool refined = SubgoalGraph::refineEdge(*map_ops, path_states[i], path_states[i - 1], incumbent_plan);
+        assert(refined);
+        (void) refined;
+    }
+
+    MapLocation current = path_states.back();
+    for(MapDir dir : incumbent_plan) {
+        incumbent_cost += map_ops->getActionCost(current, dir);
+        map_ops->applyAction(current, dir);
+    }
+    std::reverse(incumbent_plan.begin(), incumbent_plan.end());
+
+    assert(!fp_greater(incumbent_cost, open_closed_list.getGCost(path_end_id)));
+}
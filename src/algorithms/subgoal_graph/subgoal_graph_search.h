@@ -0,0 +1,136 @@
+/*
+ * subgoal_graph_search.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef SUBGOAL_GRAPH_SEARCH_H_
+#define SUBGOAL_GRAPH_SEARCH_H_
+
+#include "../best_first_search/best_first_search.h"
+#include "../../domains/map_pathfinding/map_pathfinding_transitions.h"
+#include "../../generic_defs/single_goal_test.h"
+#include "subgoal_graph.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * A* over a simple subgoal graph of an 8-connected map (see SubgoalGraph).
+ *
+ * At the start of each search, the goal is linked to the subgoals that are directly h-reachable from it unless it is
+ * a subgoal itself. Expanding a subgoal generates its neighbours in the graph and the goal if it is linked. If the
+ * start is not a subgoal, expanding it generates the subgoals directly h-reachable from it and the goal if it is. Each
+ * edge costs the octile distance between its ends, so the heuristic should not be larger than the octile distance.
+ *
+ * The costs found are those of A* on the same map, and the plans returned are full sequences of single moves. The
+ * goal test count is the number of expansions, and the state and action generation counts are the number of edges
+ * followed.
+ *
+ * The map must be 8-connected with a diagonal cost strictly between 1 and 2, and the goal test must be a single goal
+ * test. The graph must be built for the map that is searched on.
+ *
+ * @class SubgoalGraphSearch
+ */
+class SubgoalGraphSearch: public SearchEngine<MapLocation, MapDir>
+{
+public:
+    SubgoalGraphSearch();
+    virtual ~SubgoalGraphSearch();
+
+    /**
+     * Sets the map to search on.
+     *
+     * @param map The map. Must be 8-connected.
+     */
+    void setTransitionSystem(const MapPathfindingTransitions *map);
+
+    /**
+     * Sets the goal test. The goal is read from the goal test at the start of each search.
+     *
+     * @param goal The goal test.
+     */
+    void setGoalTest(const SingleGoalTest<MapLocation> *goal);
+
+    /**
+     * Sets the heuristic function used by the search.
+     *
+     * @param heur A pointer to the heuristic function to use.
+     */
+    void setHeuristic(const Heuristic<MapLocation> *heur);
+
+    /**
+     * Sets the subgoal graph to search. It must have been built for the map that is searched on.
+     *
+     * @param graph The subgoal graph.
+     */
+    void setSubgoalGraph(const SubgoalGraph *graph);
+
+    /**
+     * Sets the rule used to break ties between nodes with equal evaluations.
+     *
+     * @param type The tie-breaking rule to use.
+     */
+    void setTieBreaker(TieBreakType type);
+
+    /**
+     * Returns the number of unique goal tests.
+     *
+     * @return The number of unique goal tests.
+     */
+    uint64_t getUniqueGoalTests() const;
+
+protected:
+    // Overloaded functions
+    virtual SearchTermType searchForPlan(const MapLocation &init_state);
+    virtual void resetStatistics();
+    virtual bool isConfigured() const;
+    virtual void resetEngine();
+
+    /**
+     * Expands a single node and returns the result of the expansion (regarding if a solution as found or not).
+     *
+     * @return The result of the node expansion.
+     */
+    BfsExpansionResult nodeExpansion();
+
+    /**
+     * Generates the child at the given location for the node being expanded.
+     *
+     * @param parent_id The node being expanded.
+     * @param parent_state The location of the node being expanded.
+     * @param child_state The location of the child.
+     * @return The result of the generation, which is no_solution unless a resource limit is hit.
+     */
+    BfsExpansionResult generateChild(NodeID parent_id, const MapLocation &parent_state,
+            const MapLocation &child_state);
+
+    /**
+     * Extracts the path that ends at the node for the given id and stores it as the incumbent plan, with each edge
+     * replaced by its single moves.
+     *
+     * @param path_end_id The node at the end of the path.
+     */
+    void extractSolutionPath(NodeID path_end_id);
+
+    const MapPathfindingTransitions *map_ops; ///< The map.
+    const SingleGoalTest<MapLocation> *single_goal; ///< The goal test.
+    const Heuristic<MapLocation> *heur_func; ///< The heuristic function.
+    const SubgoalGraph *subgoal_graph; ///< The subgoal graph.
+
+    MapLocation goal; ///< The goal of the current search.
+    unsigned map_width; ///< The width of the map.
+
+    std::vector<uint32_t> goal_link_stamps; ///< Set as search_stamp for each subgoal linked to the goal.
+    uint32_t search_stamp; ///< Identifies the current search.
+    std::vector<MapLocation> reached; ///< Holds the locations found by h-reachability checks.
+
+    OpenClosedList<MapLocation, MapDir> open_closed_list; ///< The open and closed list.
+
+    uint64_t unique_goal_tests; ///< The number of unique goal tests performed.
+};
+
+#endif /* SUBGOAL_GRAPH_SEARCH_H_ */
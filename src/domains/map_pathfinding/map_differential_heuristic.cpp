@@ -0,0 +1,37 @@
+/*
+ * map_differential_heuristic.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "map_differential_heuristic.h"
+
+MapDifferentialHeuristic::MapDifferentialHeuristic()
+        : table(0), goal_offset(0)
+{
+}
+
+MapDifferentialHeuristic::MapDifferentialHeuristic(const MapDifferentialTable* diff_table)
+        : table(diff_table), goal_offset(0)
+{
+    setGoal(goal);
+}
+
+MapDifferentialHeuristic::~MapDifferentialHeuristic()
+{
+}
+
+void MapDifferentialHeuristic::setTable(const MapDifferentialTable* diff_table)
+{
+    table = diff_table;
+    setGoal(goal);
+}
+
+void MapDifferentialHeuristic::setGoal(const MapLocation& state)
+{
+    goal = state;
+    goal_offset = table ? table->getOffset(goal) : 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * map_differential_heuristic.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef MAP_DIFFERENTIAL_HEURISTIC_H_
+#define MAP_DIFFERENTIAL_HEURISTIC_H_
+
+#include "../../generic_defs/heuristic.h"
+#include "map_differential_table.h"
+#include "map_location.h"
+
+#include <cstddef>
+
+/**
+ * A differential (or landmark) heuristic for map pathfinding, which looks up its values in a MapDifferentialTable.
+ *
+ * The heuristic only holds the goal and a pointer to the table, so each search sets its own goal on its own heuristic
+ * while sharing one table with the others. The goal must be set again after the table is rebuilt or loaded.
+ *
+ * @class MapDifferentialHeuristic
+ */
+class MapDifferentialHeuristic: public Heuristic<MapLocation>
+{
+public:
+    /**
+     * Constructs a differential heuristic with no table, which always returns 0. Assumes a goal of (0,0).
+     */
+    MapDifferentialHeuristic();
+
+    /**
+     * Constructs a differential heuristic that uses the given table. Assumes a goal of (0,0).
+     *
+     * @param diff_table The table, which must outlive the heuristic.
+     */
+    explicit MapDifferentialHeuristic(const MapDifferentialTable *diff_table);
+
+    /**
+     * Destructor for the differential heuristic. Does nothing.
+     */
+    virtual ~MapDifferentialHeuristic();
+
+    /**
+     * Sets the table to use, and finds the current goal in it.
+     *
+     * @param diff_table The table, which must outlive the heuristic.
+     */
+    void setTable(const MapDifferentialTable *diff_table);
+
+    /**
+     * Sets the goal location to the given map location. Must be on the map the table was built for.
+     *
+     * @param state The new goal.
+     */
+    void setGoal(const MapLocation &state);
+
+    // Overloaded methods. Public so that engines that know the type of the heuristic can call it directly.
+    virtual double computeHValue(const MapLocation &state) const;
+
+protected:
+    const MapDifferentialTable *table; ///< The table of distances from the pivots.
+    MapLocation goal; ///< The goal location currently being used.
+    std::size_t goal_offset; ///< The location in the table of the goal's distances.
+};
+
+inline double MapDifferentialHeuristic::computeHValue(const MapLocation& state) const
+{
+    if(!table)
+        return 0.0;
+    return table->computeDifference(state, goal_offset);
+}
+
+#endif /* MAP_DIFFERENTIAL_HEURISTIC_H_ */
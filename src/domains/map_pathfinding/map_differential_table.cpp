@@ -0,0 +1,315 @@
+/*
+ * map_differential_table.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "map_differential_table.h"
+#include "map_utils.h"
+#include "../../utils/floating_point_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+namespace
+{
+/// Identifies differential heuristic files.
+const char file_magic[8] = {'M', 'A', 'P', 'D', 'I', 'F', 'F', '\0'};
+
+/// The version of the file format.
+const uint32_t file_version = 1;
+
+/// The number of stored units in a distance of 1 when distances are not integers and stored in 16 bits.
+const double short_fixed_point_scale = 64.0;
+
+/// The number of stored units in a distance of 1 when distances are not integers and stored in 32 bits.
+const double long_fixed_point_scale = 4096.0;
+
+/**
+ * Converts the given distances to the given integer type, with the given number of units in a distance of 1.
+ */
+template<class dist_t>
+void convertDistances(const vector<vector<double> > &pivot_distances, double scale, dist_t unreachable,
+        vector<dist_t> &table)
+{
+    std::size_t num_pivots = pivot_distances.size();
+    std::size_t num_locations = pivot_distances[0].size();
+
+    table.resize(num_locations * num_pivots);
+    for(std::size_t loc = 0; loc < num_locations; loc++) {
+        for(std::size_t i = 0; i < num_pivots; i++) {
+            double distance = pivot_distances[i][loc];
+            table[loc * num_pivots + i] = distance < 0.0 ? unreachable : (dist_t) std::floor(distance * scale);
+        }
+    }
+}
+}
+
+MapDifferentialTable::MapDifferentialTable()
+        : map_width(0), map_height(0), four_connected(true), diag_cost(ROOT_TWO), map_hash(0), distance_bytes(0),
+                distance_scale(1.0), rounding_slack(0)
+{
+}
+
+MapDifferentialTable::~MapDifferentialTable()
+{
+}
+
+bool MapDifferentialTable::build(const MapPathfindingTransitions& map, unsigned num_pivots, unsigned num_threads)
+{
+    clear();
+
+    vector<unsigned> region;
+    getLargestComponent(map, region);
+    if(region.empty() || num_pivots == 0) {
+        cerr << "Can't place pivots on a map with no empty locations." << endl;
+        return false;
+    }
+
+    unsigned width = map.getMapWidth();
+    vector<double> distances;
+
+    // Farthest-point placement, starting from the location farthest from an arbitrary one. Each new pivot only needs
+    // to search the locations it is closer to than the other pivots, so the bounds are the distances to the closest
+    // pivot so far.
+    compute_map_distances(map, region[0], distances);
+    unsigned farthest = region[0];
+    for(unsigned loc : region) {
+        if(distances[loc] > distances[farthest])
+            farthest = loc;
+    }
+
+    vector<double> bounds(distances.size(), -1.0);
+    for(unsigned loc : region)
+        bounds[loc] = std::numeric_limits<double>::max();
+
+    vector<unsigned> pivot_indices;
+    while(pivot_indices.size() < num_pivots) {
+        if(!pivot_indices.empty()) {
+            for(unsigned loc : region) {
+                if(bounds[loc] > bounds[farthest])
+                    farthest = loc;
+            }
+            if(bounds[farthest] <= 0.0)
+                break; // every location is already a pivot
+        }
+
+        pivot_indices.push_back(farthest);
+        bounds[farthest] = 0.0;
+        compute_map_distances(map, farthest, distances, &bounds);
+    }
+
+    // Compute the distances from each pivot in parallel
+    if(num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = std::min<unsigned>(num_threads, pivot_indices.size());
+
+    vector<vector<double> > pivot_distances(pivot_indices.size());
+    std::atomic<unsigned> next_pivot(0);
+
+    auto compute_pivot_distances = [&]() {
+        for(unsigned i = next_pivot++; i < pivot_indices.size(); i = next_pivot++)
+            compute_map_distances(map, pivot_indices[i], pivot_distances[i]);
+    };
+
+    vector<std::thread> workers;
+    for(unsigned t = 1; t < num_threads; t++)
+        workers.push_back(std::thread(compute_pivot_distances));
+    compute_pivot_distances();
+    for(std::thread &worker : workers)
+        worker.join();
+
+    map_width = width;
+    map_height = map.getMapHeight();
+    four_connected = map.is4Connected();
+    diag_cost = map.getActionCost(MapLocation(0, 0), MapDir::northeast);
+    map_hash = map.computeMapHash();
+
+    for(unsigned loc : pivot_indices)
+        pivots.push_back(MapLocation(loc % width, loc / width));
+
+    if(!storeDistances(pivot_distances, four_connected)) {
+        clear();
+        cerr << "Map distances are too large to store in a differential heuristic." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool MapDifferentialTable::saveFile(const std::string& file_name) const
+{
+    if(pivots.empty()) {
+        cerr << "Can't save a differential heuristic with no pivots." << endl;
+        return false;
+    }
+
+    std::ofstream out_stream(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(out_stream.fail()) {
+        cerr << "Could not open differential heuristic file " << file_name << " for writing." << endl;
+        return false;
+    }
+
+    FileHeader header;
+    memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.map_width = map_width;
+    header.map_height = map_height;
+    header.four_connected = four_connected ? 1 : 0;
+    header.num_pivots = pivots.size();
+    header.distance_bytes = distance_bytes;
+    header.diag_cost = diag_cost;
+    header.distance_scale = distance_scale;
+    header.map_hash = map_hash;
+    out_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for(const MapLocation &pivot : pivots) {
+        uint16_t coords[2] = {pivot.x, pivot.y};
+        out_stream.write(reinterpret_cast<const char *>(coords), sizeof(coords));
+    }
+
+    if(distance_bytes == 2)
+        out_stream.write(reinterpret_cast<const char *>(short_distances.data()), short_distances.size() * 2);
+    else
+        out_stream.write(reinterpret_cast<const char *>(long_distances.data()), long_distances.size() * 4);
+
+    if(!out_stream.good()) {
+        cerr << "Writing differential heuristic file " << file_name << " failed." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool MapDifferentialTable::loadFile(const std::string& file_name, const MapPathfindingTransitions& map)
+{
+    clear();
+
+    std::ifstream in_stream(file_name, std::ios::in | std::ios::binary);
+    if(in_stream.fail()) {
+        cerr << "Could not open differential heuristic file " << file_name << "." << endl;
+        return false;
+    }
+
+    FileHeader header;
+    in_stream.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+    if(!in_stream.good() || memcmp(header.magic, file_magic, sizeof(file_magic)) != 0
+            || header.version != file_version || header.map_width != map.getMapWidth()
+            || header.map_height != map.getMapHeight() || (header.four_connected == 1) != map.is4Connected()
+            || header.diag_cost != map.getActionCost(MapLocation(0, 0), MapDir::northeast)
+            || header.map_hash != map.computeMapHash() || header.num_pivots == 0
+            || (header.distance_bytes != 2 && header.distance_bytes != 4)) {
+        cerr << "Differential heuristic file " << file_name << " does not match the map." << endl;
+        return false;
+    }
+
+    for(unsigned i = 0; i < header.num_pivots; i++) {
+        uint16_t coords[2];
+        in_stream.read(reinterpret_cast<char *>(coords), sizeof(coords));
+        pivots.push_back(MapLocation(coords[0], coords[1]));
+    }
+
+    std::size_t table_size = (std::size_t) header.map_width * header.map_height * header.num_pivots;
+    if(header.distance_bytes == 2) {
+        short_distances.resize(table_size);
+        in_stream.read(reinterpret_cast<char *>(short_distances.data()), table_size * 2);
+    } else {
+        long_distances.resize(table_size);
+        in_stream.read(reinterpret_cast<char *>(long_distances.data()), table_size * 4);
+    }
+
+    if(!in_stream.good() || in_stream.peek() != std::ifstream::traits_type::eof()) {
+        clear();
+        cerr << "Differential heuristic file " << file_name << " is incomplete." << endl;
+        return false;
+    }
+
+    map_width = header.map_width;
+    map_height = header.map_height;
+    four_connected = header.four_connected == 1;
+    diag_cost = header.diag_cost;
+    map_hash = header.map_hash;
+    distance_bytes = header.distance_bytes;
+    distance_scale = header.distance_scale;
+    rounding_slack = four_connected ? 0 : 1;
+    return true;
+}
+
+void MapDifferentialTable::clear()
+{
+    pivots.clear();
+    short_distances.clear();
+    long_distances.clear();
+    distance_bytes = 0;
+    distance_scale = 1.0;
+    rounding_slack = 0;
+}
+
+const std::vector<MapLocation>& MapDifferentialTable::getPivots() const
+{
+    return pivots;
+}
+
+unsigned MapDifferentialTable::getDistanceBytes() const
+{
+    return distance_bytes;
+}
+
+void MapDifferentialTable::getLargestComponent(const MapPathfindingTransitions& map, std::vector<unsigned>& region)
+{
+    unsigned width = map.getMapWidth();
+    std::size_t num_locations = (std::size_t) width * map.getMapHeight();
+    region.clear();
+    if(map.getNumComponents() == 0)
+        return;
+
+    uint32_t largest = MapPathfindingTransitions::no_component;
+    for(unsigned loc = 0; loc < num_locations; loc++) {
+        uint32_t component = map.getComponent(MapLocation(loc % width, loc / width));
+        if(component != MapPathfindingTransitions::no_component && (largest == MapPathfindingTransitions::no_component
+                || map.getComponentSize(component) > map.getComponentSize(largest)))
+            largest = component;
+    }
+
+    region.reserve(map.getComponentSize(largest));
+    for(unsigned loc = 0; loc < num_locations; loc++) {
+        if(map.getComponent(MapLocation(loc % width, loc / width)) == largest)
+            region.push_back(loc);
+    }
+}
+
+bool MapDifferentialTable::storeDistances(const std::vector<std::vector<double> >& pivot_distances, bool exact)
+{
+    double max_distance = 0.0;
+    for(const vector<double> &distances : pivot_distances)
+        max_distance = std::max(max_distance, *std::max_element(distances.begin(), distances.end()));
+
+    rounding_slack = exact ? 0 : 1;
+
+    distance_scale = exact ? 1.0 : short_fixed_point_scale;
+    if(max_distance * distance_scale < UINT16_MAX) {
+        distance_bytes = 2;
+        convertDistances<uint16_t>(pivot_distances, distance_scale, UINT16_MAX, short_distances);
+        return true;
+    }
+
+    distance_scale = exact ? 1.0 : long_fixed_point_scale;
+    if(max_distance * distance_scale < UINT32_MAX) {
+        distance_bytes = 4;
+        convertDistances<uint32_t>(pivot_distances, distance_scale, UINT32_MAX, long_distances);
+        return true;
+    }
+    return false;
+}
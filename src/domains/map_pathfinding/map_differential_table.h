@@ -0,0 +1,230 @@
+/*
+ * map_differential_table.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef MAP_DIFFERENTIAL_TABLE_H_
+#define MAP_DIFFERENTIAL_TABLE_H_
+
+#include "map_location.h"
+#include "map_pathfinding_transitions.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * The precomputed table of a differential (or landmark) heuristic for map pathfinding (see MapDifferentialHeuristic).
+ *
+ * A set of pivot locations is chosen, and the true distance from each pivot to every location is precomputed. By the
+ * triangle inequality, |d(p, s) - d(p, g)| is a lower bound on the distance between s and g for any pivot p, so the
+ * heuristic value is the largest such difference. Unlike the Manhattan and octile distances, this accounts for the
+ * obstacles in the map.
+ *
+ * Pivots are placed in the largest connected component of the map by farthest-point placement: the first pivot is the
+ * location farthest from an arbitrary location in the component, and each next one is the location farthest from all
+ * pivots so far. The distances from the pivots are then computed in parallel, one Dijkstra search per pivot.
+ *
+ * Distances are stored as 16-bit integers if they fit, and as 32-bit integers otherwise. When the map is 8-connected,
+ * they are stored in fixed point and rounded down, and the heuristic subtracts the largest possible rounding error, so
+ * it remains admissible. A pivot is ignored for a location it can't reach.
+ *
+ * The distances depend on the connectivity and diagonal cost of the map, so the table must be rebuilt (or loaded
+ * from another file) if these change. The table holds no goal, so once built or loaded it is only read, and one table
+ * can be shared by the heuristics of searches running in different threads.
+ *
+ * @class MapDifferentialTable
+ */
+class MapDifferentialTable
+{
+public:
+    /**
+     * Constructs a table with no pivots, for which every difference is 0.
+     */
+    MapDifferentialTable();
+
+    /**
+     * Destructor for the table. Does nothing.
+     */
+    ~MapDifferentialTable();
+
+    /**
+     * Places the given number of pivots on the given map and computes the distances from them.
+     *
+     * Fails if the map has no empty locations or the distances are too large to store.
+     *
+     * @param map The map.
+     * @param num_pivots The number of pivots to place. Must be positive.
+     * @param num_threads The number of threads to use. If 0, uses as many as the hardware supports.
+     * @return If the table was built.
+     */
+    bool build(const MapPathfindingTransitions &map, unsigned num_pivots, unsigned num_threads = 0);
+
+    /**
+     * Saves the pivots and distances to the file with the given name.
+     *
+     * @param file_name The name of the file to write.
+     * @return If the file was written.
+     */
+    bool saveFile(const std::string &file_name) const;
+
+    /**
+     * Loads the pivots and distances from the file with the given name.
+     *
+     * Fails, leaving the table without pivots, if the file can't be read or was not made for the given map with its
+     * current connectivity and diagonal cost.
+     *
+     * @param file_name The name of the file to load.
+     * @param map The map the table will be used for.
+     * @return If the file was loaded.
+     */
+    bool loadFile(const std::string &file_name, const MapPathfindingTransitions &map);
+
+    /**
+     * Removes all pivots.
+     */
+    void clear();
+
+    /**
+     * Returns the pivots being used.
+     *
+     * @return The pivots.
+     */
+    const std::vector<MapLocation> &getPivots() const;
+
+    /**
+     * Returns the number of bytes used to store each distance.
+     *
+     * @return The number of bytes used per distance, or 0 if there are no pivots.
+     */
+    unsigned getDistanceBytes() const;
+
+    /**
+     * Returns where the distances of the given location start in the table.
+     *
+     * @param loc The location. Must be on the map the table was built for.
+     * @return The offset of the location's distances.
+     */
+    std::size_t getOffset(const MapLocation &loc) const;
+
+    /**
+     * Computes the lower bound on the distance between the given location and the one whose distances start at the
+     * given offset, which is the largest difference of their distances from a pivot.
+     *
+     * @param state The location. Must be on the map the table was built for.
+     * @param other_offset The offset of the other location's distances, as returned by getOffset.
+     * @return The lower bound, or 0 if there are no pivots.
+     */
+    double computeDifference(const MapLocation &state, std::size_t other_offset) const;
+
+protected:
+    /**
+     * Returns the index of each location in the largest connected component of the map, using the components the map
+     * has labelled.
+     *
+     * @param map The map.
+     * @param region Set as the indices of the locations in the component, or empty if the map has none.
+     */
+    static void getLargestComponent(const MapPathfindingTransitions &map, std::vector<unsigned> &region);
+
+    /**
+     * Stores the given distances from the pivots in the table, converting them to the storage format.
+     *
+     * @param pivot_distances The distances from each pivot to each location.
+     * @param exact If the distances are all integers.
+     * @return If the distances fit in the table.
+     */
+    bool storeDistances(const std::vector<std::vector<double> > &pivot_distances, bool exact);
+
+    /**
+     * Computes the lower bound for computeDifference using the given table of distances.
+     *
+     * @param distances The distance table.
+     * @param unreachable The value used in the table for locations a pivot can't reach.
+     * @param state The location.
+     * @param other_offset The offset of the other location's distances.
+     * @return The lower bound.
+     */
+    template<class dist_t>
+    double computeStoredDifference(const std::vector<dist_t> &distances, dist_t unreachable, const MapLocation &state,
+            std::size_t other_offset) const;
+
+    /**
+     * The header at the start of a saved file, which is followed by the pivots and the distances.
+     *
+     * @class FileHeader
+     */
+    struct FileHeader
+    {
+        char magic[8]; ///< Identifies the file as a differential heuristic.
+        uint32_t version; ///< The version of the file format.
+        uint32_t map_width; ///< The width of the map.
+        uint32_t map_height; ///< The height of the map.
+        uint32_t four_connected; ///< 1 if the map is 4-connected, 0 if it is 8-connected.
+        uint32_t num_pivots; ///< The number of pivots.
+        uint32_t distance_bytes; ///< The number of bytes used for each distance.
+        double diag_cost; ///< The cost of a diagonal move.
+        double distance_scale; ///< The number of stored units in a distance of 1.
+        uint64_t map_hash; ///< The hash of the map.
+    };
+
+    unsigned map_width; ///< The width of the map the table was built for.
+    unsigned map_height; ///< The height of the map the table was built for.
+    bool four_connected; ///< If the map was 4-connected.
+    double diag_cost; ///< The cost of a diagonal move on the map.
+    uint64_t map_hash; ///< The hash of the map.
+
+    std::vector<MapLocation> pivots; ///< The pivots.
+    unsigned distance_bytes; ///< The number of bytes used to store each distance.
+    double distance_scale; ///< The number of stored units in a distance of 1.
+    int64_t rounding_slack; ///< The most stored units a difference can be too large by due to rounding.
+
+    /// The 16-bit distances, if used. The distance from pivot i to location (x, y) is at (y * width + x) * pivots + i.
+    std::vector<uint16_t> short_distances;
+    std::vector<uint32_t> long_distances; ///< The 32-bit distances, if used, stored as for short_distances.
+};
+
+inline std::size_t MapDifferentialTable::getOffset(const MapLocation& loc) const
+{
+    assert(pivots.empty() || (loc.x < map_width && loc.y < map_height));
+    return ((std::size_t) loc.y * map_width + loc.x) * pivots.size();
+}
+
+inline double MapDifferentialTable::computeDifference(const MapLocation& state, std::size_t other_offset) const
+{
+    if(distance_bytes == 2)
+        return computeStoredDifference<uint16_t>(short_distances, UINT16_MAX, state, other_offset);
+    if(distance_bytes == 4)
+        return computeStoredDifference<uint32_t>(long_distances, UINT32_MAX, state, other_offset);
+    return 0.0;
+}
+
+template<class dist_t>
+inline double MapDifferentialTable::computeStoredDifference(const std::vector<dist_t>& distances, dist_t unreachable,
+        const MapLocation& state, std::size_t other_offset) const
+{
+    const dist_t *state_distances = &distances[getOffset(state)];
+    const dist_t *other_distances = &distances[other_offset];
+
+    int64_t max_difference = 0;
+    for(unsigned i = 0; i < pivots.size(); i++) {
+        if(state_distances[i] == unreachable || other_distances[i] == unreachable)
+            continue;
+
+        int64_t difference = std::llabs((int64_t) state_distances[i] - (int64_t) other_distances[i]);
+        if(difference > max_difference)
+            max_difference = difference;
+    }
+
+    if(max_difference <= rounding_slack)
+        return 0.0;
+    return (max_difference - rounding_slack) / distance_scale;
+}
+
+#endif /* MAP_DIFFERENTIAL_TABLE_H_ */
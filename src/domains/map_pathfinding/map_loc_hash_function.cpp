@@ -17,13 +17,6 @@ MapLocHashFunction::~MapLocHashFunction()
 {
 }
 
-StateHash MapLocHashFunction::getStateHash(const MapLocation& state) const
-{
-    //TODO Error checking
-    //TODO Take advantage of 16bit
-    return map_width*((uint64_t)state.x) + ((uint64_t)state.y);
-}
-
 void MapLocHashFunction::setMapDimensions(const MapPathfindingTransitions& ops)
 {
     setMapDimensions(ops.getMapWidth(), ops.getMapHeight());
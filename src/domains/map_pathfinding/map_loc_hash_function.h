@@ -17,6 +17,9 @@
 /**
  * A class for calculating the hash value of a map location.
  *
+ * The hash value is the index of the location in a column-major ordering of the map cells, so the values for a map
+ * are exactly 0 through width * height - 1. This means it can be used with a direct index node table.
+ *
  * @class MapLocHashFunction
  */
 class MapLocHashFunction: public StateHashFunction<MapLocation>
@@ -55,4 +58,11 @@ protected:
     uint64_t map_height; ///< The height of the map. Stored as uint64_t to avoid extra type casting.
 };
 
+inline StateHash MapLocHashFunction::getStateHash(const MapLocation& state) const
+{
+    //TODO Error checking
+    //TODO Take advantage of 16bit
+    return map_height*((uint64_t)state.x) + ((uint64_t)state.y);
+}
+
 #endif /* MAP_LOC_HASH_FUNCTION_H_ */
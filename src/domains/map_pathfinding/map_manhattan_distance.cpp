@@ -9,7 +9,57 @@
 
 #include "map_manhattan_distance.h"
 
-#include <stdlib.h>
+#if SIMD_X86_AVAILABLE
+#include <immintrin.h>
+
+/**
+ * Computes the Manhattan distances of the given states to the goal using AVX2, four states at a time.
+ */
+__attribute__((target("avx2")))
+static std::size_t manhattanDistancesAVX2(const MapLocation &goal, const MapLocation * const *states,
+        std::size_t num_states, double *h_values)
+{
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m256d goal_x = _mm256_set1_pd(goal.x);
+    const __m256d goal_y = _mm256_set1_pd(goal.y);
+
+    std::size_t i = 0;
+    for(; i + 4 <= num_states; i += 4) {
+        __m256d x = _mm256_cvtepi32_pd(_mm_set_epi32(states[i + 3]->x, states[i + 2]->x, states[i + 1]->x,
+                states[i]->x));
+        __m256d y = _mm256_cvtepi32_pd(_mm_set_epi32(states[i + 3]->y, states[i + 2]->y, states[i + 1]->y,
+                states[i]->y));
+
+        __m256d delta_x = _mm256_and_pd(_mm256_sub_pd(goal_x, x), abs_mask);
+        __m256d delta_y = _mm256_and_pd(_mm256_sub_pd(goal_y, y), abs_mask);
+        _mm256_storeu_pd(h_values + i, _mm256_add_pd(delta_x, delta_y));
+    }
+    return i;
+}
+
+/**
+ * Computes the Manhattan distances of the given states to the goal using SSE2, two states at a time.
+ */
+__attribute__((target("sse2")))
+static std::size_t manhattanDistancesSSE2(const MapLocation &goal, const MapLocation * const *states,
+        std::size_t num_states, double *h_values)
+{
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m128d goal_x = _mm_set1_pd(goal.x);
+    const __m128d goal_y = _mm_set1_pd(goal.y);
+
+    std::size_t i = 0;
+    for(; i + 2 <= num_states; i += 2) {
+        __m128d x = _mm_set_pd(states[i + 1]->x, states[i]->x);
+        __m128d y = _mm_set_pd(states[i + 1]->y, states[i]->y);
+
+        __m128d delta_x = _mm_and_pd(_mm_sub_pd(goal_x, x), abs_mask);
+        __m128d delta_y = _mm_and_pd(_mm_sub_pd(goal_y, y), abs_mask);
+        _mm_storeu_pd(h_values + i, _mm_add_pd(delta_x, delta_y));
+    }
+    return i;
+}
+#endif
 
 MapManhattanDistance::MapManhattanDistance()
 {
@@ -30,7 +80,19 @@ void MapManhattanDistance::setGoal(uint16_t x_loc, uint16_t y_loc)
     goal.y = y_loc;
 }
 
-double MapManhattanDistance::computeHValue(const MapLocation& state) const
+
+void MapManhattanDistance::computeHValues(const MapLocation * const *states, std::size_t num_states,
+        double *h_values) const
 {
-    return abs(goal.x - state.x) + abs(goal.y - state.y);
+    std::size_t done = 0;
+
+#if SIMD_X86_AVAILABLE
+    if(getSimdLevel() == SimdLevel::avx2)
+        done = manhattanDistancesAVX2(goal, states, num_states, h_values);
+    else if(getSimdLevel() == SimdLevel::sse2)
+        done = manhattanDistancesSSE2(goal, states, num_states, h_values);
+#endif
+
+    for(std::size_t i = done; i < num_states; i++)
+        h_values[i] = computeHValue(*states[i]);
 }
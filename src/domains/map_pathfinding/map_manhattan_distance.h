@@ -13,6 +13,8 @@
 #include "map_location.h"
 #include "../../generic_defs/heuristic.h"
 
+#include <stdlib.h>
+
 /**
  * A class that defines the Manhattan heuristic function for a map pathfinding domain.
  *
@@ -45,11 +47,17 @@ public:
      */
     void setGoal(uint16_t x_loc, uint16_t y_loc);
 
-protected:
-    // Overloaded methods
+    // Overloaded methods. Public so that engines that know the type of the heuristic can call it directly.
     virtual double computeHValue(const MapLocation &state) const;
+    virtual void computeHValues(const MapLocation * const *states, std::size_t num_states, double *h_values) const;
 
+protected:
     MapLocation goal; ///< The goal location currently being used.
 };
 
+inline double MapManhattanDistance::computeHValue(const MapLocation& state) const
+{
+    return abs(goal.x - state.x) + abs(goal.y - state.y);
+}
+
 #endif /* MAP_MANHATTAN_DISTANCE_H_ */
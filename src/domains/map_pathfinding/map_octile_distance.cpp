@@ -8,7 +8,73 @@
  */
 
 #include "map_octile_distance.h"
-#include "../../utils/floating_point_utils.h"
+
+#if SIMD_X86_AVAILABLE
+#include <immintrin.h>
+
+/*
+ * The vectorized versions perform the same floating point operations in the same order as computeHValue, so they give
+ * exactly the same values.
+ */
+
+/**
+ * Computes the octile distances of the given states to the goal using AVX2, four states at a time.
+ */
+__attribute__((target("avx2")))
+static std::size_t octileDistancesAVX2(const MapLocation &goal, double diag_cost, const MapLocation * const *states,
+        std::size_t num_states, double *h_values)
+{
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m256d goal_x = _mm256_set1_pd(goal.x);
+    const __m256d goal_y = _mm256_set1_pd(goal.y);
+    const __m256d diag = _mm256_set1_pd(diag_cost);
+
+    std::size_t i = 0;
+    for(; i + 4 <= num_states; i += 4) {
+        __m256d x = _mm256_cvtepi32_pd(_mm_set_epi32(states[i + 3]->x, states[i + 2]->x, states[i + 1]->x,
+                states[i]->x));
+        __m256d y = _mm256_cvtepi32_pd(_mm_set_epi32(states[i + 3]->y, states[i + 2]->y, states[i + 1]->y,
+                states[i]->y));
+
+        __m256d delta_x = _mm256_and_pd(_mm256_sub_pd(goal_x, x), abs_mask);
+        __m256d delta_y = _mm256_and_pd(_mm256_sub_pd(goal_y, y), abs_mask);
+        __m256d min_delta = _mm256_min_pd(delta_x, delta_y);
+        __m256d max_delta = _mm256_max_pd(delta_x, delta_y);
+
+        __m256d h = _mm256_add_pd(_mm256_mul_pd(min_delta, diag), max_delta);
+        _mm256_storeu_pd(h_values + i, _mm256_sub_pd(h, min_delta));
+    }
+    return i;
+}
+
+/**
+ * Computes the octile distances of the given states to the goal using SSE2, two states at a time.
+ */
+__attribute__((target("sse2")))
+static std::size_t octileDistancesSSE2(const MapLocation &goal, double diag_cost, const MapLocation * const *states,
+        std::size_t num_states, double *h_values)
+{
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m128d goal_x = _mm_set1_pd(goal.x);
+    const __m128d goal_y = _mm_set1_pd(goal.y);
+    const __m128d diag = _mm_set1_pd(diag_cost);
+
+    std::size_t i = 0;
+    for(; i + 2 <= num_states; i += 2) {
+        __m128d x = _mm_set_pd(states[i + 1]->x, states[i]->x);
+        __m128d y = _mm_set_pd(states[i + 1]->y, states[i]->y);
+
+        __m128d delta_x = _mm_and_pd(_mm_sub_pd(goal_x, x), abs_mask);
+        __m128d delta_y = _mm_and_pd(_mm_sub_pd(goal_y, y), abs_mask);
+        __m128d min_delta = _mm_min_pd(delta_x, delta_y);
+        __m128d max_delta = _mm_max_pd(delta_x, delta_y);
+
+        __m128d h = _mm_add_pd(_mm_mul_pd(min_delta, diag), max_delta);
+        _mm_storeu_pd(h_values + i, _mm_sub_pd(h, min_delta));
+    }
+    return i;
+}
+#endif
 
 MapOctileDistance::MapOctileDistance()
         : diag_cost(ROOT_TWO)
@@ -40,15 +106,21 @@ bool MapOctileDistance::setDiagonalCost(double d_cost)
     return true;
 }
 
-double MapOctileDistance::computeHValue(const MapLocation& state) const
+
+void MapOctileDistance::computeHValues(const MapLocation * const *states, std::size_t num_states,
+        double *h_values) const
 {
-    if(!fp_less(diag_cost, 2.0))
-        return abs(goal.x - state.x) + abs(goal.y - state.y);
+    std::size_t done = 0;
 
-    double delta_x = abs(goal.x - state.x);
-    double delta_y = abs(goal.y - state.y);
+#if SIMD_X86_AVAILABLE
+    if(fp_less(diag_cost, 2.0)) { // otherwise, computeHValue uses the Manhattan distance
+        if(getSimdLevel() == SimdLevel::avx2)
+            done = octileDistancesAVX2(goal, diag_cost, states, num_states, h_values);
+        else if(getSimdLevel() == SimdLevel::sse2)
+            done = octileDistancesSSE2(goal, diag_cost, states, num_states, h_values);
+    }
+#endif
 
-    if(fp_less(delta_x, delta_y))
-        return delta_x*diag_cost + delta_y - delta_x;
-    return delta_y*diag_cost + delta_x - delta_y;
+    for(std::size_t i = done; i < num_states; i++)
+        h_values[i] = computeHValue(*states[i]);
 }
@@ -12,6 +12,9 @@
 
 #include "../../generic_defs/heuristic.h"
 #include "map_location.h"
+#include "../../utils/floating_point_utils.h"
+
+#include <stdlib.h>
 
 /**
  * A class that defines the octile heuristic function for a map pathfinding domain.
@@ -56,12 +59,26 @@ public:
      */
     bool setDiagonalCost(double d_cost);
 
-protected:
-    // Overloaded methods
+    // Overloaded methods. Public so that engines that know the type of the heuristic can call it directly.
     virtual double computeHValue(const MapLocation &state) const;
+    virtual void computeHValues(const MapLocation * const *states, std::size_t num_states, double *h_values) const;
 
+protected:
     MapLocation goal; ///< The goal location currently being used.
     double diag_cost; ///< The cost of diagonal moves.
 };
 
+inline double MapOctileDistance::computeHValue(const MapLocation& state) const
+{
+    if(!fp_less(diag_cost, 2.0))
+        return abs(goal.x - state.x) + abs(goal.y - state.y);
+
+    double delta_x = abs(goal.x - state.x);
+    double delta_y = abs(goal.y - state.y);
+
+    if(fp_less(delta_x, delta_y))
+        return delta_x*diag_cost + delta_y - delta_x;
+    return delta_y*diag_cost + delta_x - delta_y;
+}
+
 #endif /* MAP_OCTILE_DISTANCE_H_ */
@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <fstream>
 #include <string>
+#include <algorithm>
 
 #include "map_pathfinding_transitions.h"
 
@@ -28,9 +29,17 @@ using std::cout;
 using std::cerr;
 using std::endl;
 
+const uint32_t MapPathfindingTransitions::no_component;
+
 MapPathfindingTransitions::MapPathfindingTransitions(bool four_dirs)
-        : map_width(0), map_height(0), four_connected(four_dirs), diag_cost(ROOT_TWO)
+        : map_width(0), map_height(0), four_connected(four_dirs), diag_cost(ROOT_TWO), connected_dirs(0), row_words(0),
+                num_components(0), visit_stamp(0)
 {
+    if(four_connected)
+        set4Connected();
+    else
+        set8Connected();
+    setMaskActionLists();
 }
 
 MapPathfindingTransitions::MapPathfindingTransitions(std::string file_name, bool four_dirs)
@@ -74,6 +83,7 @@ bool MapPathfindingTransitions::loadMap(string file_name)
                     clearMap();
                     return false;
                 }
+                resizeMap(map_width, map_height);
                 getting_map = true;
             } else {
                 tokens.clear();
@@ -126,9 +136,12 @@ bool MapPathfindingTransitions::loadMap(string file_name)
                 }
             }
         } else {
-
-            if(grid_empty.size() == 0)
-                grid_empty.resize(map_height, vector<bool>(map_width, false));
+            if(current_row >= map_height) {
+                cerr << "Number of map rows in map file " << file_name << " does not match listed height.";
+                cerr << "Map reading failed." << endl;
+                clearMap();
+                return false;
+            }
 
             if(new_line.size() != map_width) {
                 cerr << "Line " << line_count << " of map file " << file_name << " has incorrect length";
@@ -139,7 +152,7 @@ bool MapPathfindingTransitions::loadMap(string file_name)
 
             for(unsigned i = 0; i < new_line.size(); i++) {
                 if(new_line.at(i) == '.' || new_line.at(i) == 'G' || new_line.at(i) == 'S')
-                    grid_empty[i][current_row] = true;
+                    setCellEmpty(i, current_row, true);
                 else if(new_line.at(i) != '@' && new_line.at(i) != 'O' && new_line.at(i) != 'T'
                         && new_line.at(i) != 'W') {
                     cerr << "Invalid map location symbol " << new_line.at(i) << " on line " << line_count;
@@ -163,6 +176,9 @@ bool MapPathfindingTransitions::loadMap(string file_name)
         clearMap();
         return false;
     }
+
+    computeMoveMasks();
+    computeComponents();
     return true;
 }
 
@@ -176,14 +192,32 @@ unsigned MapPathfindingTransitions::getMapHeight() const
     return map_height;
 }
 
+uint64_t MapPathfindingTransitions::computeMapHash() const
+{
+    // FNV-1a over the dimensions and the obstacles
+    uint64_t hash = 14695981039346656037ULL;
+    const uint64_t prime = 1099511628211ULL;
+
+    hash = (hash ^ map_width) * prime;
+    hash = (hash ^ map_height) * prime;
+    for(unsigned y = 0; y < map_height; y++) {
+        for(unsigned x = 0; x < map_width; x++)
+            hash = (hash ^ (isCellEmpty(x, y) ? 1 : 0)) * prime;
+    }
+    return hash;
+}
+
 void MapPathfindingTransitions::set4Connected()
 {
     four_connected = true;
+    connected_dirs = getDirBit(MapDir::north) | getDirBit(MapDir::east) | getDirBit(MapDir::south)
+            | getDirBit(MapDir::west);
 }
 
 void MapPathfindingTransitions::set8Connected()
 {
     four_connected = false;
+    connected_dirs = 0xFF;
 }
 
 bool MapPathfindingTransitions::setDiagonalCost(double d_cost)
@@ -208,101 +242,9 @@ bool MapPathfindingTransitions::is8Connected() const
 
 bool MapPathfindingTransitions::isApplicable(const MapLocation& state, const MapDir& action) const
 {
-    switch(action) {
-        case MapDir::north:
-            return canNorth(state);
-        case MapDir::east:
-            return canEast(state);
-        case MapDir::south:
-            return canSouth(state);
-        case MapDir::west:
-            return canWest(state);
-        default:
-            break;
-    }
-    if(!four_connected) {
-        switch(action) {
-            case MapDir::northeast:
-                return canNorth(state) && canEast(state) && isNEEmpty(state);
-            case MapDir::southeast:
-                return canEast(state) && canSouth(state) && isSEEmpty(state);
-            case MapDir::southwest:
-                return canSouth(state) && canWest(state) && isSWEmpty(state);
-            case MapDir::northwest:
-                return canNorth(state) && canWest(state) && isNWEmpty(state);
-            default:
-                break;
-        }
-    }
-    return false;
-}
-
-double MapPathfindingTransitions::getActionCost(const MapLocation& state, const MapDir& action) const
-{
-    if(action == MapDir::north || action == MapDir::east || action == MapDir::south || action == MapDir::west)
-        return 1.0;
-    return diag_cost;
-}
-
-void MapPathfindingTransitions::applyAction(MapLocation& state, const MapDir& action) const
-{
-    switch(action) {
-        case MapDir::north:
-            state.y--;
-            break;
-        case MapDir::northeast:
-            state.x++;
-            state.y--;
-            break;
-        case MapDir::east:
-            state.x++;
-            break;
-        case MapDir::southeast:
-            state.x++;
-            state.y++;
-            break;
-        case MapDir::south:
-            state.y++;
-            break;
-        case MapDir::southwest:
-            state.x--;
-            state.y++;
-            break;
-        case MapDir::west:
-            state.x--;
-            break;
-        case MapDir::northwest:
-            state.x--;
-            state.y--;
-            break;
-        default:
-            break;
-    }
-}
-
-void MapPathfindingTransitions::getActions(const MapLocation& state, std::vector<MapDir>& actions) const
-{
-    bool north = canNorth(state);
-    bool east = canEast(state);
-    bool south = canSouth(state);
-    bool west = canWest(state);
-
-    if(north)
-        actions.push_back(MapDir::north);
-    if(!four_connected && north && east && isNEEmpty(state))
-        actions.push_back(MapDir::northeast);
-    if(east)
-        actions.push_back(MapDir::east);
-    if(!four_connected && east && south && isSEEmpty(state))
-        actions.push_back(MapDir::southeast);
-    if(south)
-        actions.push_back(MapDir::south);
-    if(!four_connected && south && west && isSWEmpty(state))
-        actions.push_back(MapDir::southwest);
-    if(west)
-        actions.push_back(MapDir::west);
-    if(!four_connected && north && west && isNWEmpty(state))
-        actions.push_back(MapDir::northwest);
+    if(action == MapDir::dummy)
+        return false;
+    return (getMoveMask(state) & getDirBit(action)) != 0;
 }
 
 bool MapPathfindingTransitions::isInvertible(const MapLocation& state, const MapDir& action) const
@@ -351,58 +293,285 @@ void MapPathfindingTransitions::clearMap()
 {
     map_width = 0;
     map_height = 0;
-    grid_empty.clear();
+    row_words = 0;
+    grid_bits.clear();
+    move_masks.clear();
+    components.clear();
+    component_sizes.clear();
+    free_components.clear();
+    num_components = 0;
+    visit_stamps.clear();
 }
 
-bool MapPathfindingTransitions::canNorth(const MapLocation& state) const
+void MapPathfindingTransitions::resizeMap(unsigned width, unsigned height)
 {
-    assert(state.x < map_width);
-    assert(state.y < map_height);
+    map_width = width;
+    map_height = height;
 
-    if(state.y > 0 && grid_empty[state.x][state.y - 1])
-        return true;
-    return false;
+    row_words = (map_width + 2 + 63) / 64;
+    grid_bits.assign(row_words * (map_height + 2), 0);
+    move_masks.assign(map_width * map_height, 0);
 }
 
-bool MapPathfindingTransitions::canEast(const MapLocation& state) const
+void MapPathfindingTransitions::setCellEmpty(unsigned x_loc, unsigned y_loc, bool is_empty)
 {
-    if(state.x < map_width - 1 && grid_empty[state.x + 1][state.y])
-        return true;
-    return false;
+    assert(x_loc < map_width && y_loc < map_height);
+
+    unsigned bit = x_loc + 1;
+    uint64_t &word = grid_bits[(y_loc + 1) * row_words + bit / 64];
+    if(is_empty)
+        word |= (uint64_t) 1 << (bit % 64);
+    else
+        word &= ~((uint64_t) 1 << (bit % 64));
 }
 
-bool MapPathfindingTransitions::canSouth(const MapLocation& state) const
+void MapPathfindingTransitions::changeCell(unsigned x_loc, unsigned y_loc, bool is_empty)
 {
-    if(state.y < map_height - 1 && grid_empty[state.x][state.y + 1])
-        return true;
-    return false;
+    if(isCellEmpty(x_loc, y_loc) == is_empty)
+        return;
+
+    setCellEmpty(x_loc, y_loc, is_empty);
+
+    // only the moves of the location and its neighbours can pass through or cut the corner of the location
+    unsigned min_x = x_loc > 0 ? x_loc - 1 : 0;
+    unsigned min_y = y_loc > 0 ? y_loc - 1 : 0;
+    unsigned max_x = std::min(x_loc + 1, map_width - 1);
+    unsigned max_y = std::min(y_loc + 1, map_height - 1);
+    for(unsigned y = min_y; y <= max_y; y++) {
+        for(unsigned x = min_x; x <= max_x; x++)
+            move_masks[y * map_width + x] = computeMoveMask(x, y);
+    }
+
+    if(is_empty)
+        addToComponents(x_loc, y_loc);
+    else
+        removeFromComponents(x_loc, y_loc);
 }
 
-bool MapPathfindingTransitions::canWest(const MapLocation& state) const
+void MapPathfindingTransitions::computeMoveMasks()
 {
-    if(state.x > 0 && grid_empty[state.x - 1][state.y])
-        return true;
-    return false;
+    for(unsigned y = 0; y < map_height; y++) {
+        for(unsigned x = 0; x < map_width; x++)
+            move_masks[y * map_width + x] = computeMoveMask(x, y);
+    }
 }
 
-bool MapPathfindingTransitions::isNEEmpty(const MapLocation& state) const
+uint8_t MapPathfindingTransitions::computeMoveMask(unsigned x_loc, unsigned y_loc) const
 {
-    return grid_empty[state.x + 1][state.y - 1];
+    // The border means every neighbor of a location on the map is in the bitmap
+    bool empty[8];
+    for(unsigned d = 0; d < 8; d++) {
+        unsigned bit = x_loc + 1 + map_dir_x[d];
+        unsigned row = y_loc + 1 + map_dir_y[d];
+        empty[d] = (grid_bits[row * row_words + bit / 64] >> (bit % 64)) & 1;
+    }
+
+    uint8_t mask = 0;
+    for(unsigned d = 0; d < 8; d += 2) {
+        if(empty[d])
+            mask |= 1 << d;
+    }
+    for(unsigned d = 1; d < 8; d += 2) {
+        if(empty[d] && empty[d - 1] && empty[(d + 1) % 8])
+            mask |= 1 << d;
+    }
+    return mask;
 }
 
-bool MapPathfindingTransitions::isSEEmpty(const MapLocation& state) const
+void MapPathfindingTransitions::setMaskActionLists()
 {
-    return grid_empty[state.x + 1][state.y + 1];
+    for(unsigned mask = 0; mask < 256; mask++) {
+        mask_action_count[mask] = 0;
+        for(unsigned d = 0; d < 8; d++) {
+            if(mask & (1 << d))
+                mask_actions[mask][mask_action_count[mask]++] = (MapDir) d;
+        }
+    }
 }
 
-bool MapPathfindingTransitions::isSWEmpty(const MapLocation& state) const
+unsigned MapPathfindingTransitions::getNumComponents() const
 {
-    return grid_empty[state.x - 1][state.y + 1];
+    return num_components;
 }
 
-bool MapPathfindingTransitions::isNWEmpty(const MapLocation& state) const
+unsigned MapPathfindingTransitions::getComponentSize(uint32_t component) const
 {
-    return grid_empty[state.x - 1][state.y - 1];
+    assert(component < component_sizes.size());
+    return component_sizes[component];
+}
+
+void MapPathfindingTransitions::computeComponents()
+{
+    components.assign(map_width * map_height, no_component);
+    component_sizes.clear();
+    free_components.clear();
+    num_components = 0;
+    visit_stamps.assign(map_width * map_height, 0);
+    visit_stamp = 0;
+
+    for(unsigned y = 0; y < map_height; y++) {
+        for(unsigned x = 0; x < map_width; x++) {
+            if(isCellEmpty(x, y) && components[y * map_width + x] == no_component) {
+                uint32_t label = newComponent();
+                component_sizes[label] = relabelComponent(x, y, no_component, label);
+            }
+        }
+    }
+}
+
+void MapPathfindingTransitions::addToComponents(unsigned x_loc, unsigned y_loc)
+{
+    // The location joins the largest neighbouring component, and any other neighbouring components are merged into it
+    uint32_t label = no_component;
+    for(unsigned d = 0; d < 8; d += 2) {
+        int x = x_loc + map_dir_x[d];
+        int y = y_loc + map_dir_y[d];
+        if(!isCellEmpty(x, y))
+            continue;
+
+        uint32_t neighbour_label = components[y * map_width + x];
+        if(label == no_component || component_sizes[neighbour_label] > component_sizes[label])
+            label = neighbour_label;
+    }
+    if(label == no_component)
+        label = newComponent();
+
+    components[y_loc * map_width + x_loc] = label;
+    component_sizes[label]++;
+
+    for(unsigned d = 0; d < 8; d += 2) {
+        int x = x_loc + map_dir_x[d];
+        int y = y_loc + map_dir_y[d];
+        if(!isCellEmpty(x, y))
+            continue;
+
+        uint32_t neighbour_label = components[y * map_width + x];
+        if(neighbour_label == label)
+            continue;
+
+        component_sizes[label] += relabelComponent(x, y, neighbour_label, label);
+        component_sizes[neighbour_label] = 0;
+        free_components.push_back(neighbour_label);
+        num_components--;
+    }
+}
+
+void MapPathfindingTransitions::removeFromComponents(unsigned x_loc, unsigned y_loc)
+{
+    uint32_t label = components[y_loc * map_width + x_loc];
+    components[y_loc * map_width + x_loc] = no_component;
+    component_sizes[label]--;
+    if(component_sizes[label] == 0) {
+        free_components.push_back(label);
+        num_components--;
+        return;
+    }
+
+    // Consecutive locations around the removed one are adjacent, so empty neighbours in the same run of empty
+    // locations around it are still connected. Only one neighbour from each run needs to be checked.
+    bool ring_empty[8];
+    int blocked_dir = -1;
+    for(unsigned d = 0; d < 8; d++) {
+        ring_empty[d] = isCellEmpty(x_loc + map_dir_x[d], y_loc + map_dir_y[d]);
+        if(!ring_empty[d])
+            blocked_dir = d;
+    }
+    if(blocked_dir < 0)
+        return;
+
+    uint32_t starts[4];
+    unsigned num_starts = 0;
+    bool run_has_start = false;
+    for(unsigned i = 1; i <= 8; i++) {
+        unsigned d = (blocked_dir + i) % 8;
+        if(!ring_empty[d]) {
+            run_has_start = false;
+        } else if(d % 2 == 0 && !run_has_start) {
+            starts[num_starts++] = (y_loc + map_dir_y[d]) * map_width + x_loc + map_dir_x[d];
+            run_has_start = true;
+        }
+    }
+    if(num_starts <= 1)
+        return;
+
+    // Searches from the first start until the others are found, or its side of the split has been labelled
+    visit_stamp++;
+    if(visit_stamp == 0) {
+        std::fill(visit_stamps.begin(), visit_stamps.end(), 0);
+        visit_stamp = 1;
+    }
+
+    unsigned num_unfound = num_starts - 1;
+    component_queue.clear();
+    component_queue.push_back(starts[0]);
+    visit_stamps[starts[0]] = visit_stamp;
+    for(std::size_t head = 0; head < component_queue.size() && num_unfound > 0; head++) {
+        uint32_t cell = component_queue[head];
+        for(unsigned d = 0; d < 8; d += 2) {
+            int x = cell % map_width + map_dir_x[d];
+            int y = cell / map_width + map_dir_y[d];
+            if(!isCellEmpty(x, y))
+                continue;
+
+            uint32_t neighbour = y * map_width + x;
+            if(visit_stamps[neighbour] == visit_stamp)
+                continue;
+
+            visit_stamps[neighbour] = visit_stamp;
+            component_queue.push_back(neighbour);
+            for(unsigned i = 1; i < num_starts; i++) {
+                if(starts[i] == neighbour)
+                    num_unfound--;
+            }
+        }
+    }
+    if(num_unfound == 0)
+        return;
+
+    // The starts not found are on other sides of the split, which get new labels
+    for(unsigned i = 1; i < num_starts; i++) {
+        if(visit_stamps[starts[i]] == visit_stamp || components[starts[i]] != label)
+            continue;
+
+        uint32_t new_label = newComponent();
+        component_sizes[new_label] = relabelComponent(starts[i] % map_width, starts[i] / map_width, label, new_label);
+        component_sizes[label] -= component_sizes[new_label];
+    }
+}
+
+uint32_t MapPathfindingTransitions::newComponent()
+{
+    num_components++;
+    if(!free_components.empty()) {
+        uint32_t label = free_components.back();
+        free_components.pop_back();
+        return label;
+    }
+
+    component_sizes.push_back(0);
+    return component_sizes.size() - 1;
+}
+
+unsigned MapPathfindingTransitions::relabelComponent(unsigned x_loc, unsigned y_loc, uint32_t old_label,
+        uint32_t new_label)
+{
+    component_queue.clear();
+    component_queue.push_back(y_loc * map_width + x_loc);
+    components[y_loc * map_width + x_loc] = new_label;
+
+    for(std::size_t head = 0; head < component_queue.size(); head++) {
+        uint32_t cell = component_queue[head];
+        for(unsigned d = 0; d < 8; d += 2) {
+            int x = cell % map_width + map_dir_x[d];
+            int y = cell / map_width + map_dir_y[d];
+            if(!isCellEmpty(x, y) || components[y * map_width + x] != old_label)
+                continue;
+
+            components[y * map_width + x] = new_label;
+            component_queue.push_back(y * map_width + x);
+        }
+    }
+    return component_queue.size();
 }
 
 std::ostream& operator <<(std::ostream& out, const MapDir& action)
@@ -13,9 +13,15 @@
 #include "map_location.h"
 #include "../../generic_defs/transition_system.h"
 
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
 /**
  * Defines the actions possible in the 2D map pathfinding domain.
  *
+ * The directions are listed clockwise from north. Diagonal directions have odd values.
+ *
  * @class MapDir
  */
 enum class MapDir
@@ -23,6 +29,12 @@ enum class MapDir
     north, northeast, east, southeast, south, southwest, west, northwest, dummy
 };
 
+/// The change in x coordinate of a move in each direction, indexed by the value of the direction.
+const int map_dir_x[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+/// The change in y coordinate of a move in each direction, indexed by the value of the direction.
+const int map_dir_y[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
 /**
  * Defines the transitions for map pathfinding.
  *
@@ -30,7 +42,17 @@ enum class MapDir
  * Locations are either empty or have an obstacle. If the transition system is set as 4-connected,
  * then movement is only possible in the 4 cardinal directions (North, East, South, and West). If
  * it is not 4-connected, it is 8-connected, which means it is possible to move in the 4 cardinal
- * directions as well as Northeast, Southeast, Southwest, and Northwest.
+ * directions as well as Northeast, Southeast, Southwest, and Northwest. A diagonal move is only possible if both of
+ * the cardinal moves it combines are possible and the diagonal location is empty.
+ *
+ * The map is stored as a row-major bitmap surrounded by a border of obstacles, so that neighbors can be looked up
+ * without bounds checks. The moves possible from each location when 8-connected are precomputed as a mask with bit d
+ * set if moving in direction d is possible, which makes getting the applicable actions a single lookup.
+ *
+ * The empty locations are also labelled with their connected component, so that isReachable can reject a start and
+ * goal with no path between them without searching. Since diagonal moves can't cut corners, two locations are
+ * connected when 8-connected exactly when they are connected when 4-connected, so one labelling serves both. The
+ * labels are kept up to date when locations are changed with changeCell.
  *
  * @todo Set the bottom left corner to be (0, 0)?
  * @todo Allow for different terrain types.
@@ -66,8 +88,10 @@ public:
     virtual double getActionCost(const MapLocation &state, const MapDir &action) const;
     virtual void applyAction(MapLocation &state, const MapDir &action) const;
     virtual void getActions(const MapLocation &state, std::vector<MapDir> &actions) const;
+    virtual void generateSuccessors(const MapLocation &state, SuccessorBuffer<MapLocation, MapDir> &successors) const;
     virtual bool isInvertible(const MapLocation &state, const MapDir &action) const;
     virtual MapDir getInverse(const MapLocation &state, const MapDir &action) const;
+    virtual bool isReachable(const MapLocation &from, const MapLocation &to) const;
     MapDir getDummyAction() const;
     bool isDummyAction(const MapDir &action) const;
 
@@ -106,6 +130,14 @@ public:
      */
     unsigned getMapHeight() const;
 
+    /**
+     * Computes a hash of the map dimensions and obstacles, which can be used to check that data precomputed for a map
+     * (such as stored in a file) still matches it. Does not depend on the connectivity or diagonal cost.
+     *
+     * @return The hash of the map.
+     */
+    uint64_t computeMapHash() const;
+
     /**
      * Sets the map to be 4-connected.
      */
@@ -146,78 +178,185 @@ public:
      */
     void clearMap();
 
-protected:
+    /**
+     * Checks if the given location is empty. Locations outside the map are obstacles.
+     *
+     * @param x_loc The x coordinate of the location.
+     * @param y_loc The y coordinate of the location.
+     * @return If the location is on the map and is empty.
+     */
+    bool isCellEmpty(int x_loc, int y_loc) const;
+
+    /**
+     * Sets if the given location is empty, and updates the move masks of it and its neighbours and the connected
+     * components.
+     *
+     * Making a location empty may merge components, in which case all but the largest are relabelled. Making it an
+     * obstacle may split its component, which is only checked for with a search if its empty neighbours are not
+     * connected through the locations around it.
+     *
+     * Anything precomputed from the map, such as jump distance tables or path databases, must be rebuilt or updated
+     * afterwards.
+     *
+     * @param x_loc The x coordinate of the location. Must be on the map.
+     * @param y_loc The y coordinate of the location. Must be on the map.
+     * @param is_empty If the location should be empty.
+     */
+    void changeCell(unsigned x_loc, unsigned y_loc, bool is_empty);
+
+    /**
+     * Returns the mask of moves possible from the given location, under the current connectivity. Bit d of the mask
+     * is set if moving in the direction with value d is possible.
+     *
+     * @param state The location to move from. Must be on the map.
+     * @return The mask of possible moves.
+     */
+    uint8_t getMoveMask(const MapLocation &state) const;
+
+    /**
+     * Returns the bit for the given direction in a move mask.
+     *
+     * @param dir The direction.
+     * @return The bit for the direction.
+     */
+    static uint8_t getDirBit(MapDir dir);
+
+    /**
+     * Returns the connected component of the given location.
+     *
+     * @param state The location. Must be on the map.
+     * @return The component of the location, or no_component if it is an obstacle.
+     */
+    uint32_t getComponent(const MapLocation &state) const;
+
+    /**
+     * Returns the number of connected components of empty locations on the map.
+     *
+     * @return The number of components.
+     */
+    unsigned getNumComponents() const;
+
+    /**
+     * Returns the number of locations in the given connected component.
+     *
+     * @param component The component, as returned by getComponent.
+     * @return The number of locations in the component.
+     */
+    unsigned getComponentSize(uint32_t component) const;
 
+    static const uint32_t no_component = UINT32_MAX; ///< The component of an obstacle.
+
+protected:
     /**
-     * Returns true of it is possible to move north from the current location.
+     * Sets the size of the map and makes every location an obstacle.
      *
-     * @param state The state currently located at.
-     * @return If it is possible to move north from the given location.
+     * @param width The width of the map.
+     * @param height The height of the map.
      */
-    bool canNorth(const MapLocation &state) const;
+    void resizeMap(unsigned width, unsigned height);
 
     /**
-     * Returns true of it is possible to move east from the current location.
+     * Sets if the given location is empty. Does not update the move masks.
      *
-     * @param state The state currently located at.
-     * @return If it is possible to move east from the given location.
+     * @param x_loc The x coordinate of the location. Must be on the map.
+     * @param y_loc The y coordinate of the location. Must be on the map.
+     * @param is_empty If the location should be empty.
+     */
+    void setCellEmpty(unsigned x_loc, unsigned y_loc, bool is_empty);
+
+    /**
+     * Computes the move mask of every location on the map from the bitmap.
      */
-    bool canEast(const MapLocation &state) const;
+    void computeMoveMasks();
 
     /**
-     * Returns true of it is possible to move south from the current location.
+     * Computes the move mask of the given location (when 8-connected) from the bitmap.
      *
-     * @param state The state currently located at.
-     * @return If it is possible to move south from the given location.
+     * @param x_loc The x coordinate of the location. Must be on the map.
+     * @param y_loc The y coordinate of the location. Must be on the map.
+     * @return The move mask for the location.
+     */
+    uint8_t computeMoveMask(unsigned x_loc, unsigned y_loc) const;
+
+    /**
+     * Fills in the list of directions for each possible move mask.
+     */
+    void setMaskActionLists();
+
+    /**
+     * Labels the connected components of the map from scratch.
      */
-    bool canSouth(const MapLocation &state) const;
+    void computeComponents();
 
     /**
-     * Returns true of it is possible to move west from the current location.
+     * Updates the components after the given location was made empty.
      *
-     * @param state The state currently located at.
-     * @return If it is possible to move west from the given location.
+     * @param x_loc The x coordinate of the location.
+     * @param y_loc The y coordinate of the location.
      */
-    bool canWest(const MapLocation &state) const;
+    void addToComponents(unsigned x_loc, unsigned y_loc);
 
     /**
-     * Checks if the location northeast of the given location is empty.
+     * Updates the components after the given location was made an obstacle.
      *
-     * @param state The state currently located at.
-     * @return If the location northeast of the given location is empty.
+     * @param x_loc The x coordinate of the location.
+     * @param y_loc The y coordinate of the location.
      */
-    bool isNEEmpty(const MapLocation &state) const;
+    void removeFromComponents(unsigned x_loc, unsigned y_loc);
 
     /**
-     * Checks if the location southeast of the given location is empty.
+     * Returns an unused component label, with a size of 0.
      *
-     * @param state The state currently located at.
-     * @return If the location southeast of the given location is empty.
+     * @return The new label.
      */
-    bool isSEEmpty(const MapLocation &state) const;
+    uint32_t newComponent();
 
     /**
-     * Checks if the location southwest of the given location is empty.
+     * Relabels the empty locations labelled with one component that can be reached from the given location without
+     * passing through locations with other labels.
      *
-     * @param state The state currently located at.
-     * @return If the location southwest of the given location is empty.
+     * @param x_loc The x coordinate of the location to start from. Must be labelled old_label.
+     * @param y_loc The y coordinate of the location to start from.
+     * @param old_label The label to replace.
+     * @param new_label The label to replace it with.
+     * @return The number of locations relabelled.
      */
-    bool isSWEmpty(const MapLocation &state) const;
+    unsigned relabelComponent(unsigned x_loc, unsigned y_loc, uint32_t old_label, uint32_t new_label);
 
     /**
-     * Checks if the location northwest of the given location is empty.
+     * Adds the successor generated by moving in the given direction to the given buffer.
+     *
+     * Assumes the move is applicable.
      *
-     * @param state The state currently located at.
-     * @return If the location northwest of the given location is empty.
+     * @param successors The buffer to add the successor to.
+     * @param state The state being moved from.
+     * @param dir The direction of the move.
+     * @param cost The cost of the move.
      */
-    bool isNWEmpty(const MapLocation &state) const;
+    void addMoveSuccessor(SuccessorBuffer<MapLocation, MapDir> &successors, const MapLocation &state, MapDir dir,
+            double cost) const;
 
     unsigned map_width; ///< The map width.
     unsigned map_height; ///< The map height.
 
     bool four_connected; ///< If the map is 4-connected or 8-connected.
     double diag_cost; ///< The cost of a diagonal move.
-    std::vector<std::vector<bool> > grid_empty; ///< Indexed by location, indicates if it is empty or an obstacle.
+    uint8_t connected_dirs; ///< The move mask bits of the directions allowed by the current connectivity.
+
+    unsigned row_words; ///< The number of 64-bit words in each row of the bitmap, including the border.
+    std::vector<uint64_t> grid_bits; ///< Row-major bitmap of empty locations. Location (x, y) is bit x + 1 of row y + 1.
+    std::vector<uint8_t> move_masks; ///< Row-major move masks for each location when 8-connected.
+
+    std::vector<uint32_t> components; ///< Row-major component labels of each location, or no_component.
+    std::vector<uint32_t> component_sizes; ///< The number of locations with each label. Unused labels have size 0.
+    std::vector<uint32_t> free_components; ///< Labels that are no longer used.
+    unsigned num_components; ///< The number of labels in use.
+    std::vector<uint32_t> component_queue; ///< The queue of locations used when labelling.
+    std::vector<uint32_t> visit_stamps; ///< The check for a split each location was last visited by.
+    uint32_t visit_stamp; ///< Identifies the current check for a split.
+
+    MapDir mask_actions[256][8]; ///< For each move mask, the directions it contains in increasing order.
+    uint8_t mask_action_count[256]; ///< For each move mask, the number of directions it contains.
 };
 
 /**
@@ -229,4 +368,115 @@ protected:
  */
 std::ostream& operator <<(std::ostream & out, const MapDir &dir);
 
+inline double MapPathfindingTransitions::getActionCost(const MapLocation& state, const MapDir& action) const
+{
+    if(action == MapDir::north || action == MapDir::east || action == MapDir::south || action == MapDir::west)
+        return 1.0;
+    return diag_cost;
+}
+
+inline void MapPathfindingTransitions::applyAction(MapLocation& state, const MapDir& action) const
+{
+    switch(action) {
+        case MapDir::north:
+            state.y--;
+            break;
+        case MapDir::northeast:
+            state.x++;
+            state.y--;
+            break;
+        case MapDir::east:
+            state.x++;
+            break;
+        case MapDir::southeast:
+            state.x++;
+            state.y++;
+            break;
+        case MapDir::south:
+            state.y++;
+            break;
+        case MapDir::southwest:
+            state.x--;
+            state.y++;
+            break;
+        case MapDir::west:
+            state.x--;
+            break;
+        case MapDir::northwest:
+            state.x--;
+            state.y--;
+            break;
+        default:
+            break;
+    }
+}
+
+inline void MapPathfindingTransitions::getActions(const MapLocation& state, std::vector<MapDir>& actions) const
+{
+    uint8_t mask = getMoveMask(state);
+    actions.insert(actions.end(), mask_actions[mask], mask_actions[mask] + mask_action_count[mask]);
+}
+
+inline void MapPathfindingTransitions::generateSuccessors(const MapLocation& state,
+        SuccessorBuffer<MapLocation, MapDir>& successors) const
+{
+    successors.clear();
+
+    uint8_t mask = getMoveMask(state);
+    for(unsigned i = 0; i < mask_action_count[mask]; i++) {
+        MapDir dir = mask_actions[mask][i];
+        addMoveSuccessor(successors, state, dir, ((unsigned) dir & 1) ? diag_cost : 1.0);
+    }
+}
+
+inline void MapPathfindingTransitions::addMoveSuccessor(SuccessorBuffer<MapLocation, MapDir>& successors,
+        const MapLocation& state, MapDir dir, double cost) const
+{
+    Successor<MapLocation, MapDir> &succ = successors.addSuccessor();
+    succ.action = dir;
+    succ.cost = cost;
+    succ.state.x = state.x;
+    succ.state.y = state.y;
+    applyAction(succ.state, dir);
+}
+
+inline bool MapPathfindingTransitions::isCellEmpty(int x_loc, int y_loc) const
+{
+    if(x_loc < 0 || y_loc < 0 || x_loc >= (int) map_width || y_loc >= (int) map_height)
+        return false;
+
+    unsigned bit = x_loc + 1;
+    return (grid_bits[(y_loc + 1) * row_words + bit / 64] >> (bit % 64)) & 1;
+}
+
+inline uint8_t MapPathfindingTransitions::getMoveMask(const MapLocation& state) const
+{
+    assert(state.x < map_width);
+    assert(state.y < map_height);
+
+    return move_masks[state.y * map_width + state.x] & connected_dirs;
+}
+
+inline uint8_t MapPathfindingTransitions::getDirBit(MapDir dir)
+{
+    return (uint8_t) (1u << (unsigned) dir);
+}
+
+inline uint32_t MapPathfindingTransitions::getComponent(const MapLocation& state) const
+{
+    assert(state.x < map_width);
+    assert(state.y < map_height);
+
+    return components[state.y * map_width + state.x];
+}
+
+inline bool MapPathfindingTransitions::isReachable(const MapLocation& from, const MapLocation& to) const
+{
+    if(from == to)
+        return true;
+
+    uint32_t from_component = getComponent(from);
+    return from_component != no_component && from_component == getComponent(to);
+}
+
 #endif /* MAP_PATHFINDING_TRANSITIONS_H_ */
@@ -9,8 +9,11 @@
 
 #include <sstream>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <queue>
 #include <stdlib.h>
+#include <utility>
 #include "map_utils.h"
 #include "../../utils/string_utils.h"
 
@@ -50,3 +53,53 @@ bool read_in_pathfinding_probs(string file_name, vector<MapLocation> &starts, ve
 
     return true;
 }
+
+void compute_map_distances(const MapPathfindingTransitions &map, unsigned source, vector<double> &distances,
+        vector<double> *bounds, vector<uint8_t> *first_moves)
+{
+    unsigned width = map.getMapWidth();
+    std::size_t num_locations = (std::size_t) width * map.getMapHeight();
+    distances.assign(num_locations, -1.0);
+    if(first_moves)
+        first_moves->resize(num_locations);
+
+    int offsets[8];
+    double costs[8];
+    for(unsigned d = 0; d < 8; d++) {
+        offsets[d] = map_dir_y[d] * (int) width + map_dir_x[d];
+        costs[d] = map.getActionCost(MapLocation(0, 0), (MapDir) d);
+    }
+
+    typedef std::pair<double, unsigned> QueueEntry;
+    std::priority_queue<QueueEntry, vector<QueueEntry>, std::greater<QueueEntry> > open;
+
+    distances[source] = 0.0;
+    open.push(QueueEntry(0.0, source));
+    while(!open.empty()) {
+        QueueEntry entry = open.top();
+        open.pop();
+        if(entry.first > distances[entry.second])
+            continue; // stale entry
+
+        unsigned loc = entry.second;
+        uint8_t moves = map.getMoveMask(MapLocation(loc % width, loc / width));
+        for(unsigned d = 0; d < 8; d++) {
+            if(!(moves & (1u << d)))
+                continue;
+
+            unsigned next = loc + offsets[d];
+            double next_distance = entry.first + costs[d];
+            if(distances[next] >= 0.0 && distances[next] <= next_distance)
+                continue;
+            if(bounds && next_distance >= (*bounds)[next])
+                continue;
+
+            distances[next] = next_distance;
+            if(bounds)
+                (*bounds)[next] = next_distance;
+            if(first_moves)
+                (*first_moves)[next] = loc == source ? d : (*first_moves)[loc];
+            open.push(QueueEntry(next_distance, next));
+        }
+    }
+}
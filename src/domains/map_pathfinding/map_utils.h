@@ -15,9 +15,11 @@
 #ifndef MAP_UTILS_H_
 #define MAP_UTILS_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "map_location.h"
+#include "map_pathfinding_transitions.h"
 
 /**
  * Reads in the pathfinding problems from the given file.
@@ -35,4 +37,20 @@
  */
 bool read_in_pathfinding_probs(std::string file_name, std::vector<MapLocation> &starts, std::vector<MapLocation> &goals);
 
+/**
+ * Computes the distance from the given location to every location on the map with Dijkstra's algorithm. Locations
+ * are given by their index, y * width + x.
+ *
+ * If a bound for each location is given, the search only continues through locations whose distance is below their
+ * bound. The bounds are then lowered to the distances found.
+ *
+ * @param map The map.
+ * @param source The index of the location to start from.
+ * @param distances Set as the distance of each location, or -1 for locations that are not reached.
+ * @param bounds The bounds to use and lower, or 0 if there are none.
+ * @param first_moves If given, set as the first move of a shortest path to each reached location other than the source.
+ */
+void compute_map_distances(const MapPathfindingTransitions &map, unsigned source, std::vector<double> &distances,
+        std::vector<double> *bounds = 0, std::vector<uint8_t> *first_moves = 0);
+
 #endif /* MAP_UTILS_H_ */
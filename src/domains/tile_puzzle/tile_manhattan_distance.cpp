@@ -10,6 +10,69 @@
 #include "tile_manhattan_distance.h"
 #include <cmath>
 
+#if SIMD_X86_AVAILABLE
+#include <immintrin.h>
+
+/*
+ * The vectorized versions evaluate several states at once, one per vector lane. Each lane adds up the values of the
+ * positions in the same order as computeHValue, so they give exactly the same values. Adding the 0 value of the blank
+ * does not change a lane's sum.
+ */
+
+/**
+ * Computes the Manhattan distances of the given states using AVX2 gathers, four states at a time.
+ */
+__attribute__((target("avx2")))
+static std::size_t tileDistancesAVX2(const double *tile_h_value, unsigned puzzle_size,
+        const TilePuzzleState * const *states, std::size_t num_states, double *h_values)
+{
+    const __m256i nibble_mask = _mm256_set1_epi64x(0xF);
+    const __m256i size = _mm256_set1_epi64x(puzzle_size);
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    std::size_t i = 0;
+    for(; i + 4 <= num_states; i += 4) {
+        __m256i tiles = _mm256_set_epi64x(states[i + 3]->packed_tiles, states[i + 2]->packed_tiles,
+                states[i + 1]->packed_tiles, states[i]->packed_tiles);
+        __m256i pos = _mm256_setzero_si256();
+        __m256d h = _mm256_setzero_pd();
+
+        for(unsigned p = 0; p < puzzle_size; p++) {
+            __m256i tile = _mm256_and_si256(tiles, nibble_mask);
+            __m256i index = _mm256_add_epi64(_mm256_mul_epu32(tile, size), pos);
+            h = _mm256_add_pd(h, _mm256_i64gather_pd(tile_h_value, index, 8));
+
+            tiles = _mm256_srli_epi64(tiles, 4);
+            pos = _mm256_add_epi64(pos, one);
+        }
+        _mm256_storeu_pd(h_values + i, h);
+    }
+    return i;
+}
+
+/**
+ * Computes the Manhattan distances of the given states using SSE2, two states at a time.
+ */
+__attribute__((target("sse2")))
+static std::size_t tileDistancesSSE2(const double *tile_h_value, unsigned puzzle_size,
+        const TilePuzzleState * const *states, std::size_t num_states, double *h_values)
+{
+    std::size_t i = 0;
+    for(; i + 2 <= num_states; i += 2) {
+        uint64_t tiles_0 = states[i]->packed_tiles;
+        uint64_t tiles_1 = states[i + 1]->packed_tiles;
+        __m128d h = _mm_setzero_pd();
+
+        for(unsigned pos = 0; pos < puzzle_size; pos++, tiles_0 >>= 4, tiles_1 >>= 4) {
+            h = _mm_add_pd(h, _mm_set_pd(tile_h_value[(tiles_1 & 0xF) * puzzle_size + pos],
+                    tile_h_value[(tiles_0 & 0xF) * puzzle_size + pos]));
+        }
+        _mm_storeu_pd(h_values + i, h);
+    }
+    return i;
+}
+#endif
+
 using std::vector;
 using std::abs;
 using std::cout;
@@ -38,18 +101,19 @@ void TileManhattanDistance::setGoal(const TilePuzzleState& g, const TilePuzzleTr
         tile_move_cost[i] = ops.getTileMoveCost(i);
     }
 
-    tile_h_value.resize(puzzle_size, vector<double>(puzzle_size, 0.0));
+    tile_h_value.assign(puzzle_size * puzzle_size, 0.0);
 
     for(unsigned goal_pos = 0; goal_pos < puzzle_size; goal_pos++) {
-        unsigned tile = goal.permutation[goal_pos];
+        unsigned tile = goal[goal_pos];
 
         if(tile == 0)
             continue;
 
         for(unsigned pos = 0; pos < puzzle_size; pos++) {
-            tile_h_value[tile][pos] = abs((int) (goal_pos % num_cols) - (int) (pos % num_cols)); // column difference
-            tile_h_value[tile][pos] += abs((int) (goal_pos / num_cols) - (int) (pos / num_cols)); // row difference
-            tile_h_value[tile][pos] *= tile_move_cost[tile]; // increase by the tile move cost
+            double &h_value = tile_h_value[tile * puzzle_size + pos];
+            h_value = abs((int) (goal_pos % num_cols) - (int) (pos % num_cols)); // column difference
+            h_value += abs((int) (goal_pos / num_cols) - (int) (pos / num_cols)); // row difference
+            h_value *= tile_move_cost[tile]; // increase by the tile move cost
         }
     }
 }
@@ -58,11 +122,27 @@ double TileManhattanDistance::computeHValue(const TilePuzzleState& state) const
 {
     double h_value = 0.0;
 
-    for(unsigned pos = 0; pos < state.permutation.size(); pos++) {
-        if(pos != state.blank_loc) {
-            unsigned tile = state.permutation[pos];
-            h_value += tile_h_value[tile][pos];
-        }
+    uint64_t tiles = state.packed_tiles;
+    for(unsigned pos = 0; pos < puzzle_size; pos++, tiles >>= 4) {
+        unsigned tile = (unsigned) (tiles & 0xF);
+        if(tile != 0)
+            h_value += tile_h_value[tile * puzzle_size + pos];
     }
     return h_value;
 }
+
+void TileManhattanDistance::computeHValues(const TilePuzzleState * const *states, std::size_t num_states,
+        double *h_values) const
+{
+    std::size_t done = 0;
+
+#if SIMD_X86_AVAILABLE
+    if(getSimdLevel() == SimdLevel::avx2)
+        done = tileDistancesAVX2(&tile_h_value[0], puzzle_size, states, num_states, h_values);
+    else if(getSimdLevel() == SimdLevel::sse2)
+        done = tileDistancesSSE2(&tile_h_value[0], puzzle_size, states, num_states, h_values);
+#endif
+
+    for(std::size_t i = done; i < num_states; i++)
+        h_values[i] = computeHValue(*states[i]);
+}
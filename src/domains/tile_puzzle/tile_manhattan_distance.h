@@ -11,15 +11,17 @@
 #define TILEMANHATTANDISTANCE_H_
 
 #include "tile_puzzle_transitions.h"
-#include "../../generic_defs/heuristic.h"
+#include "../../generic_defs/incremental_heuristic.h"
 #include <vector>
 
 /**
  * Manhattan distance calculator for tile puzzle states.
  *
+ * The heuristic value of a child is computed from that of its parent by only updating the distance of the moved tile.
+ *
  * @class TileManhattanDistance
  */
-class TileManhattanDistance: public Heuristic<TilePuzzleState>
+class TileManhattanDistance: public IncrementalHeuristic<TilePuzzleState, BlankSlide>
 {
 public:
     /**
@@ -43,17 +45,29 @@ public:
      */
     void setGoal(const TilePuzzleState &g, const TilePuzzleTransitions &ops);
 
-protected:
-    // Overloaded methods
+    // Overloaded methods. Public so that engines that know the type of the heuristic can call it directly.
     virtual double computeHValue(const TilePuzzleState &state) const;
+    virtual double computeChildHValue(const TilePuzzleState &parent, double parent_h, const BlankSlide &action,
+            const TilePuzzleState &child) const;
+    virtual void computeHValues(const TilePuzzleState * const *states, std::size_t num_states, double *h_values) const;
 
+protected:
     TilePuzzleState goal; ///< The goal state.
     unsigned num_rows; ///< The number of rows in the puzzle.
     unsigned num_cols; ///< The number of columns in the puzzle.
     unsigned puzzle_size; ///< The total number of locations in the puzzle.
 
-    std::vector<std::vector<double> > tile_h_value; ///< The heuristic impact of the current tile in the current position. The first index (for the blank) is unused.
+    std::vector<double> tile_h_value; ///< The heuristic impact of each tile in each position, indexed by tile * puzzle_size + position. The values for the blank are 0.
     std::vector<double> tile_move_cost; ///< The cost of moving each tile.
 };
 
+inline double TileManhattanDistance::computeChildHValue(const TilePuzzleState& parent, double parent_h,
+        const BlankSlide& action, const TilePuzzleState& child) const
+{
+    // the moved tile is now where the blank was in the parent
+    unsigned tile = child[parent.blank_loc];
+    return parent_h - tile_h_value[tile * puzzle_size + child.blank_loc]
+            + tile_h_value[tile * puzzle_size + parent.blank_loc];
+}
+
 #endif /* TILEMANHATTANDISTANCE_H_ */
@@ -0,0 +1,18 @@
+/*
+ * tile_packed_hash_function.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "tile_packed_hash_function.h"
+
+TilePackedHashFunction::TilePackedHashFunction()
+{
+}
+
+TilePackedHashFunction::~TilePackedHashFunction()
+{
+}
@@ -0,0 +1,46 @@
+/*
+ * tile_packed_hash_function.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef TILE_PACKED_HASH_FUNCTION_H_
+#define TILE_PACKED_HASH_FUNCTION_H_
+
+#include "../../generic_defs/state_hash_function.h"
+#include "tile_puzzle_state.h"
+
+/**
+ * A hash function for tile puzzle states that uses the packed permutation word as the hash value.
+ *
+ * This takes constant time and distinguishes all states of a puzzle, but the values are spread over the full 64-bit
+ * range, so it should be used with a hashing node table backend rather than a direct index one.
+ *
+ * @class TilePackedHashFunction
+ */
+class TilePackedHashFunction: public StateHashFunction<TilePuzzleState>
+{
+public:
+    /**
+     * Constructor for the hash function. Does nothing.
+     */
+    TilePackedHashFunction();
+
+    /**
+     * Destructor for the hash function. Does nothing.
+     */
+    virtual ~TilePackedHashFunction();
+
+    // Overloaded function
+    virtual StateHash getStateHash(const TilePuzzleState &state) const;
+};
+
+inline StateHash TilePackedHashFunction::getStateHash(const TilePuzzleState& state) const
+{
+    return state.packed_tiles;
+}
+
+#endif /* TILE_PACKED_HASH_FUNCTION_H_ */
@@ -12,7 +12,8 @@ using std::vector;
 using std::endl;
 using std::ostream;
 
-TilePuzzleState::TilePuzzleState() : num_rows(0), num_cols(0), blank_loc(0)
+TilePuzzleState::TilePuzzleState()
+        : packed_tiles(0), num_rows(0), num_cols(0), blank_loc(0)
 {
 }
 
@@ -20,62 +21,64 @@ TilePuzzleState::~TilePuzzleState()
 {
 }
 
-
 TilePuzzleState::TilePuzzleState(const unsigned rows, const unsigned cols)
-        : permutation(rows * cols)
+        : packed_tiles(0), num_rows(rows), num_cols(cols), blank_loc(0)
 {
-    num_rows = rows;
-    num_cols = cols;
-
-    for(unsigned i = 0; i < permutation.size(); i++) {
-        permutation[i] = i;
+    if(rows * cols > MAX_TILE_PUZZLE_CELLS) {
+        cerr << "Error in SlidingTileState constructor.";
+        cerr << "Puzzle has more than " << MAX_TILE_PUZZLE_CELLS << " cells";
+        cerr << endl;
+        return;
     }
 
-    blank_loc = 0;
+    for(unsigned i = 0; i < size(); i++)
+        setTile(i, i);
 }
 
 TilePuzzleState::TilePuzzleState(const std::vector<unsigned>& perm, const unsigned rows, const unsigned cols)
-        : permutation(perm), num_rows(rows), num_cols(cols), blank_loc(perm.size())
+        : packed_tiles(0), num_rows(rows), num_cols(cols), blank_loc(0)
 {
-    if(permutation.size() != num_rows * num_cols) {
+    if(perm.size() != size()) {
         cerr << "Error in SlidingTileState constructor.";
         cerr << "Permutation isn't the right size for given parameters";
         cerr << endl;
     }
+    if(perm.size() > MAX_TILE_PUZZLE_CELLS) {
+        cerr << "Error in SlidingTileState constructor.";
+        cerr << "Puzzle has more than " << MAX_TILE_PUZZLE_CELLS << " cells";
+        cerr << endl;
+        return;
+    }
 
-    for(unsigned i = 0; i < permutation.size(); i++) {
-        if(permutation[i] == 0) {
+    for(unsigned i = 0; i < perm.size(); i++) {
+        setTile(i, perm[i]);
+        if(perm[i] == 0) {
             blank_loc = i;
         }
     }
 }
 
+void TilePuzzleState::getPermutation(std::vector<unsigned>& perm) const
+{
+    perm.resize(size());
+    for(unsigned i = 0; i < perm.size(); i++)
+        perm[i] = (*this)[i];
+}
+
 ostream& operator <<(std::ostream& out, const TilePuzzleState& s)
 {
-    out << "(" << s.num_rows << "x" << s.num_cols << ")-[";
-    for(unsigned i = 0; i < s.permutation.size(); i++) {
-        out << s.permutation[i];
-        if(i > 1 && i < s.permutation.size() - 1 && (i + 1) % s.num_cols == 0)
+    out << "(" << (unsigned) s.num_rows << "x" << (unsigned) s.num_cols << ")-[";
+    for(unsigned i = 0; i < s.size(); i++) {
+        out << s[i];
+        if(i > 1 && i < s.size() - 1 && (i + 1) % s.num_cols == 0)
             out << ",";
-        if(i < s.permutation.size() - 1)
+        if(i < s.size() - 1)
             out << " ";
     }
     out << "]";
     return out;
 }
 
-bool operator ==(const TilePuzzleState& s1, const TilePuzzleState& s2)
-{
-    if((s1.permutation.size() != s2.permutation.size()) || (s1.blank_loc != s2.blank_loc))
-        return false;
-
-    for(unsigned i = 0; i < s1.permutation.size(); i++) {
-        if(s1.permutation[i] != s2.permutation[i])
-            return false;
-    }
-    return true;
-}
-
 bool operator !=(const TilePuzzleState& s1, const TilePuzzleState& s2)
 {
     return !(s1 == s2);
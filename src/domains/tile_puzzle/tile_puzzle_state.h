@@ -12,10 +12,20 @@
 
 #include <vector>
 #include <iostream>
+#include <cstdint>
+
+/**
+ * The largest number of cells a tile puzzle state can have.
+ */
+static const unsigned MAX_TILE_PUZZLE_CELLS = 16;
 
 /**
  * Defines a tile puzzle state.
  *
+ * The permutation is packed into a single 64-bit word, with the tile in each position stored in a 4-bit nibble (the
+ * tile in position i is in bits 4i to 4i + 3). This makes the state small enough to copy cheaply and means it never
+ * allocates memory, but limits it to puzzles with at most MAX_TILE_PUZZLE_CELLS cells.
+ *
  * @todo Is both equality and inequality actually needed?
  *
  * @class TilePuzzleState
@@ -31,7 +41,7 @@ public:
     /**
      * Destructor for a sliding tile puzzle state. Does nothing.
      */
-    virtual ~TilePuzzleState();
+    ~TilePuzzleState();
 
     /**
      * Creates a tile puzzle of the given dimensions.
@@ -44,20 +54,84 @@ public:
     /**
      * Creates a tile puzzle from the given permutation with the given dimensions.
      *
+     * Prints an error if the permutation does not match the dimensions or is too large to store.
+     *
      * @param perm The permutation as the basis of the puzzle.
      * @param rows The number of rows in the puzzle.
      * @param cols The number of columns in the puzzle.
      */
     TilePuzzleState(const std::vector<unsigned> &perm, const unsigned rows, const unsigned cols);
 
-    std::vector<unsigned> permutation; ///< The permutation representation of the state.
+    /**
+     * Returns the number of cells in the puzzle.
+     *
+     * @return The number of cells.
+     */
+    unsigned size() const;
+
+    /**
+     * Returns the tile in the given position.
+     *
+     * @param pos The position to check.
+     * @return The tile in that position, where 0 is the blank.
+     */
+    unsigned operator[](unsigned pos) const;
 
-    unsigned num_rows; ///< Number of rows in the state.
-    unsigned num_cols; ///< Number of columns in the state.
+    /**
+     * Puts the given tile in the given position, replacing whatever tile was there. Does not update the location of
+     * the blank.
+     *
+     * @param pos The position to change.
+     * @param tile The tile to put there.
+     */
+    void setTile(unsigned pos, unsigned tile);
 
-    unsigned blank_loc; ///< Location of the blank (or 0)
+    /**
+     * Moves the tile in the given position into the blank, so that the blank moves to that position.
+     *
+     * @param new_blank_loc The position of the tile to move.
+     */
+    void moveBlank(unsigned new_blank_loc);
+
+    /**
+     * Stores the permutation representation of the state in the given vector, replacing its contents.
+     *
+     * @param perm The vector to store the permutation in.
+     */
+    void getPermutation(std::vector<unsigned> &perm) const;
+
+    uint64_t packed_tiles; ///< The permutation representation of the state, with one nibble per position.
+
+    uint8_t num_rows; ///< Number of rows in the state.
+    uint8_t num_cols; ///< Number of columns in the state.
+
+    uint8_t blank_loc; ///< Location of the blank (or 0)
 };
 
+inline unsigned TilePuzzleState::size() const
+{
+    return num_rows * num_cols;
+}
+
+inline unsigned TilePuzzleState::operator[](unsigned pos) const
+{
+    return (unsigned) ((packed_tiles >> (4 * pos)) & 0xF);
+}
+
+inline void TilePuzzleState::setTile(unsigned pos, unsigned tile)
+{
+    packed_tiles &= ~((uint64_t) 0xF << (4 * pos));
+    packed_tiles |= (uint64_t) tile << (4 * pos);
+}
+
+inline void TilePuzzleState::moveBlank(unsigned new_blank_loc)
+{
+    // The blank's nibble is zero, so xoring the moving tile into both nibbles moves it into the blank's position
+    uint64_t tile = (packed_tiles >> (4 * new_blank_loc)) & 0xF;
+    packed_tiles ^= (tile << (4 * new_blank_loc)) | (tile << (4 * blank_loc));
+    blank_loc = new_blank_loc;
+}
+
 /**
  * Outputs a string representation of the sliding tile puzzle state to the given output stream.
  *
@@ -85,4 +159,9 @@ bool operator ==(const TilePuzzleState &s1, const TilePuzzleState &s2);
  */
 bool operator !=(const TilePuzzleState &s1, const TilePuzzleState &s2);
 
+inline bool operator ==(const TilePuzzleState& s1, const TilePuzzleState& s2)
+{
+    return s1.packed_tiles == s2.packed_tiles && s1.num_rows == s2.num_rows && s1.num_cols == s2.num_cols;
+}
+
 #endif /* TILEPUZZLESTATE_H_ */
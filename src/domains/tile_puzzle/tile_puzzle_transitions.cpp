@@ -39,21 +39,14 @@ double TilePuzzleTransitions::getActionCost(const TilePuzzleState& state, const
 
 void TilePuzzleTransitions::applyAction(TilePuzzleState& state, const BlankSlide& action) const
 {
-    if(action == BlankSlide::up) {
-        state.permutation[state.blank_loc] = state.permutation[state.blank_loc - num_cols];
-        state.blank_loc -= num_cols;
-    } else if(action == BlankSlide::right) {
-        state.permutation[state.blank_loc] = state.permutation[state.blank_loc + 1];
-        state.blank_loc++;
-    } else if(action == BlankSlide::down) {
-        state.permutation[state.blank_loc] = state.permutation[state.blank_loc + num_cols];
-        state.blank_loc += num_cols;
-    } else if(action == BlankSlide::left) {
-        state.permutation[state.blank_loc] = state.permutation[state.blank_loc - 1];
-        state.blank_loc--;
-    }
-
-    state.permutation[state.blank_loc] = 0;
+    if(action == BlankSlide::up)
+        state.moveBlank(state.blank_loc - num_cols);
+    else if(action == BlankSlide::right)
+        state.moveBlank(state.blank_loc + 1);
+    else if(action == BlankSlide::down)
+        state.moveBlank(state.blank_loc + num_cols);
+    else if(action == BlankSlide::left)
+        state.moveBlank(state.blank_loc - 1);
 }
 
 void TilePuzzleTransitions::getActions(const TilePuzzleState& state, vector<BlankSlide>& actions) const
@@ -62,6 +55,21 @@ void TilePuzzleTransitions::getActions(const TilePuzzleState& state, vector<Blan
         actions.push_back(loc_actions[state.blank_loc][i]);
 }
 
+void TilePuzzleTransitions::generateSuccessors(const TilePuzzleState& state,
+        SuccessorBuffer<TilePuzzleState, BlankSlide>& successors) const
+{
+    successors.clear();
+
+    const vector<BlankSlide> &actions = loc_actions[state.blank_loc];
+    for(unsigned i = 0; i < actions.size(); i++) {
+        Successor<TilePuzzleState, BlankSlide> &succ = successors.addSuccessor();
+        succ.action = actions[i];
+        succ.cost = getActionCost(state, actions[i]);
+        succ.state = state;
+        applyAction(succ.state, actions[i]);
+    }
+}
+
 bool TilePuzzleTransitions::isApplicableInLocation(const BlankSlide& action, unsigned blank_loc) const
 {
     if(action == BlankSlide::up) {
@@ -157,13 +165,13 @@ bool TilePuzzleTransitions::isDummyAction(const BlankSlide& action) const
 unsigned TilePuzzleTransitions::getMovingTile(const TilePuzzleState& state, const BlankSlide& action) const
 {
     if(action == BlankSlide::up)
-        return state.permutation[state.blank_loc - num_cols];
+        return state[state.blank_loc - num_cols];
     else if(action == BlankSlide::right)
-        return state.permutation[state.blank_loc + 1];
+        return state[state.blank_loc + 1];
     else if(action == BlankSlide::down)
-        return state.permutation[state.blank_loc + num_cols];
+        return state[state.blank_loc + num_cols];
     else if(action == BlankSlide::left)
-        return state.permutation[state.blank_loc - 1];
+        return state[state.blank_loc - 1];
     return 0;
 }
 
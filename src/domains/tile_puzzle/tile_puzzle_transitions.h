@@ -85,6 +85,8 @@ public:
     virtual double getActionCost(const TilePuzzleState &state, const BlankSlide &action) const;
     virtual void applyAction(TilePuzzleState &state, const BlankSlide &action) const;
     virtual void getActions(const TilePuzzleState &state, std::vector<BlankSlide> &actions) const;
+    virtual void generateSuccessors(const TilePuzzleState &state,
+            SuccessorBuffer<TilePuzzleState, BlankSlide> &successors) const;
     virtual bool isInvertible(const TilePuzzleState &state, const BlankSlide &action) const;
     virtual BlankSlide getInverse(const TilePuzzleState &state, const BlankSlide &action) const;
     BlankSlide getDummyAction() const;
@@ -76,14 +76,14 @@ int main(int argc, char **argv)
 
     a_star.setHeuristic(&manhattan);
     // a_star.setTieBreaker(&default);
-    a_star.setTieBreaker(tieBreaker);
+    a_star.setTieBreaker(static_cast<TieBreakType>(tieBreaker));
 
     weighted_a.setHeuristic(&manhattan);
-    weighted_a.setTieBreaker(tieBreaker);
+    weighted_a.setTieBreaker(static_cast<TieBreakType>(tieBreaker));
     weighted_a.setWeights(weight);
 
     gbfs.setHeuristic(&manhattan);
-    gbfs.setTieBreaker(tieBreaker);
+    gbfs.setTieBreaker(static_cast<TieBreakType>(tieBreaker));
 
     cout << "A* Star Search" << endl;  
 
@@ -108,7 +108,7 @@ int main(int argc, char **argv)
     starts.clear();
     goals.clear();
     read_in_pathfinding_probs("../src/domains/map_pathfinding/map_files/empty_grid.probs", starts, goals);
-    a_star.setTieBreaker(tieBreaker + 1);
+    a_star.setTieBreaker(static_cast<TieBreakType>(tieBreaker + 1));
 
     for(unsigned i = 0; i < starts.size(); i++) {
 
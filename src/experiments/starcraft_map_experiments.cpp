@@ -8,9 +8,11 @@
 #include <vector>
 #include <cstdint>
 #include <algorithm>
+#include <chrono>
 
 #include "../domains/map_pathfinding/map_pathfinding_transitions.h"
 #include "../domains/map_pathfinding/map_manhattan_distance.h"
+#include "../domains/map_pathfinding/map_octile_distance.h"
 #include "../domains/map_pathfinding/map_loc_hash_function.h"
 #include "../domains/map_pathfinding/map_utils.h"
 #include "../generic_defs/non_goal_heuristic.h"
@@ -18,6 +20,11 @@
 #include "../algorithms/best_first_search/a_star.h"
 #include "../algorithms/best_first_search/weighted_a.h"
 #include "../algorithms/best_first_search/gbfs.h"
+#include "../algorithms/best_first_search/static_best_first_search.h"
+#include "../algorithms/jump_point_search/jump_point_search.h"
+#include "../algorithms/subgoal_graph/subgoal_graph_search.h"
+#include "../algorithms/hpa_star/hpa_star.h"
+#include "../algorithms/path_database/compressed_path_database.h"
 #include "../utils/string_utils.h"
 #include "../utils/vector_ops.h"
 
@@ -62,11 +69,14 @@ int main(int argc, char **argv)
 
     int tiebreaker = 0;
     double weight = 1;
+    int use_path_database = 0;
 
     if (argc > 1) {
         tiebreaker = atoi(argv[1]);
     } if (argc > 2) {
         weight = atoi(argv[2]);
+    } if (argc > 3) {
+        use_path_database = atoi(argv[3]);
     }
 
 
@@ -107,7 +117,10 @@ int main(int argc, char **argv)
     // a_high_g.setHeuristic(&manhattan);
 
     a_star.setWeights(weight);
-    a_star.setTieBreaker(tiebreaker);
+    a_star.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+
+    // Cell indices are a perfect hash, so search memory is reused across problems without any per-node allocation
+    a_star.setNodeTableBackend(NodeTableBackend::direct_index);
 
     starts.clear();
     goals.clear();
@@ -140,6 +153,208 @@ int main(int argc, char **argv)
     cout << "Median unique cost: " << median_unique << endl;
     cout << "Average unique cost: " << average_unique << endl;
 
+    // 8-connected comparison of A*, Jump Point Search and subgoal graphs, which should find the same costs. The statically
+    // typed A* should also make the same expansions as A*
+    map_ops.set8Connected();
+
+    MapOctileDistance octile;
+
+    AStar<MapLocation, MapDir> a_star_8;
+    a_star_8.setTransitionSystem(&map_ops);
+    a_star_8.setGoalTest(&goal_test);
+    a_star_8.setHashFunction(&map_hash);
+    a_star_8.setHeuristic(&octile);
+    a_star_8.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+    a_star_8.setNodeTableBackend(NodeTableBackend::direct_index);
+
+    // A* with the search components given as template parameters, which should make the same expansions as a_star_8
+    StaticBestFirstSearch<MapLocation, MapDir, MapPathfindingTransitions, MapOctileDistance, MapLocHashFunction,
+            AStarEval> static_a_star_8;
+    static_a_star_8.setTransitionSystem(&map_ops);
+    static_a_star_8.setGoalTest(&goal_test);
+    static_a_star_8.setHashFunction(&map_hash);
+    static_a_star_8.setHeuristic(&octile);
+    static_a_star_8.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+    static_a_star_8.setNodeTableBackend(NodeTableBackend::direct_index);
+
+    JumpPointSearch jps;
+    jps.setTransitionSystem(&map_ops);
+    jps.setGoalTest(&goal_test);
+    jps.setHeuristic(&octile);
+    jps.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+
+    // JPS+ loads its jump distances from a file in the binary directory, which is created on the first run
+    JumpDistanceTable jump_table;
+    jump_table.loadOrBuild("../bin/starcraft_bgh.map.jps", map_ops);
+
+    JumpPointSearch jps_plus;
+    jps_plus.setTransitionSystem(&map_ops);
+    jps_plus.setGoalTest(&goal_test);
+    jps_plus.setHeuristic(&octile);
+    jps_plus.setJumpDistanceTable(&jump_table);
+    jps_plus.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+
+    SubgoalGraph subgoal_graph;
+    subgoal_graph.build(map_ops);
+
+    SubgoalGraphSearch subgoal_search;
+    subgoal_search.setTransitionSystem(&map_ops);
+    subgoal_search.setGoalTest(&goal_test);
+    subgoal_search.setHeuristic(&octile);
+    subgoal_search.setSubgoalGraph(&subgoal_graph);
+    subgoal_search.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+
+    // HPA* is not optimal, so its costs are compared separately
+    ClusterAbstraction abstraction;
+    abstraction.build(map_ops);
+
+    HpaStar hpa_star;
+    hpa_star.setTransitionSystem(&map_ops);
+    hpa_star.setGoalTest(&goal_test);
+    hpa_star.setHeuristic(&octile);
+    hpa_star.setAbstraction(&abstraction);
+    hpa_star.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+
+    vector<int> a_star_8_count(starts.size());
+    vector<int> static_a_star_8_count(starts.size());
+    vector<double> a_star_8_costs(starts.size());
+    vector<int> jps_count(starts.size());
+    vector<int> jps_plus_count(starts.size());
+    vector<int> subgoal_count(starts.size());
+    vector<int> hpa_star_count(starts.size());
+    double a_star_8_total_cost = 0.0;
+    double hpa_star_total_cost = 0.0;
+    unsigned cost_mismatches = 0;
+
+    for(unsigned i = 0; i < starts.size(); i++) {
+        goal_test.setGoal(goals[i]);
+        octile.setGoal(goals[i]);
+
+        a_star_8.getPlan(starts[i], solution);
+        a_star_8_count[i] = a_star_8.getGoalTestCount();
+        a_star_8_costs[i] = a_star_8.getLastPlanCost();
+
+        static_a_star_8.getPlan(starts[i], solution);
+        static_a_star_8_count[i] = static_a_star_8.getGoalTestCount();
+
+        jps.getPlan(starts[i], solution);
+        jps_count[i] = jps.getGoalTestCount();
+
+        jps_plus.getPlan(starts[i], solution);
+        jps_plus_count[i] = jps_plus.getGoalTestCount();
+
+        subgoal_search.getPlan(starts[i], solution);
+        subgoal_count[i] = subgoal_search.getGoalTestCount();
+
+        hpa_star.getPlan(starts[i], solution);
+        hpa_star_count[i] = hpa_star.getGoalTestCount();
+        if(a_star_8.getLastPlanCost() >= 0.0 && hpa_star.getLastPlanCost() >= 0.0) {
+            a_star_8_total_cost += a_star_8.getLastPlanCost();
+            hpa_star_total_cost += hpa_star.getLastPlanCost();
+        }
+
+        if(!fp_equal(a_star_8.getLastPlanCost(), static_a_star_8.getLastPlanCost())
+                || a_star_8_count[i] != static_a_star_8_count[i]
+                || !fp_equal(a_star_8.getLastPlanCost(), jps.getLastPlanCost())
+                || !fp_equal(a_star_8.getLastPlanCost(), jps_plus.getLastPlanCost())
+                || !fp_equal(a_star_8.getLastPlanCost(), subgoal_search.getLastPlanCost()))
+            cost_mismatches++;
+    }
+
+    cout << "8-connected A Star median nodes: " << compute_median(a_star_8_count) << endl;
+    cout << "8-connected static A Star median nodes: " << compute_median(static_a_star_8_count) << endl;
+    cout << "8-connected JPS median nodes: " << compute_median(jps_count) << endl;
+    cout << "8-connected JPS+ median nodes: " << compute_median(jps_plus_count) << endl;
+    cout << "8-connected subgoal graph median nodes: " << compute_median(subgoal_count) << endl;
+    cout << "Subgoal graph size: " << subgoal_graph.getNumSubgoals() << " subgoals, " << subgoal_graph.getNumEdges()
+            << " edges" << endl;
+    cout << "8-connected HPA* median nodes: " << compute_median(hpa_star_count) << endl;
+    cout << "HPA* total cost over optimal: " << hpa_star_total_cost / a_star_8_total_cost << endl;
+    cout << "Cost mismatches: " << cost_mismatches << endl;
+
+    // Goal test limits with each statistics policy. The exact policy stops a search as soon as it hits the limit, while
+    // the batched one only checks it every 64 expansions, so it may finish a search that is just over the limit. The
+    // policy with no counters ignores the limit, so it should solve every problem with the same cost as A*.
+    const uint64_t goal_test_limit = 10000;
+    static_a_star_8.setGoalTestLimit(goal_test_limit);
+
+    StaticBestFirstSearch<MapLocation, MapDir, MapPathfindingTransitions, MapOctileDistance, MapLocHashFunction,
+            AStarEval, ConfigurableTieBreaking, BatchedSearchStats<64> > batched_a_star_8;
+    StaticBestFirstSearch<MapLocation, MapDir, MapPathfindingTransitions, MapOctileDistance, MapLocHashFunction,
+            AStarEval, ConfigurableTieBreaking, NoSearchStats> uncounted_a_star_8;
+
+    batched_a_star_8.setTransitionSystem(&map_ops);
+    batched_a_star_8.setGoalTest(&goal_test);
+    batched_a_star_8.setHashFunction(&map_hash);
+    batched_a_star_8.setHeuristic(&octile);
+    batched_a_star_8.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+    batched_a_star_8.setNodeTableBackend(NodeTableBackend::direct_index);
+    batched_a_star_8.setGoalTestLimit(goal_test_limit);
+
+    uncounted_a_star_8.setTransitionSystem(&map_ops);
+    uncounted_a_star_8.setGoalTest(&goal_test);
+    uncounted_a_star_8.setHashFunction(&map_hash);
+    uncounted_a_star_8.setHeuristic(&octile);
+    uncounted_a_star_8.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+    uncounted_a_star_8.setNodeTableBackend(NodeTableBackend::direct_index);
+    uncounted_a_star_8.setGoalTestLimit(goal_test_limit);
+
+    unsigned exact_stops = 0;
+    unsigned batched_stops = 0;
+    unsigned uncounted_stops = 0;
+    unsigned uncounted_mismatches = 0;
+
+    for(unsigned i = 0; i < starts.size(); i++) {
+        goal_test.setGoal(goals[i]);
+        octile.setGoal(goals[i]);
+
+        if(static_a_star_8.getPlan(starts[i], solution) == SearchTermType::res_limit)
+            exact_stops++;
+        if(batched_a_star_8.getPlan(starts[i], solution) == SearchTermType::res_limit)
+            batched_stops++;
+        if(uncounted_a_star_8.getPlan(starts[i], solution) == SearchTermType::res_limit)
+            uncounted_stops++;
+
+        if(!fp_equal(a_star_8_costs[i], uncounted_a_star_8.getLastPlanCost()))
+            uncounted_mismatches++;
+    }
+
+    cout << "Searches stopped at " << goal_test_limit << " goal tests, exact limits: " << exact_stops << endl;
+    cout << "Searches stopped at " << goal_test_limit << " goal tests, batched limits: " << batched_stops << endl;
+    cout << "Searches stopped at " << goal_test_limit << " goal tests, no counters: " << uncounted_stops
+            << " (cost mismatches: " << uncounted_mismatches << ")" << endl;
+
+    // The compressed path database runs a Dijkstra search from every location when it is built, which takes a long time
+    // on a map of this size, so it is only used if asked for. It is built with all hardware threads on the first run and
+    // memory-mapped from its file in the binary directory after that.
+    if(use_path_database) {
+        CompressedPathDatabase path_database;
+        auto ready_start = std::chrono::steady_clock::now();
+        path_database.loadOrBuild("../bin/starcraft_bgh.map.cpd", map_ops);
+        std::chrono::duration<double> ready_time = std::chrono::steady_clock::now() - ready_start;
+
+        unsigned path_database_mismatches = 0;
+        vector<MapDir> path;
+        for(unsigned i = 0; i < starts.size(); i++) {
+            double path_cost = -1.0;
+            if(path_database.getPath(starts[i], goals[i], path)) {
+                path_cost = 0.0;
+                MapLocation current = starts[i];
+                for(MapDir move : path) {
+                    path_cost += map_ops.getActionCost(current, move);
+                    map_ops.applyAction(current, move);
+                }
+            }
+
+            if(!fp_equal(a_star_8_costs[i], path_cost))
+                path_database_mismatches++;
+        }
+
+        cout << "Compressed path database: " << path_database.getNumRuns() << " runs, ready in " << ready_time.count()
+                << "s" << endl;
+        cout << "Compressed path database cost mismatches: " << path_database_mismatches << endl;
+    }
+
     // double default_median = compute_median(default_nodes);
     // double low_g_median = compute_median(low_g_nodes);
     // double high_g_median = compute_median(high_g_nodes);
@@ -14,8 +14,11 @@
 #include "../generic_defs/single_goal_test.h"
 #include "../algorithms/best_first_search/weighted_a.h"
 #include "../algorithms/best_first_search/gbfs.h"
+#include "../algorithms/best_first_search/a_star.h"
+#include "../algorithms/best_first_search/static_best_first_search.h"
 #include "../generic_defs/permutation_hash_function.h"
 #include "../utils/combinatorics.h"
+#include "../utils/floating_point_utils.h"
 
 #include <cstdint>
 
@@ -134,8 +137,8 @@ int main(int argc, char **argv)
     a_1.setHeuristic(&manhattan);
     a_low.setHeuristic(&manhattan);
 
-    a_1.setTieBreaker(tiebreaker);
-    a_low.setTieBreaker(tiebreaker);
+    a_1.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+    a_low.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
 
     a_1.setWeights(weight);
     a_low.setWeights(weight);
@@ -196,6 +199,37 @@ int main(int argc, char **argv)
     cout << re_cost_greater << endl;
     cout << re_cost_equal << endl;
 
+    // A* with the search components given as template parameters, which should make the same expansions as AStar
+    AStar<TilePuzzleState, BlankSlide> a_star;
+    a_star.setTransitionSystem(&tile_ops);
+    a_star.setGoalTest(&goal_test);
+    a_star.setHashFunction(&tile_hash);
+    a_star.setHeuristic(&manhattan);
+    a_star.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+
+    StaticBestFirstSearch<TilePuzzleState, BlankSlide, TilePuzzleTransitions, TileManhattanDistance,
+            PermutationHashFunction<TilePuzzleState>, AStarEval> static_a_star;
+    static_a_star.setTransitionSystem(&tile_ops);
+    static_a_star.setGoalTest(&goal_test);
+    static_a_star.setHashFunction(&tile_hash);
+    static_a_star.setHeuristic(&manhattan);
+    static_a_star.setTieBreaker(static_cast<TieBreakType>(tiebreaker));
+
+    int static_mismatches = 0;
+    for (unsigned i = 0; i < starts.size(); i++) {
+        TilePuzzleState start_state(starts[i], 3, 4);
+
+        a_star.getPlan(start_state, solution);
+        static_a_star.getPlan(start_state, solution);
+
+        if (!fp_equal(a_star.getLastPlanCost(), static_a_star.getLastPlanCost())
+                || a_star.getGoalTestCount() != static_a_star.getGoalTestCount()) {
+            static_mismatches++;
+        }
+    }
+
+    cout << "Static A Star mismatches: " << static_mismatches << endl;
+
     // double median_nodes = compute_median(node_count);
     // double average_nodes = compute_average(node_count);
     // double variance_nodes = compute_variance(node_count, average_nodes);
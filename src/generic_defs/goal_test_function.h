@@ -13,6 +13,9 @@
 /**
  * Abstract class for defining a goal test function.
  *
+ * The goal test is const, and descendents must keep it safe to call concurrently so that several searches can share
+ * one goal test object.
+ *
  * @class GoalTestFunction
  */
 template<class state_t>
@@ -36,6 +39,14 @@ public:
      * @return If the given state is a goal state.
      */
     virtual bool isGoal(const state_t &state) const = 0;
+
+    /**
+     * Returns the only goal state, if there is exactly one. Search engines use it to check if the goal can be reached
+     * before searching.
+     *
+     * @return A pointer to the goal state, or 0 if there is not exactly one goal state.
+     */
+    virtual const state_t *getUniqueGoal() const;
 };
 
 template<class state_t>
@@ -48,4 +59,10 @@ GoalTestFunction<state_t>::~GoalTestFunction()
 {
 }
 
+template<class state_t>
+const state_t *GoalTestFunction<state_t>::getUniqueGoal() const
+{
+    return 0;
+}
+
 #endif /* GOALTESTFUNCTION_H_ */
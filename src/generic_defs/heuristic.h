@@ -10,6 +10,11 @@
 #ifndef HEURISTIC_H_
 #define HEURISTIC_H_
 
+#include "../utils/cpu_features.h"
+
+#include <cstddef>
+#include <iostream>
+
 /**
  * Abstract class for defining a heuristic function.
  *
@@ -17,6 +22,10 @@
  * indicating that the problem is unsolvable from the current state. The intended way to calculate
  * a heuristic will then be call prepareToCompute, and then computeHeuristic.
  *
+ * The const functions (computeHValue, computeHValues, and their equivalents in descendents) do not modify the
+ * heuristic, so they can be called concurrently by several searches sharing one heuristic object and any tables it
+ * owns. Descendents must keep them reentrant. The other functions store the last heuristic value and cannot be shared.
+ *
  * @class Heuristic
  */
 template<class state_t>
@@ -68,28 +77,70 @@ public:
      */
     bool isHValueStored() const;
 
-protected:
+    /**
+     * Calculates the heuristic values of a batch of states and stores them in the given array. Does not store them as
+     * the last heuristic value.
+     *
+     * By default, calls computeHValue on each state. Descendents can overwrite this with a vectorized version, which
+     * should use the instruction set given by getSimdLevel and return exactly the values computeHValue would. Like
+     * computeHValue, it is safe to call concurrently from several threads.
+     *
+     * @param states The states whose heuristic values are to be calculated.
+     * @param num_states The number of states.
+     * @param h_values The array to store the heuristic values in. Must have room for num_states values.
+     */
+    virtual void computeHValues(const state_t * const *states, std::size_t num_states, double *h_values) const;
+
+    /**
+     * Sets the vector instruction set used by computeHValues. Defaults to the best one supported.
+     *
+     * False is returned if the processor or build does not support the given instruction set.
+     *
+     * @param level The instruction set to use.
+     * @return If the instruction set was successfully set.
+     */
+    bool setSimdLevel(SimdLevel level);
+
+    /**
+     * Returns the vector instruction set used by computeHValues.
+     *
+     * @return The instruction set in use.
+     */
+    SimdLevel getSimdLevel() const;
+
     /**
      * Calculates the heuristic value of the given state. Does not store the heuristic value.
      *
      * If the heuristic value is negative, the heuristic function is indicating unsolvability.
      *
-     * This is the main function to be overloaded.
+     * This is the main function to be overloaded. It is safe to call concurrently from several threads.
      *
      * @param state The state whose heuristic value is to be calculated.
      * @return The heuristic value of the given state.
      */
     virtual double computeHValue(const state_t &state) const = 0;
 
+protected:
+
+    /**
+     * Stores the given heuristic value as the last heuristic value computed.
+     *
+     * @param h_value The heuristic value to store.
+     * @return The given heuristic value.
+     */
+    double storeHValue(double h_value);
+
 private:
     double last_h; ///< The last heuristic value calculated.
 
     bool h_stored; ///< Is the heuristic value currently stored.
+
+    SimdLevel simd_level; ///< The vector instruction set used for batches of states.
 };
 
 template<class state_t>
 Heuristic<state_t>::Heuristic()
-        : last_h(0.0), h_stored(false)
+        : last_h(0.0), h_stored(false), simd_level(getSupportedSimdLevel())
 {
 }
 
@@ -101,10 +152,7 @@ Heuristic<state_t>::~Heuristic()
 template<class state_t>
 double Heuristic<state_t>::getHValue(const state_t& state)
 {
-    last_h = computeHValue(state);
-
-    h_stored = true;
-    return last_h;
+    return storeHValue(computeHValue(state));
 }
 
 template<class state_t>
@@ -126,4 +174,37 @@ inline bool Heuristic<state_t>::isHValueStored() const
     return h_stored;
 }
 
+template<class state_t>
+void Heuristic<state_t>::computeHValues(const state_t * const *states, std::size_t num_states, double *h_values) const
+{
+    for(std::size_t i = 0; i < num_states; i++)
+        h_values[i] = computeHValue(*states[i]);
+}
+
+template<class state_t>
+bool Heuristic<state_t>::setSimdLevel(SimdLevel level)
+{
+    if(!isSimdLevelSupported(level)) {
+        std::cerr << "The requested vector instruction set is not supported." << std::endl;
+        return false;
+    }
+    simd_level = level;
+    return true;
+}
+
+template<class state_t>
+inline SimdLevel Heuristic<state_t>::getSimdLevel() const
+{
+    return simd_level;
+}
+
+template<class state_t>
+inline double Heuristic<state_t>::storeHValue(double h_value)
+{
+    last_h = h_value;
+
+    h_stored = true;
+    return last_h;
+}
+
 #endif /* HEURISTIC_H_ */
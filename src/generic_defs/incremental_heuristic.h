@@ -0,0 +1,93 @@
+/*
+ * incremental_heuristic.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef INCREMENTAL_HEURISTIC_H_
+#define INCREMENTAL_HEURISTIC_H_
+
+#include "heuristic.h"
+
+/**
+ * Abstract class for heuristics that can compute the heuristic value of a child state from the heuristic value of its
+ * parent and the action that generated it.
+ *
+ * Descendents should overwrite computeChildHValue with an update that is cheaper than computing the heuristic value
+ * from scratch. The value it returns must equal the one computeHValue would return for the child. By default, it just
+ * calls computeHValue on the child.
+ *
+ * @class IncrementalHeuristic
+ */
+template<class state_t, class action_t>
+class IncrementalHeuristic: public Heuristic<state_t>
+{
+public:
+    /**
+     * Constructor for the abstract incremental heuristic class. Abstract constructor is empty.
+     */
+    IncrementalHeuristic();
+
+    /**
+     * Destructor for the abstract incremental heuristic class. Abstract destructor is empty.
+     */
+    virtual ~IncrementalHeuristic();
+
+    /**
+     * Gets and returns the heuristic value of the given child state, and stores it as the last heuristic value.
+     *
+     * To get the heuristic value, calls computeChildHValue.
+     *
+     * @param parent The parent state.
+     * @param parent_h The heuristic value of the parent state.
+     * @param action The action applied to the parent to generate the child.
+     * @param child The state whose heuristic value is to be calculated.
+     * @return The heuristic value of the child state.
+     */
+    double getChildHValue(const state_t &parent, double parent_h, const action_t &action, const state_t &child);
+
+    /**
+     * Calculates the heuristic value of the given child state from the heuristic value of its parent. Does not store
+     * the heuristic value.
+     *
+     * Public so that engines that know the type of the heuristic can call it directly. Like computeHValue, it is safe
+     * to call concurrently from several threads.
+     *
+     * @param parent The parent state.
+     * @param parent_h The heuristic value of the parent state.
+     * @param action The action applied to the parent to generate the child.
+     * @param child The state whose heuristic value is to be calculated.
+     * @return The heuristic value of the child state.
+     */
+    virtual double computeChildHValue(const state_t &parent, double parent_h, const action_t &action,
+            const state_t &child) const;
+};
+
+template<class state_t, class action_t>
+IncrementalHeuristic<state_t, action_t>::IncrementalHeuristic()
+{
+}
+
+template<class state_t, class action_t>
+IncrementalHeuristic<state_t, action_t>::~IncrementalHeuristic()
+{
+}
+
+template<class state_t, class action_t>
+inline double IncrementalHeuristic<state_t, action_t>::getChildHValue(const state_t& parent, double parent_h,
+        const action_t& action, const state_t& child)
+{
+    return this->storeHValue(computeChildHValue(parent, parent_h, action, child));
+}
+
+template<class state_t, class action_t>
+double IncrementalHeuristic<state_t, action_t>::computeChildHValue(const state_t& parent, double parent_h,
+        const action_t& action, const state_t& child) const
+{
+    return this->computeHValue(child);
+}
+
+#endif /* INCREMENTAL_HEURISTIC_H_ */
@@ -13,20 +13,87 @@
 #include "state_hash_function.h"
 #include "../utils/combinatorics.h"
 #include <vector>
+#include <cassert>
 
+/**
+ * The largest permutation whose rank is guaranteed to fit in a StateHash.
+ */
+static const unsigned MAX_HASHED_PERMUTATION_SIZE = 20;
+
+/**
+ * A hash function that maps each permutation to its rank in the lexicographic ordering of all permutations of the same
+ * size.
+ *
+ * Ranks are computed in linear time by counting the smaller elements already seen with a bit mask. Children that
+ * differ from their parent by the swap of two elements (such as those generated by moving the blank in a tile puzzle)
+ * can also be ranked by updating the parent's rank, in time proportional to the distance between the swapped
+ * positions.
+ *
+ * The state type must have a size() function returning the number of elements in the permutation, and an operator[]
+ * that returns the element in a given position. Permutations can have at most MAX_HASHED_PERMUTATION_SIZE elements.
+ *
+ * @class PermutationHashFunction
+ */
 template<class state_t>
 class PermutationHashFunction: public StateHashFunction<state_t>
 {
 public:
+    /**
+     * Constructor for the hash function. Caches the factorials used for ranking.
+     */
     PermutationHashFunction();
+
+    /**
+     * Destructor for the hash function. Does nothing.
+     */
     virtual ~PermutationHashFunction();
 
+    // Overloaded functions
     virtual StateHash getStateHash(const state_t &state) const;
+    virtual StateHash getChildStateHash(const state_t &parent, StateHash parent_hash, const state_t &child) const;
+
+    /**
+     * Returns the hash value of a permutation given the hash value of the permutation it is generated from by swapping
+     * the elements in the two given positions.
+     *
+     * @param state The permutation after the swap.
+     * @param hash_value The hash value of the permutation before the swap.
+     * @param pos1 One of the swapped positions.
+     * @param pos2 The other swapped position.
+     * @return The hash value of the given permutation.
+     */
+    StateHash getSwappedStateHash(const state_t &state, StateHash hash_value, unsigned pos1, unsigned pos2) const;
+
+    /**
+     * Finds the permutation of the given size with the given hash value and stores it in the given vector, replacing
+     * its contents.
+     *
+     * @param hash_value The hash value of the permutation.
+     * @param perm_size The size of the permutation.
+     * @param perm The vector to store the permutation in.
+     */
+    void getPermutation(StateHash hash_value, unsigned perm_size, std::vector<unsigned> &perm) const;
+
+protected:
+    /**
+     * Returns the number of elements after the given position that are smaller than the element in that position, for
+     * the permutation of the given size with the given hash value.
+     *
+     * @param hash_value The hash value of the permutation.
+     * @param perm_size The size of the permutation.
+     * @param pos The position to check.
+     * @return The number of smaller elements after the position.
+     */
+    StateHash getRankDigit(StateHash hash_value, unsigned perm_size, unsigned pos) const;
+
+    StateHash factorials[MAX_HASHED_PERMUTATION_SIZE + 1]; ///< The factorial of each permutation size.
 };
 
 template<class state_t>
 inline PermutationHashFunction<state_t>::PermutationHashFunction()
 {
+    for(unsigned i = 0; i <= MAX_HASHED_PERMUTATION_SIZE; i++)
+        factorials[i] = get_64_bit_factorial(i);
 }
 
 template<class state_t>
@@ -37,19 +104,125 @@ inline PermutationHashFunction<state_t>::~PermutationHashFunction()
 template<class state_t>
 StateHash PermutationHashFunction<state_t>::getStateHash(const state_t& state) const
 {
-    std::vector<unsigned> permutation = state.permutation;
+    unsigned perm_size = state.size();
+    assert(perm_size <= MAX_HASHED_PERMUTATION_SIZE);
 
     StateHash hash_value = 0;
-    unsigned num_left = permutation.size();
-    for(unsigned i = 0; i < permutation.size(); i++) {
-        hash_value += permutation[i] * get_64_bit_factorial(num_left - 1);
-        num_left--;
-        for(unsigned j = i + 1; j < permutation.size(); j++) {
-            if(permutation[j] > permutation[i])
-                permutation[j]--;
-        }
+    uint32_t seen = 0; // bit v is set if element v is in an earlier position
+    for(unsigned i = 0; i < perm_size; i++) {
+        unsigned element = state[i];
+        unsigned smaller_after = element - __builtin_popcount(seen & ((1u << element) - 1));
+
+        hash_value += smaller_after * factorials[perm_size - i - 1];
+        seen |= 1u << element;
     }
     return hash_value;
 }
 
+template<class state_t>
+StateHash PermutationHashFunction<state_t>::getChildStateHash(const state_t& parent, StateHash parent_hash,
+        const state_t& child) const
+{
+    unsigned perm_size = child.size();
+    unsigned changed[2];
+    unsigned num_changed = 0;
+
+    for(unsigned i = 0; i < perm_size; i++) {
+        if(parent[i] != child[i]) {
+            if(num_changed == 2)
+                return getStateHash(child);
+            changed[num_changed++] = i;
+        }
+    }
+
+    if(num_changed == 0)
+        return parent_hash;
+    if(num_changed != 2)
+        return getStateHash(child);
+    return getSwappedStateHash(child, parent_hash, changed[0], changed[1]);
+}
+
+template<class state_t>
+StateHash PermutationHashFunction<state_t>::getSwappedStateHash(const state_t& state, StateHash hash_value,
+        unsigned pos1, unsigned pos2) const
+{
+    unsigned perm_size = state.size();
+    unsigned low_pos = pos1 < pos2 ? pos1 : pos2;
+    unsigned high_pos = pos1 < pos2 ? pos2 : pos1;
+
+    if(low_pos == high_pos)
+        return hash_value;
+
+    unsigned low_element = state[high_pos]; // the element that was in the lower position before the swap
+    unsigned high_element = state[low_pos]; // the element that was in the higher position before the swap
+
+    StateHash old_low_digit = getRankDigit(hash_value, perm_size, low_pos);
+    StateHash old_high_digit = getRankDigit(hash_value, perm_size, high_pos);
+
+    // The digits of positions between the swapped ones change if their element is between the swapped elements
+    StateHash new_hash = hash_value;
+    StateHash between_below_low = 0;
+    StateHash between_below_high = 0;
+    for(unsigned i = low_pos + 1; i < high_pos; i++) {
+        unsigned element = state[i];
+        if(element < low_element)
+            between_below_low++;
+        if(element < high_element)
+            between_below_high++;
+
+        if(low_element < element && element < high_element)
+            new_hash += factorials[perm_size - i - 1];
+        else if(high_element < element && element < low_element)
+            new_hash -= factorials[perm_size - i - 1];
+    }
+
+    // The number of smaller elements after the higher position is known from the old digits
+    StateHash after_below_high = old_high_digit;
+    StateHash after_below_low = old_low_digit - between_below_low - (high_element < low_element ? 1 : 0);
+
+    StateHash new_low_digit = between_below_high + (low_element < high_element ? 1 : 0) + after_below_high;
+    StateHash new_high_digit = after_below_low;
+
+    new_hash += new_low_digit * factorials[perm_size - low_pos - 1];
+    new_hash -= old_low_digit * factorials[perm_size - low_pos - 1];
+    new_hash += new_high_digit * factorials[perm_size - high_pos - 1];
+    new_hash -= old_high_digit * factorials[perm_size - high_pos - 1];
+
+    return new_hash;
+}
+
+template<class state_t>
+void PermutationHashFunction<state_t>::getPermutation(StateHash hash_value, unsigned perm_size,
+        std::vector<unsigned>& perm) const
+{
+    assert(perm_size <= MAX_HASHED_PERMUTATION_SIZE);
+    perm.resize(perm_size);
+
+    uint32_t used = 0; // bit v is set if element v has been placed
+    for(unsigned i = 0; i < perm_size; i++) {
+        StateHash smaller_after = hash_value / factorials[perm_size - i - 1];
+        hash_value %= factorials[perm_size - i - 1];
+
+        // find the unused element with the given number of smaller unused elements
+        unsigned element = 0;
+        while((used >> element) & 1)
+            element++;
+        for(StateHash skipped = 0; skipped < smaller_after; skipped++) {
+            element++;
+            while((used >> element) & 1)
+                element++;
+        }
+
+        perm[i] = element;
+        used |= 1u << element;
+    }
+}
+
+template<class state_t>
+inline StateHash PermutationHashFunction<state_t>::getRankDigit(StateHash hash_value, unsigned perm_size,
+        unsigned pos) const
+{
+    return (hash_value / factorials[perm_size - pos - 1]) % (perm_size - pos);
+}
+
 #endif /* PERMUTATION_HASH_FUNCTION_H_ */
@@ -56,6 +56,11 @@ enum class SearchTermType
 /**
  * Defines a template for a search algorithm.
  *
+ * Engines only use the const functions of the transition system, goal test, heuristic, and hash function they are
+ * given. Several engines, each in its own thread, can therefore share components that do not change between queries,
+ * such as a loaded map or a precomputed heuristic table (see MapDifferentialTable). Goal tests and heuristics that hold
+ * the goal of a query must be one per thread, as must the engine itself.
+ *
  * @class SearchEngine
  */
 template<class state_t, class action_t>
@@ -102,7 +107,8 @@ public:
      *
      * If no plan exists or was found before a specified resource limit, the returned plan is set to be empty and
      * the reason for the termination is returned. The function also checks to make sure that the engine is ready
-     * to search for a plan prior to search beginning.
+     * to search for a plan prior to search beginning. If the goal test has a unique goal that the transition system
+     * says is unreachable, no search is done.
      *
      * @param init_state The initial state to find a solution from.
      * @param sol_plan A solution plan, if one exists.
@@ -361,6 +367,14 @@ SearchTermType SearchEngine<state_t, action_t>::getPlan(const state_t& init_stat
     if(alg_status == SearchStatus::not_ready)
         return SearchTermType::engine_not_ready;
 
+    // Some domains can tell without searching that the goal can't be reached
+    const state_t *unique_goal = goal_test->getUniqueGoal();
+    if(unique_goal && !op_system->isReachable(init_state, *unique_goal)) {
+        alg_status = SearchStatus::terminated;
+        sol_plan.clear();
+        return SearchTermType::completed;
+    }
+
     alg_status = SearchStatus::active;
     SearchTermType term = searchForPlan(init_state);
 
@@ -34,6 +34,7 @@ public:
     virtual ~SingleGoalTest();
 
     virtual bool isGoal(const state_t &state) const;
+    virtual const state_t *getUniqueGoal() const;
 
     /**
      * Resets the goal state to a new given state.
@@ -70,6 +71,12 @@ bool SingleGoalTest<state_t>::isGoal(const state_t& state) const
     return (goal == state);
 }
 
+template<class state_t>
+const state_t *SingleGoalTest<state_t>::getUniqueGoal() const
+{
+    return &goal;
+}
+
 template<class state_t>
 void SingleGoalTest<state_t>::setGoal(const state_t& g)
 {
@@ -16,6 +16,9 @@ typedef uint64_t StateHash; ///< The hash value of a state.
 /**
  * An abstract class defining a hash function for states.
  *
+ * All hash computations are const, and descendents must keep them safe to call concurrently so that several searches
+ * can share one hash function object.
+ *
  * @class StateHashFunction
  */
 template<class state_t>
@@ -39,6 +42,19 @@ public:
      * @return The hash value of the given state.
      */
     virtual StateHash getStateHash(const state_t &state) const = 0;
+
+    /**
+     * Returns the hash value of a child of the given parent state, given the hash value of the parent.
+     *
+     * Hash functions that can update the parent's hash value faster than they can compute the child's from scratch
+     * should override this. By default, just computes the hash value of the child.
+     *
+     * @param parent The parent state.
+     * @param parent_hash The hash value of the parent state.
+     * @param child The child state.
+     * @return The hash value of the child state.
+     */
+    virtual StateHash getChildStateHash(const state_t &parent, StateHash parent_hash, const state_t &child) const;
 };
 
 template<class state_t>
@@ -51,4 +67,11 @@ StateHashFunction<state_t>::~StateHashFunction()
 {
 }
 
+template<class state_t>
+StateHash StateHashFunction<state_t>::getChildStateHash(const state_t& parent, StateHash parent_hash,
+        const state_t& child) const
+{
+    return getStateHash(child);
+}
+
 #endif /* STATE_HASH_FUNCTION_H_ */
@@ -0,0 +1,160 @@
+/*
+ * successor_buffer.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#ifndef SUCCESSOR_BUFFER_H_
+#define SUCCESSOR_BUFFER_H_
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+/**
+ * A single successor of a state: the action that generates it, the cost of that action, and the resulting state.
+ *
+ * @class Successor
+ */
+template<class state_t, class action_t>
+struct Successor
+{
+    action_t action; ///< The action that generates the successor.
+    double cost; ///< The cost of the action.
+    state_t state; ///< The successor state.
+};
+
+/**
+ * A caller-owned buffer that TransitionSystem::generateSuccessors fills with the successors of a state.
+ *
+ * Records are never destroyed when the buffer is cleared, so once the buffer has held as many successors as the
+ * largest branching factor seen, filling it again does not allocate any memory. Domains write each successor directly
+ * into the record returned by addSuccessor, which also lets states that own memory reuse it between calls.
+ *
+ * @class SuccessorBuffer
+ */
+template<class state_t, class action_t>
+class SuccessorBuffer
+{
+public:
+    /**
+     * Constructor for the buffer. The buffer starts empty with no capacity.
+     */
+    SuccessorBuffer();
+
+    /**
+     * Makes room for the given number of successors, so that filling the buffer with up to that many does not
+     * allocate.
+     *
+     * @param capacity The number of successors to make room for.
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * Removes all successors from the buffer. Keeps the records for reuse.
+     */
+    void clear();
+
+    /**
+     * Adds a successor to the end of the buffer and returns it so that it can be filled in. The fields of the returned
+     * record hold whatever values were last stored in it.
+     *
+     * @return The new successor record.
+     */
+    Successor<state_t, action_t> &addSuccessor();
+
+    /**
+     * Returns the number of successors in the buffer.
+     *
+     * @return The number of successors.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the successor at the given position.
+     *
+     * @param i The position of the successor.
+     * @return The successor.
+     */
+    Successor<state_t, action_t> &operator[](std::size_t i);
+
+    /**
+     * Returns the successor at the given position.
+     *
+     * @param i The position of the successor.
+     * @return The successor.
+     */
+    const Successor<state_t, action_t> &operator[](std::size_t i) const;
+
+    /**
+     * Returns a list that can be used to hold actions while filling the buffer. Its contents are not otherwise used.
+     *
+     * @return The list of actions.
+     */
+    std::vector<action_t> &getActionScratch();
+
+protected:
+    std::vector<Successor<state_t, action_t> > records; ///< The successor records, including unused ones.
+    std::size_t num_successors; ///< The number of records currently in use.
+
+    std::vector<action_t> action_scratch; ///< A reusable list of actions.
+};
+
+template<class state_t, class action_t>
+SuccessorBuffer<state_t, action_t>::SuccessorBuffer()
+        : num_successors(0)
+{
+}
+
+template<class state_t, class action_t>
+void SuccessorBuffer<state_t, action_t>::reserve(std::size_t capacity)
+{
+    if(records.size() < capacity)
+        records.resize(capacity);
+    action_scratch.reserve(capacity);
+}
+
+template<class state_t, class action_t>
+inline void SuccessorBuffer<state_t, action_t>::clear()
+{
+    num_successors = 0;
+}
+
+template<class state_t, class action_t>
+inline Successor<state_t, action_t>& SuccessorBuffer<state_t, action_t>::addSuccessor()
+{
+    if(num_successors == records.size())
+        records.resize(num_successors + 1);
+    return records[num_successors++];
+}
+
+template<class state_t, class action_t>
+inline std::size_t SuccessorBuffer<state_t, action_t>::size() const
+{
+    return num_successors;
+}
+
+template<class state_t, class action_t>
+inline Successor<state_t, action_t>& SuccessorBuffer<state_t, action_t>::operator[](std::size_t i)
+{
+    assert(i < num_successors);
+    return records[i];
+}
+
+template<class state_t, class action_t>
+inline const Successor<state_t, action_t>& SuccessorBuffer<state_t, action_t>::operator[](std::size_t i) const
+{
+    assert(i < num_successors);
+    return records[i];
+}
+
+template<class state_t, class action_t>
+inline std::vector<action_t>& SuccessorBuffer<state_t, action_t>::getActionScratch()
+{
+    return action_scratch;
+}
+
+#endif /* SUCCESSOR_BUFFER_H_ */
@@ -12,9 +12,15 @@
 
 #include <vector>
 
+#include "successor_buffer.h"
+
 /**
  * An abstract class defining the way transition systems are to be applied.
  *
+ * All functions are const, and descendents must keep them safe to call concurrently so that several searches can
+ * share one transition system (and any map or tables it holds). Any scratch memory needed to generate successors should
+ * come from the caller, as with the SuccessorBuffer passed to generateSuccessors.
+ *
  * @todo Add debug mode?
  *
  * @class TransitionSystem
@@ -90,6 +96,18 @@ public:
      */
     virtual void getSuccessors(const state_t &state, std::vector<state_t> &children) const;
 
+    /**
+     * Replaces the contents of the given buffer with the successors of the given state, along with the actions that
+     * generate them and the costs of those actions.
+     *
+     * By default, generates the list of applicable actions and then the cost and child for each. Domains can override
+     * this to write the children directly into the buffer.
+     *
+     * @param state The state to generate successors for.
+     * @param successors The buffer to fill.
+     */
+    virtual void generateSuccessors(const state_t &state, SuccessorBuffer<state_t, action_t> &successors) const;
+
     /**
      * Checks if the given action is invertible in the given state.
      *
@@ -112,6 +130,18 @@ public:
      */
     virtual action_t getInverse(const state_t &state, const action_t &action) const;
 
+    /**
+     * Checks if the second state may be reachable from the first.
+     *
+     * Search engines call this before searching for a single goal, so it must be cheap. Domains that can tell that no
+     * path exists should override it. By default, every state may be reachable.
+     *
+     * @param from The state to start from.
+     * @param to The state to reach.
+     * @return False if there is definitely no path between the states, and true otherwise.
+     */
+    virtual bool isReachable(const state_t &from, const state_t &to) const;
+
     /**
      * Returns the dummy action for this domain.
      *
@@ -181,12 +211,16 @@ bool TransitionSystem<state_t, action_t>::isApplicable(const state_t &state, con
 template<class state_t, class action_t>
 bool TransitionSystem<state_t, action_t>::isChildState(const state_t &parent, const state_t &child) const
 {
-    std::vector<state_t> children;
+    std::vector<action_t> actions;
+
+    getActions(parent, actions);
 
-    getSuccessors(parent, children);
+    state_t child_copy(parent);
+    for(unsigned i = 0; i < actions.size(); i++) {
+        child_copy = parent;
+        applyAction(child_copy, actions[i]);
 
-    for(unsigned i = 0; i < children.size(); i++) {
-        if(child == children[i])
+        if(child == child_copy)
             return true;
     }
 
@@ -208,6 +242,25 @@ void TransitionSystem<state_t, action_t>::getSuccessors(const state_t &state, st
     }
 }
 
+template<class state_t, class action_t>
+void TransitionSystem<state_t, action_t>::generateSuccessors(const state_t &state,
+        SuccessorBuffer<state_t, action_t> &successors) const
+{
+    successors.clear();
+
+    std::vector<action_t> &actions = successors.getActionScratch();
+    actions.clear();
+    getActions(state, actions);
+
+    for(unsigned i = 0; i < actions.size(); i++) {
+        Successor<state_t, action_t> &succ = successors.addSuccessor();
+        succ.action = actions[i];
+        succ.cost = getActionCost(state, actions[i]);
+        succ.state = state;
+        applyAction(succ.state, actions[i]);
+    }
+}
+
 template<class state_t, class action_t>
 bool TransitionSystem<state_t, action_t>::isInvertible(const state_t &state, const action_t &action) const {
     return false;
@@ -218,6 +271,12 @@ action_t TransitionSystem<state_t, action_t>::getInverse(const state_t &state, c
     return getDummyAction();
 }
 
+template<class state_t, class action_t>
+bool TransitionSystem<state_t, action_t>::isReachable(const state_t &from, const state_t &to) const
+{
+    return true;
+}
+
 
 template<class state_t, class action_t>
 bool TransitionSystem<state_t, action_t>::applyActionSequence(state_t &state,
@@ -0,0 +1,26 @@
+/*
+ * cpu_features.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "cpu_features.h"
+
+SimdLevel getSupportedSimdLevel()
+{
+#if SIMD_X86_AVAILABLE
+    static const SimdLevel supported = __builtin_cpu_supports("avx2") ? SimdLevel::avx2 :
+            __builtin_cpu_supports("sse2") ? SimdLevel::sse2 : SimdLevel::scalar;
+    return supported;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+bool isSimdLevelSupported(SimdLevel level)
+{
+    return (int) level <= (int) getSupportedSimdLevel();
+}
@@ -0,0 +1,61 @@
+/*
+ * cpu_features.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+/**
+ * Code for detecting which vector instruction sets the processor supports, so that vectorized code can be picked at
+ * runtime.
+ *
+ * Vectorized functions are compiled for their instruction set with the target attribute, so the rest of the code does
+ * not need to be compiled with any extra flags. They are only available when compiling for x86 with GCC or Clang, as
+ * indicated by SIMD_X86_AVAILABLE.
+ *
+ * @file cpu_features.h
+ */
+#ifndef CPU_FEATURES_H_
+#define CPU_FEATURES_H_
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_X86_AVAILABLE 1
+#else
+#define SIMD_X86_AVAILABLE 0
+#endif
+
+/**
+ * The vector instruction sets that vectorized code can use.
+ *
+ * Below is the meaning of each of the values:
+ *
+ * scalar - no vector instructions.\n
+ * sse2 - 128 bit vectors.\n
+ * avx2 - 256 bit vectors, including gathers.\n
+ *
+ * Each level includes the ones before it.
+ *
+ * @class SimdLevel
+ */
+enum class SimdLevel
+{
+    scalar, sse2, avx2
+};
+
+/**
+ * Returns the best vector instruction set supported by both the processor and this build.
+ *
+ * @return The best supported instruction set.
+ */
+SimdLevel getSupportedSimdLevel();
+
+/**
+ * Returns if the given vector instruction set is supported by both the processor and this build.
+ *
+ * @param level The instruction set to check.
+ * @return If the instruction set is supported.
+ */
+bool isSimdLevelSupported(SimdLevel level);
+
+#endif /* CPU_FEATURES_H_ */
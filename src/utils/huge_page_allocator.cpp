@@ -0,0 +1,41 @@
+/*
+ * huge_page_allocator.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+
+#include "huge_page_allocator.h"
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+void *allocateSearchMemory(std::size_t num_bytes, bool use_huge_pages)
+{
+    void *memory = 0;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if(use_huge_pages && num_bytes >= HUGE_PAGE_SIZE) {
+        std::size_t rounded_bytes = (num_bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+        if(posix_memalign(&memory, HUGE_PAGE_SIZE, rounded_bytes) != 0)
+            throw std::bad_alloc();
+        madvise(memory, rounded_bytes, MADV_HUGEPAGE);
+        return memory;
+    }
+#endif
+
+    memory = malloc(num_bytes == 0 ? 1 : num_bytes);
+    if(!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void freeSearchMemory(void *memory)
+{
+    free(memory);
+}
@@ -0,0 +1,126 @@
+/*
+ * huge_page_allocator.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-16
+ *      Author: Rick Valenzano
+ */
+/**
+ * An allocator for large search arrays that can ask the operating system to back them with huge pages.
+ *
+ * @file huge_page_allocator.h
+ */
+#ifndef HUGE_PAGE_ALLOCATOR_H_
+#define HUGE_PAGE_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * The size of a huge page. Only allocations of at least this size are backed by huge pages.
+ */
+static const std::size_t HUGE_PAGE_SIZE = (std::size_t) 1 << 21;
+
+/**
+ * Allocates the given number of bytes.
+ *
+ * If huge pages are requested and the allocation is at least HUGE_PAGE_SIZE bytes, the memory is aligned to a huge
+ * page boundary and the operating system is advised to back it with (transparent) huge pages. This is only a hint,
+ * so the memory is still usable if huge pages are not available. On systems without madvise, huge pages are never
+ * used.
+ *
+ * @param num_bytes The number of bytes to allocate.
+ * @param use_huge_pages If huge pages should be requested.
+ * @return A pointer to the allocated memory.
+ */
+void *allocateSearchMemory(std::size_t num_bytes, bool use_huge_pages);
+
+/**
+ * Frees memory allocated by allocateSearchMemory.
+ *
+ * @param memory The memory to free.
+ */
+void freeSearchMemory(void *memory);
+
+/**
+ * A standard library allocator whose allocations can optionally be backed by huge pages.
+ *
+ * Large arrays that are accessed at random, like node attribute arrays and hash tables, cause a TLB miss on almost
+ * every access when backed by normal pages. Backing them with huge pages greatly reduces the number of misses.
+ *
+ * Whether huge pages are used is a property of the allocator object, so it is fixed for a given container. To change
+ * it, the container has to be recreated with a new allocator.
+ *
+ * @class HugePageAllocator
+ */
+template<class T>
+class HugePageAllocator
+{
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    /**
+     * Constructor for the allocator.
+     *
+     * @param huge_pages If huge pages should be requested for large allocations.
+     */
+    HugePageAllocator(bool huge_pages = false)
+            : use_huge_pages(huge_pages)
+    {
+    }
+
+    template<class U>
+    HugePageAllocator(const HugePageAllocator<U> &other)
+            : use_huge_pages(other.use_huge_pages)
+    {
+    }
+
+    /**
+     * Allocates memory for the given number of objects.
+     *
+     * @param n The number of objects.
+     * @return A pointer to the allocated memory.
+     */
+    T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(allocateSearchMemory(n * sizeof(T), use_huge_pages));
+    }
+
+    /**
+     * Frees memory allocated by this allocator.
+     *
+     * @param p The memory to free.
+     * @param n The number of objects the memory was allocated for.
+     */
+    void deallocate(T *p, std::size_t n)
+    {
+        freeSearchMemory(p);
+    }
+
+    template<class U>
+    struct rebind
+    {
+        typedef HugePageAllocator<U> other;
+    };
+
+    bool use_huge_pages; ///< If huge pages are requested for large allocations.
+};
+
+template<class T, class U>
+inline bool operator==(const HugePageAllocator<T> &a, const HugePageAllocator<U> &b)
+{
+    return a.use_huge_pages == b.use_huge_pages;
+}
+
+template<class T, class U>
+inline bool operator!=(const HugePageAllocator<T> &a, const HugePageAllocator<U> &b)
+{
+    return !(a == b);
+}
+
+#endif /* HUGE_PAGE_ALLOCATOR_H_ */
@@ -0,0 +1,100 @@
+/*
+ * mapped_file.cpp
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#include "mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+        : data(0), size(0), is_open(false), is_mapped(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& file_name)
+{
+    close();
+
+#ifdef __linux__
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat file_stats;
+    if(fstat(fd, &file_stats) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // empty files can't be mapped, so they are read instead
+    if(file_stats.st_size > 0) {
+        void *mapping = mmap(0, file_stats.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if(mapping == MAP_FAILED)
+            return false;
+
+        data = static_cast<const char *>(mapping);
+        size = file_stats.st_size;
+        is_open = true;
+        is_mapped = true;
+        return true;
+    }
+    ::close(fd);
+#endif
+
+    std::ifstream in_stream(file_name, std::ios::in | std::ios::binary);
+    if(in_stream.fail())
+        return false;
+
+    file_contents.assign(std::istreambuf_iterator<char>(in_stream), std::istreambuf_iterator<char>());
+    data = file_contents.data();
+    size = file_contents.size();
+    is_open = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef __linux__
+    if(is_mapped)
+        munmap(const_cast<char *>(data), size);
+#endif
+    data = 0;
+    size = 0;
+    is_open = false;
+    is_mapped = false;
+    file_contents.clear();
+}
+
+bool MappedFile::isOpen() const
+{
+    return is_open;
+}
+
+const char* MappedFile::getData() const
+{
+    return data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return size;
+}
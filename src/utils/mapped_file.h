@@ -0,0 +1,85 @@
+/*
+ * mapped_file.h
+ *
+ * LICENSE HERE
+ *
+ *  Created on: 2026-10-17
+ *      Author: Rick Valenzano
+ */
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * A read-only view of the contents of a file, used to load precomputed tables.
+ *
+ * On Linux, the file is memory-mapped, so loading is immediate and the pages are shared between processes using the
+ * same file. Elsewhere, the file is read into memory.
+ *
+ * The file is not copyable since it may own a memory mapping.
+ *
+ * @class MappedFile
+ */
+class MappedFile
+{
+public:
+    /**
+     * Constructs a view of no file.
+     */
+    MappedFile();
+
+    /**
+     * Releases the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * Opens the file with the given name, releasing any file currently open.
+     *
+     * @param file_name The name of the file.
+     * @return If the file was opened.
+     */
+    bool open(const std::string &file_name);
+
+    /**
+     * Releases the file currently open, if any.
+     */
+    void close();
+
+    /**
+     * Checks if a file is open.
+     *
+     * @return If a file is open.
+     */
+    bool isOpen() const;
+
+    /**
+     * Returns the contents of the file.
+     *
+     * @return A pointer to the contents, or 0 if no file is open.
+     */
+    const char *getData() const;
+
+    /**
+     * Returns the size of the file.
+     *
+     * @return The size of the file in bytes.
+     */
+    std::size_t getSize() const;
+
+private:
+    const char *data; ///< The contents of the file.
+    std::size_t size; ///< The size of the file.
+    bool is_open; ///< If a file is open.
+    bool is_mapped; ///< If the contents are a memory mapping rather than in file_contents.
+    std::vector<char> file_contents; ///< The contents of the file, if it was read rather than mapped.
+};
+
+#endif /* MAPPED_FILE_H_ */